@@ -10,6 +10,7 @@
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/httpapi.h"
 #include "azure_c_shared_utility/httpheaders.h"
+#include "azure_c_shared_utility/arena.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "curl/curl.h"
 #include <openssl/x509_vfy.h>
@@ -21,6 +22,7 @@
 #include "azure_c_shared_utility/shared_util_options.h"
 
 #define TEMP_BUFFER_SIZE 1024
+#define SCRATCH_BLOCK_SIZE 1024 /*the URL and the request headers of a typical request fit in one block*/
 
 DEFINE_ENUM_STRINGS(HTTPAPI_RESULT, HTTPAPI_RESULT_VALUES);
 
@@ -36,6 +38,7 @@ typedef struct HTTP_HANDLE_DATA_TAG
     long verbose;
     const char* x509privatekey;
     const char* x509certificate;
+    ARENA_HANDLE scratch; /*per request allocations, reset at the end of every HTTPAPI_ExecuteRequest*/
 } HTTP_HANDLE_DATA;
 
 typedef struct HTTP_RESPONSE_CONTENT_BUFFER_TAG
@@ -118,6 +121,14 @@ HTTP_HANDLE HTTPAPI_CreateConnection(const char* hostName)
                         free(httpHandleData);
                         httpHandleData = NULL;
                     }
+                    else if ((httpHandleData->scratch = ARENA_create(SCRATCH_BLOCK_SIZE)) == NULL)
+                    {
+                        LogError("unable to ARENA_create");
+                        curl_easy_cleanup(httpHandleData->curl);
+                        free(httpHandleData->hostURL);
+                        free(httpHandleData);
+                        httpHandleData = NULL;
+                    }
                     else
                     {
                         httpHandleData->timeout = 242 * 1000; /*242 seconds seems like a nice enough time. Reasone for 242:
@@ -152,6 +163,7 @@ void HTTPAPI_CloseConnection(HTTP_HANDLE handle)
     {
         free(httpHandleData->hostURL);
         curl_easy_cleanup(httpHandleData->curl);
+        ARENA_destroy(httpHandleData->scratch);
         free(httpHandleData);
     }
 }
@@ -270,7 +282,7 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
     {
         char* tempHostURL;
         size_t tempHostURL_size = strlen(httpHandleData->hostURL) + strlen(relativePath) + 1;
-        tempHostURL = malloc(tempHostURL_size);
+        tempHostURL = ARENA_alloc(httpHandleData->scratch, tempHostURL_size);
         if (tempHostURL == NULL)
         {
             result = HTTPAPI_ERROR;
@@ -429,7 +441,7 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
                     for (i = 0; i < headersCount; i++)
                     {
                         char *tempBuffer;
-                        if (HTTPHeaders_GetHeader(httpHeadersHandle, i, &tempBuffer) != HTTP_HEADERS_OK)
+                        if (HTTPHeaders_GetHeaderInArena(httpHeadersHandle, i, httpHandleData->scratch, &tempBuffer) != HTTP_HEADERS_OK)
                         {
                             /* error */
                             result = HTTPAPI_HTTP_HEADERS_FAILED;
@@ -443,12 +455,10 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
                             {
                                 result = HTTPAPI_ALLOC_FAILED;
                                 LogError("(result = %s)", ENUM_TO_STRING(HTTPAPI_RESULT, result));
-                                free(tempBuffer);
                                 break;
                             }
                             else
                             {
-                                free(tempBuffer);
                                 headers = newHeaders;
                             }
                         }
@@ -597,8 +607,10 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
                     curl_slist_free_all(headers);
                 }
             }
-            free(tempHostURL);
         }
+
+        /*the URL and the header strings go away in one step*/
+        ARENA_reset(httpHandleData->scratch);
     }
 
     return result;
@@ -28,6 +28,8 @@
 
 // connect timeout in seconds
 #define CONNECT_TIMEOUT         10
+/* list nodes of sent pending IOs are reused by the next sends instead of being freed */
+#define PENDING_IO_POOL_SIZE    8
 
 typedef enum IO_STATE_TAG
 {
@@ -169,10 +171,10 @@ CONCRETE_IO_HANDLE socketio_create(void* io_create_parameters)
         result = malloc(sizeof(SOCKET_IO_INSTANCE));
         if (result != NULL)
         {
-            result->pending_io_list = singlylinkedlist_create();
+            result->pending_io_list = singlylinkedlist_create_pooled(PENDING_IO_POOL_SIZE);
             if (result->pending_io_list == NULL)
             {
-                LogError("Failure: singlylinkedlist_create unable to create pending list.");
+                LogError("Failure: singlylinkedlist_create_pooled unable to create pending list.");
                 free(result);
                 result = NULL;
             }
@@ -243,7 +245,7 @@ void socketio_destroy(CONCRETE_IO_HANDLE socket_io)
                 free(pending_socket_io);
             }
 
-            (void)singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io);
+            (void)singlylinkedlist_remove_head(socket_io_instance->pending_io_list);
             first_pending_io = singlylinkedlist_get_head_item(socket_io_instance->pending_io_list);
         }
 
@@ -565,7 +567,7 @@ void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
                         {
                             free(pending_socket_io->bytes);
                             free(pending_socket_io);
-                            (void)singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io);
+                            (void)singlylinkedlist_remove_head(socket_io_instance->pending_io_list);
 
                             LogError("Failure: sending Socket information. errno=%d (%s).", errno, strerror(errno));
                             socket_io_instance->io_state = IO_STATE_ERROR;
@@ -589,7 +591,7 @@ void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
 
                     free(pending_socket_io->bytes);
                     free(pending_socket_io);
-                    if (singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io) != 0)
+                    if (singlylinkedlist_remove_head(socket_io_instance->pending_io_list) != 0)
                     {
                         socket_io_instance->io_state = IO_STATE_ERROR;
                         indicate_error(socket_io_instance);
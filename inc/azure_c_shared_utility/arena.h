@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+/* an arena hands out memory by bumping a pointer in blocks of blockSize bytes. Individual allocations are never freed, */
+/* ARENA_reset releases all of them at once (keeping the blocks for the next round) and ARENA_destroy gives the blocks back */
+typedef struct ARENA_TAG* ARENA_HANDLE;
+
+MOCKABLE_FUNCTION(, ARENA_HANDLE, ARENA_create, size_t, blockSize);
+MOCKABLE_FUNCTION(, void, ARENA_destroy, ARENA_HANDLE, handle);
+
+MOCKABLE_FUNCTION(, void*, ARENA_alloc, ARENA_HANDLE, handle, size_t, size);
+MOCKABLE_FUNCTION(, char*, ARENA_strdup, ARENA_HANDLE, handle, const char*, source);
+MOCKABLE_FUNCTION(, void, ARENA_reset, ARENA_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
@@ -30,6 +30,17 @@ MOCKABLE_FUNCTION(, int, BUFFER_prepend, BUFFER_HANDLE, handle1, BUFFER_HANDLE,
 MOCKABLE_FUNCTION(, unsigned char*, BUFFER_u_char, BUFFER_HANDLE, handle);
 MOCKABLE_FUNCTION(, size_t, BUFFER_length, BUFFER_HANDLE, handle);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_clone, BUFFER_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, BUFFER_reserve, BUFFER_HANDLE, handle, size_t, capacity);
+MOCKABLE_FUNCTION(, int, BUFFER_shrink_to_fit, BUFFER_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, BUFFER_capacity, BUFFER_HANDLE, handle);
+MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_create_with_headroom, const unsigned char*, source, size_t, size, size_t, headroom);
+MOCKABLE_FUNCTION(, int, BUFFER_push_front, BUFFER_HANDLE, handle, const unsigned char*, source, size_t, size);
+MOCKABLE_FUNCTION(, size_t, BUFFER_headroom, BUFFER_HANDLE, handle);
+
+/* ownership transfer: the BUFFER takes a malloc'd block without copying it / gives its block away, leaving the BUFFER empty */
+/* when gballoc is built with GB_SHARDED_ACCOUNTING, the blocks moved in and out are gballoc_malloc/gballoc_free blocks */
+MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_create_with_moved_memory, unsigned char*, memory, size_t, size);
+MOCKABLE_FUNCTION(, unsigned char*, BUFFER_detach, BUFFER_HANDLE, handle, size_t*, size);
 
 #ifdef __cplusplus
 }
@@ -32,6 +32,15 @@ MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_Create, const unsigned char*
 /*this creates a new constbuffer from an existing BUFFER_HANDLE*/
 MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_CreateFromBuffer, BUFFER_HANDLE, buffer);
 
+/*this creates a new constbuffer that takes the ownership of a malloc'd memory area, without copying it (a gballoc_malloc'd one when gballoc is built with GB_SHARDED_ACCOUNTING)*/
+MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_CreateWithMoveMemory, unsigned char*, source, size_t, size);
+
+/*this creates a new constbuffer that takes the memory of an existing BUFFER_HANDLE, without copying it. The BUFFER_HANDLE is left empty*/
+MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_CreateFromBufferWithMove, BUFFER_HANDLE, buffer);
+
+/*this creates a new constbuffer that shares (and holds a reference on) the memory of length bytes of handle starting at offset*/
+MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_CreateSlice, CONSTBUFFER_HANDLE, handle, size_t, offset, size_t, length);
+
 MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_Clone, CONSTBUFFER_HANDLE, constbufferHandle);
 
 MOCKABLE_FUNCTION(, const CONSTBUFFER*, CONSTBUFFER_GetContent, CONSTBUFFER_HANDLE, constbufferHandle);
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CONSTBUFFER_ARRAY_H
+#define CONSTBUFFER_ARRAY_H
+
+#include "azure_c_shared_utility/constbuffer.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+/*a refcounted sequence of CONSTBUFFER_HANDLEs that together make one logical message (for example header + properties + body)*/
+typedef struct CONSTBUFFER_ARRAY_HANDLE_DATA_TAG* CONSTBUFFER_ARRAY_HANDLE;
+
+MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, CONSTBUFFER_ARRAY_Create);
+MOCKABLE_FUNCTION(, CONSTBUFFER_ARRAY_HANDLE, CONSTBUFFER_ARRAY_Clone, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle);
+MOCKABLE_FUNCTION(, void, CONSTBUFFER_ARRAY_Destroy, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle);
+
+/*adding takes a new reference on constbufferHandle, removing gives the array's reference to the caller (who has to CONSTBUFFER_Destroy it)*/
+MOCKABLE_FUNCTION(, int, CONSTBUFFER_ARRAY_AddFront, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle, CONSTBUFFER_HANDLE, constbufferHandle);
+MOCKABLE_FUNCTION(, int, CONSTBUFFER_ARRAY_AddBack, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle, CONSTBUFFER_HANDLE, constbufferHandle);
+MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_ARRAY_RemoveFront, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle);
+MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_ARRAY_RemoveBack, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle);
+
+MOCKABLE_FUNCTION(, size_t, CONSTBUFFER_ARRAY_GetCount, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle);
+MOCKABLE_FUNCTION(, size_t, CONSTBUFFER_ARRAY_GetTotalLength, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle);
+
+/*iteration: the buffers are at indexes 0 .. CONSTBUFFER_ARRAY_GetCount() - 1, the returned handle is owned by the array*/
+MOCKABLE_FUNCTION(, CONSTBUFFER_HANDLE, CONSTBUFFER_ARRAY_GetBuffer, CONSTBUFFER_ARRAY_HANDLE, constbufferArrayHandle, size_t, index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* CONSTBUFFER_ARRAY_H */
@@ -18,6 +18,17 @@ extern "C"
 
 #include "azure_c_shared_utility/umock_c_prod.h"
 
+/* aggregate of the allocations made from one file/line, as reported by gballoc_getAllocationSites */
+typedef struct GBALLOC_ALLOCATION_SITE_TAG
+{
+    const char* file;
+    int line;
+    size_t liveBytes;
+    size_t liveCount;
+    size_t allocationCount;
+    size_t allocatedBytes;
+} GBALLOC_ALLOCATION_SITE;
+
 /* all translation units that need memory measurement need to have GB_MEASURE_MEMORY_FOR_THIS defined */
 /* GB_DEBUG_ALLOC is the switch that turns the measurement on/off, so that it is not on always */
 #if defined(GB_DEBUG_ALLOC)
@@ -32,6 +43,17 @@ MOCKABLE_FUNCTION(, void, gballoc_free, void*, ptr);
 MOCKABLE_FUNCTION(, size_t, gballoc_getMaximumMemoryUsed);
 MOCKABLE_FUNCTION(, size_t, gballoc_getCurrentMemoryUsed);
 
+/* pool statistics, only available when gballoc.c is built with GB_POOLED_ALLOCATIONS (the hit rate is gballoc_getPoolHitCount() / gballoc_getPoolRequestCount()) */
+MOCKABLE_FUNCTION(, size_t, gballoc_getPoolRequestCount);
+MOCKABLE_FUNCTION(, size_t, gballoc_getPoolHitCount);
+
+/* allocation site profiling, the gballoc_xxx_at functions are what malloc/calloc/realloc are redirected to when GB_TRACK_ALLOCATION_SITES is defined */
+MOCKABLE_FUNCTION(, void*, gballoc_malloc_at, size_t, size, const char*, file, int, line);
+MOCKABLE_FUNCTION(, void*, gballoc_calloc_at, size_t, nmemb, size_t, size, const char*, file, int, line);
+MOCKABLE_FUNCTION(, void*, gballoc_realloc_at, void*, ptr, size_t, size, const char*, file, int, line);
+MOCKABLE_FUNCTION(, size_t, gballoc_getAllocationSites, GBALLOC_ALLOCATION_SITE*, sites, size_t, maxSites);
+MOCKABLE_FUNCTION(, void, gballoc_dumpAllocationSites, size_t, topCount);
+
 /* if GB_MEASURE_MEMORY_FOR_THIS is defined then we want to redirect memory allocation functions to gballoc_xxx functions */
 #ifdef GB_MEASURE_MEMORY_FOR_THIS
 #if defined(_CRTDBG_MAP_ALLOC) && defined(_DEBUG)
@@ -43,6 +65,11 @@ MOCKABLE_FUNCTION(, size_t, gballoc_getCurrentMemoryUsed);
 #define _calloc_dbg(nmemb, size, ...) gballoc_calloc(nmemb, size)
 #define _realloc_dbg(ptr, size, ...) gballoc_realloc(ptr, size)
 #define _free_dbg(ptr, ...) gballoc_free(ptr)
+#elif defined(GB_TRACK_ALLOCATION_SITES)
+#define malloc(size) gballoc_malloc_at(size, __FILE__, __LINE__)
+#define calloc(nmemb, size) gballoc_calloc_at(nmemb, size, __FILE__, __LINE__)
+#define realloc(ptr, size) gballoc_realloc_at(ptr, size, __FILE__, __LINE__)
+#define free gballoc_free
 #else
 #define malloc gballoc_malloc
 #define calloc gballoc_calloc
@@ -58,6 +85,10 @@ MOCKABLE_FUNCTION(, size_t, gballoc_getCurrentMemoryUsed);
 
 #define gballoc_getMaximumMemoryUsed() SIZE_MAX
 #define gballoc_getCurrentMemoryUsed() SIZE_MAX
+#define gballoc_getPoolRequestCount() SIZE_MAX
+#define gballoc_getPoolHitCount() SIZE_MAX
+#define gballoc_getAllocationSites(sites, maxSites) ((size_t)0)
+#define gballoc_dumpAllocationSites(topCount) ((void)0)
 
 #endif /* GB_DEBUG_ALLOC */
 
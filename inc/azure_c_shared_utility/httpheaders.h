@@ -22,6 +22,8 @@
 
 #include "azure_c_shared_utility/macro_utils.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
+#include "azure_c_shared_utility/arena.h"
+#include "azure_c_shared_utility/string_view.h"
 
 #ifdef __cplusplus
 #include <cstddef>
@@ -109,6 +111,19 @@ MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_ReplaceHeaderNameValuePair,
  */
 MOCKABLE_FUNCTION(, const char*, HTTPHeaders_FindHeaderValue, HTTP_HEADERS_HANDLE, httpHeadersHandle, const char*, name);
 
+/**
+ * @brief	Retrieves the value for a previously stored name, the name being given
+ * 			as a view (for example over a part of a received buffer) so that it
+ * 			does not have to be copied to a '\0' terminated string first.
+ *
+ * @param	httpHeadersHandle	A valid @c HTTP_HEADERS_HANDLE value.
+ * @param	name			 	A view over the name of the HTTP header to find.
+ *
+ * @return	The return value points to a string that shall be @c strcmp equal
+ * 			to the original stored string.
+ */
+MOCKABLE_FUNCTION(, const char*, HTTPHeaders_FindHeaderValueView, HTTP_HEADERS_HANDLE, httpHeadersHandle, STRING_VIEW, name);
+
 /**
  * @brief	This API retrieves the number of stored headers.
  *
@@ -138,6 +153,26 @@ MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeaderCount, HTTP_HEADER
  */
 MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeader, HTTP_HEADERS_HANDLE, handle, size_t, index, char**, destination);
 
+/**
+ * @brief	This API retrieves the string name+": "+value for the header
+ * 			element at the given @p index, like ::HTTPHeaders_GetHeader,
+ * 			but the string is allocated from @p arena.
+ *
+ * @param	handle			A valid @c HTTP_HEADERS_HANDLE value.
+ * @param	index			Zero-based index of the item in the
+ * 							headers collection.
+ * @param	arena			The arena the string is allocated from. The
+ * 							string stays valid until the arena is reset or
+ * 							destroyed and must not be freed by the caller.
+ * @param   destination		Receives a pointer to the string.
+ *
+ * @return	Returns @c HTTP_HEADERS_OK when execution is successful,
+ * 			@c HTTP_HEADERS_INVALID_ARG when @p handle, @p arena or
+ * 			@p destination is @c NULL or @p index is out of range, or
+ * 			@c HTTP_HEADERS_ERROR when an error occurs.
+ */
+MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeaderInArena, HTTP_HEADERS_HANDLE, handle, size_t, index, ARENA_HANDLE, arena, char**, destination);
+
 /**
  * @brief	This API produces a clone of the @p handle parameter.
  *
@@ -11,6 +11,7 @@
 
 #include "azure_c_shared_utility/macro_utils.h"
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/string_view.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
 
@@ -55,6 +56,17 @@ typedef int (*MAP_FILTER_CALLBACK)(const char* mapProperty, const char* mapValue
  */
 MOCKABLE_FUNCTION(, MAP_HANDLE, Map_Create, MAP_FILTER_CALLBACK, mapFilterFunc);
 
+/**
+ * @brief   Creates a new, empty map whose keys are interned (see string_intern.h)
+ *          instead of copied, so that maps that keep the same few keys (header
+ *          names) share one copy of them.
+ *
+ * @param   mapFilterFunc   Same as for ::Map_Create.
+ *
+ * @return  A valid @c MAP_HANDLE or @c NULL in case an error occurs.
+ */
+MOCKABLE_FUNCTION(, MAP_HANDLE, Map_CreateWithInternedKeys, MAP_FILTER_CALLBACK, mapFilterFunc);
+
 /**
  * @brief   Release all resources associated with the map.
  *
@@ -70,6 +82,10 @@ MOCKABLE_FUNCTION(, void, Map_Destroy, MAP_HANDLE, handle);
  *
  * @return  A valid @c MAP_HANDLE to the cloned copy of the map or @c NULL
  *          in case an error occurs.
+ *
+ * @note    The clone shares the keys and values of @p handle until one of
+ *          them is changed. Several threads can clone the same map at the
+ *          same time, as long as none of them changes it meanwhile.
  */
 MOCKABLE_FUNCTION(, MAP_HANDLE, Map_Clone, MAP_HANDLE, handle);
 
@@ -122,6 +138,46 @@ MOCKABLE_FUNCTION(, MAP_RESULT, Map_Add, MAP_HANDLE, handle, const char*, key, c
  */
 MOCKABLE_FUNCTION(, MAP_RESULT, Map_AddOrUpdate, MAP_HANDLE, handle, const char*, key, const char*, value);
 
+/**
+ * @brief   Makes room in the map for at least @p capacity key/value pairs.
+ *
+ * @param   handle      The handle to an existing map.
+ * @param   capacity    The number of pairs the map shall be able to hold
+ *                      without growing its storage again.
+ *
+ *          The map never shrinks because of this call. It only changes how
+ *          much memory the map holds, not its content.
+ *
+ * @return  If @p handle is @c NULL then this function returns
+ *          @c MAP_INVALIDARG. If the storage cannot be grown the function
+ *          returns @c MAP_ERROR. Otherwise @c MAP_OK is returned.
+ */
+MOCKABLE_FUNCTION(, MAP_RESULT, Map_Reserve, MAP_HANDLE, handle, size_t, capacity);
+
+/**
+ * @brief   Adds @p count key/value pairs to the map.
+ *
+ * @param   handle  The handle to an existing map.
+ * @param   keys    An array of @p count keys.
+ * @param   values  An array of @p count values, @c values[i] is associated
+ *                  with @c keys[i].
+ * @param   count   The number of pairs to add.
+ *
+ *          This function behaves like calling ::Map_Add for every pair, except
+ *          that the storage of the map is grown only once and that either all
+ *          the pairs are added or none is.
+ *
+ * @return  If @p handle is @c NULL, or if @p keys, @p values or any of their
+ *          elements is @c NULL then this function returns @c MAP_INVALIDARG.
+ *          If any of the keys already exists in the map, or appears twice in
+ *          @p keys then @c MAP_KEYEXISTS is returned. If the filter function
+ *          associated with the map rejects any of the pairs then
+ *          @c MAP_FILTER_REJECT is returned. In case an error occurs when the
+ *          pairs are added the function returns @c MAP_ERROR. If everything
+ *          goes well then @c MAP_OK is returned.
+ */
+MOCKABLE_FUNCTION(, MAP_RESULT, Map_AddMany, MAP_HANDLE, handle, const char*const*, keys, const char*const*, values, size_t, count);
+
 /**
  * @brief   Removes a key and its associated value from the map.
  *
@@ -176,6 +232,20 @@ MOCKABLE_FUNCTION(, MAP_RESULT, Map_ContainsValue, MAP_HANDLE, handle, const cha
  */
 MOCKABLE_FUNCTION(, const char*, Map_GetValueFromKey, MAP_HANDLE, handle, const char*, key);
 
+/**
+ * @brief   Retrieves the value of a stored key given as a view, so that keys
+ *          that are not '\0' terminated (for example a slice of a received
+ *          buffer) can be looked up without making a copy of them.
+ *
+ * @param   handle  The handle to an existing map.
+ * @param   key     A view over the characters of the key.
+ *
+ * @return  Returns @c NULL in case @p handle or the data of @p key is @c NULL
+ *          or if the requested key is not found in the map. Returns a pointer
+ *          to the key's value otherwise.
+ */
+MOCKABLE_FUNCTION(, const char*, Map_GetValueFromKeyView, MAP_HANDLE, handle, STRING_VIEW, key);
+
 /**
  * @brief   Retrieves the complete list of keys and values from the map
  *          in @p values and @p keys. Also writes the size of the list
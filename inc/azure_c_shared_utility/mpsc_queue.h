@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+/* an intrusive first in first out queue that any number of threads can push to without a lock, */
+/* while one thread (the one calling xio_dowork, for example) pops. Like DLIST_ENTRY, the entries do not store data, */
+/* they are embedded in the items and containingRecord gives back the item. Neither the queue nor the entries are allocated */
+/* by this module and no input error checking is provided. */
+typedef struct MPSC_QUEUE_ENTRY_TAG
+{
+    struct MPSC_QUEUE_ENTRY_TAG* volatile next;
+} MPSC_QUEUE_ENTRY;
+
+typedef struct MPSC_QUEUE_TAG
+{
+    /* the last pushed entry, swapped by the producers */
+    MPSC_QUEUE_ENTRY* volatile head;
+    /* the next entry to pop, only touched by the consumer */
+    MPSC_QUEUE_ENTRY* tail;
+    /* keeps the queue from ever being empty, so that push does not need to know about the consumer */
+    MPSC_QUEUE_ENTRY stub;
+} MPSC_QUEUE;
+
+MOCKABLE_FUNCTION(, void, mpsc_queue_init, MPSC_QUEUE*, queue);
+MOCKABLE_FUNCTION(, void, mpsc_queue_push, MPSC_QUEUE*, queue, MPSC_QUEUE_ENTRY*, entry);
+MOCKABLE_FUNCTION(, MPSC_QUEUE_ENTRY*, mpsc_queue_pop, MPSC_QUEUE*, queue);
+MOCKABLE_FUNCTION(, int, mpsc_queue_is_empty, MPSC_QUEUE*, queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPSC_QUEUE_H */
@@ -97,33 +97,42 @@ The macro DEC_RETURN_ZERO will be "0" on windows, and "1" on the other cases.
 */
 
 /*if macro DEC_REF returns DEC_RETURN_ZERO that means the ref count has reached zero.*/
+/*INC_REF_VAR/DEC_REF_VAR do the same for a COUNT_TYPE that is not wrapped by DEFINE_REFCOUNT_TYPE, for example one in a struct that has a flexible array*/
+/*GET_REF reads the ref count atomically, a value of 1 tells the holder of a reference that nobody else holds one*/
 #if defined(REFCOUNT_USE_STD_ATOMIC)
 #include <stdatomic.h>
 #define DEC_RETURN_ZERO (1)
-#define INC_REF(type, var) atomic_fetch_add((&((REFCOUNT_TYPE(type)*)var)->count), 1)
-#define DEC_REF(type, var) atomic_fetch_sub((&((REFCOUNT_TYPE(type)*)var)->count), 1)
+#define INC_REF_VAR(count) atomic_fetch_add(&(count), 1)
+#define DEC_REF_VAR(count) atomic_fetch_sub(&(count), 1)
+#define GET_REF_VAR(count) atomic_load(&(count))
 
 #elif defined(WIN32)
 #include "windows.h"
 #define DEC_RETURN_ZERO (0)
-#define INC_REF(type, var) InterlockedIncrement(&(((REFCOUNT_TYPE(type)*)var)->count))
-#define DEC_REF(type, var) InterlockedDecrement(&(((REFCOUNT_TYPE(type)*)var)->count))
+#define INC_REF_VAR(count) InterlockedIncrement(&(count))
+#define DEC_REF_VAR(count) InterlockedDecrement(&(count))
+#define GET_REF_VAR(count) InterlockedCompareExchange(&(count), 0, 0)
 
 #elif defined(__GNUC__)
 #define DEC_RETURN_ZERO (0)
-#define INC_REF(type, var) __sync_add_and_fetch((&((REFCOUNT_TYPE(type)*)var)->count), 1)
-#define DEC_REF(type, var) __sync_sub_and_fetch((&((REFCOUNT_TYPE(type)*)var)->count), 1)
+#define INC_REF_VAR(count) __sync_add_and_fetch(&(count), 1)
+#define DEC_REF_VAR(count) __sync_sub_and_fetch(&(count), 1)
+#define GET_REF_VAR(count) __sync_add_and_fetch(&(count), 0)
 
 #else
 #if defined(REFCOUNT_ATOMIC_DONTCARE)
 #define DEC_RETURN_ZERO (0)
-#define INC_REF(type, var) ++((((REFCOUNT_TYPE(type)*)var)->count))
-#define DEC_REF(type, var) --((((REFCOUNT_TYPE(type)*)var)->count))
+#define INC_REF_VAR(count) ++(count)
+#define DEC_REF_VAR(count) --(count)
+#define GET_REF_VAR(count) (count)
 #else
 #error do not know how to atomically increment and decrement a uint32_t :(. Platform support needs to be extended to your platform.
 #endif /*defined(REFCOUNT_ATOMIC_DONTCARE)*/
 #endif
 
+#define INC_REF(type, var) INC_REF_VAR(((REFCOUNT_TYPE(type)*)var)->count)
+#define DEC_REF(type, var) DEC_REF_VAR(((REFCOUNT_TYPE(type)*)var)->count)
+#define GET_REF(type, var) GET_REF_VAR(((REFCOUNT_TYPE(type)*)var)->count)
 
 
 #ifdef __cplusplus
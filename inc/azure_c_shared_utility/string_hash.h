@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*this header contains the FNV-1a hash of a string that the modules keeping their own hash tables of strings
+(map's key index, string_intern's table) share, so that they all hash the same way.
+The functions are inline, they are a few instructions per character and are called for every lookup.
+string_hash and string_hash_n give the same hash for the same characters, whether or not they are '\0' terminated.*/
+
+#ifndef STRING_HASH_H
+#define STRING_HASH_H
+
+#ifdef __cplusplus
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__cplusplus)
+#define STRING_HASH_INLINE static __inline
+#else
+#define STRING_HASH_INLINE static inline
+#endif
+
+#define STRING_HASH_OFFSET_BASIS ((size_t)2166136261u)
+#define STRING_HASH_PRIME ((size_t)16777619u)
+
+/*hashes a '\0' terminated string, when length is not NULL it also gives back the length so that the characters are only walked once*/
+STRING_HASH_INLINE size_t string_hash(const char* source, size_t* length)
+{
+    size_t hash = STRING_HASH_OFFSET_BASIS;
+    size_t i;
+    for (i = 0; source[i] != '\0'; i++)
+    {
+        hash = (hash ^ (unsigned char)source[i]) * STRING_HASH_PRIME;
+    }
+    if (length != NULL)
+    {
+        *length = i;
+    }
+    return hash;
+}
+
+/*hashes the first length characters of source, which does not need to be '\0' terminated*/
+STRING_HASH_INLINE size_t string_hash_n(const char* source, size_t length)
+{
+    size_t hash = STRING_HASH_OFFSET_BASIS;
+    size_t i;
+    for (i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned char)source[i]) * STRING_HASH_PRIME;
+    }
+    return hash;
+}
+
+#endif /* STRING_HASH_H */
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef STRING_INTERN_H
+#define STRING_INTERN_H
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+/* a process wide table of reference counted strings: acquiring the same characters twice gives back the same pointer, */
+/* so the few names that everybody keeps copies of (option names) exist only once and can be compared by address. */
+/* The table is created by the first string_intern_acquire, string_intern_init only does that up front. */
+/* After string_intern_deinit the strings that are still acquired stay valid, but are not the same pointers as the ones acquired later */
+MOCKABLE_FUNCTION(, int, string_intern_init);
+MOCKABLE_FUNCTION(, void, string_intern_deinit);
+
+MOCKABLE_FUNCTION(, const char*, string_intern_acquire, const char*, source);
+MOCKABLE_FUNCTION(, void, string_intern_release, const char*, interned);
+
+/* how many different strings are in the table */
+MOCKABLE_FUNCTION(, size_t, string_intern_get_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRING_INTERN_H */
@@ -5,6 +5,7 @@
 #define STRING_TOKENIZER_H
 
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/string_view.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
 
 #ifdef __cplusplus
@@ -17,7 +18,10 @@ typedef struct STRING_TOKEN_TAG* STRING_TOKENIZER_HANDLE;
 
 MOCKABLE_FUNCTION(, STRING_TOKENIZER_HANDLE, STRING_TOKENIZER_create, STRING_HANDLE, handle);
 MOCKABLE_FUNCTION(, STRING_TOKENIZER_HANDLE, STRING_TOKENIZER_create_from_char, const char*, input);
+/*does not copy input: the characters have to outlive the tokenizer*/
+MOCKABLE_FUNCTION(, STRING_TOKENIZER_HANDLE, STRING_TOKENIZER_create_from_view, STRING_VIEW, input);
 MOCKABLE_FUNCTION(, int, STRING_TOKENIZER_get_next_token, STRING_TOKENIZER_HANDLE, t, STRING_HANDLE, output, const char*, delimiters);
+MOCKABLE_FUNCTION(, int, STRING_TOKENIZER_get_next_token_view, STRING_TOKENIZER_HANDLE, t, STRING_VIEW*, output, const char*, delimiters);
 MOCKABLE_FUNCTION(, void, STRING_TOKENIZER_destroy, STRING_TOKENIZER_HANDLE, t);
 
 #ifdef __cplusplus
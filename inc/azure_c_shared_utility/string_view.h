@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef STRING_VIEW_H
+#define STRING_VIEW_H
+
+#include "azure_c_shared_utility/strings.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#include <stdbool.h>
+#endif
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+/*a non owning (data, length) window over characters that live somewhere else (a STRING_HANDLE, a const char*, a received buffer).
+data is not necessarily '\0' terminated. A view is only valid for as long as the characters it looks at are*/
+typedef struct STRING_VIEW_TAG
+{
+    const char* data;
+    size_t length;
+} STRING_VIEW;
+
+/*returned by the find functions when there is no match*/
+#define STRING_VIEW_NOT_FOUND ((size_t)~(size_t)0)
+
+MOCKABLE_FUNCTION(, STRING_VIEW, STRING_VIEW_from_chars, const char*, source);
+MOCKABLE_FUNCTION(, STRING_VIEW, STRING_VIEW_from_n, const char*, source, size_t, length);
+MOCKABLE_FUNCTION(, STRING_VIEW, STRING_VIEW_from_STRING, STRING_HANDLE, handle);
+
+/*compare returns <0, 0, >0 like strcmp, equals compares with a '\0' terminated string*/
+MOCKABLE_FUNCTION(, int, STRING_VIEW_compare, STRING_VIEW, left, STRING_VIEW, right);
+MOCKABLE_FUNCTION(, bool, STRING_VIEW_equals, STRING_VIEW, view, const char*, s);
+
+MOCKABLE_FUNCTION(, size_t, STRING_VIEW_find_char, STRING_VIEW, view, char, c);
+MOCKABLE_FUNCTION(, size_t, STRING_VIEW_find, STRING_VIEW, view, STRING_VIEW, needle);
+
+MOCKABLE_FUNCTION(, STRING_VIEW, STRING_VIEW_substring, STRING_VIEW, view, size_t, start, size_t, length);
+MOCKABLE_FUNCTION(, STRING_VIEW, STRING_VIEW_trim, STRING_VIEW, view);
+
+/*splits "key=value" like views around the first separator*/
+MOCKABLE_FUNCTION(, int, STRING_VIEW_split_at, STRING_VIEW, view, char, separator, STRING_VIEW*, left, STRING_VIEW*, right);
+/*STRING_TOKENIZER without the tokenizer: takes the next token out of remaining, skipping leading delimiters*/
+MOCKABLE_FUNCTION(, int, STRING_VIEW_next_token, STRING_VIEW*, remaining, const char*, delimiters, STRING_VIEW*, token);
+
+/*the whole view has to be a decimal number that fits in the destination type*/
+MOCKABLE_FUNCTION(, int, STRING_VIEW_to_size_t, STRING_VIEW, view, size_t*, value);
+MOCKABLE_FUNCTION(, int, STRING_VIEW_to_int, STRING_VIEW, view, int*, value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* STRING_VIEW_H */
@@ -13,6 +13,7 @@ extern "C"
 #endif
 
 #include "azure_c_shared_utility/umock_c_prod.h"
+#include "azure_c_shared_utility/buffer_.h"
 
 typedef struct STRING_TAG* STRING_HANDLE;
 
@@ -21,6 +22,7 @@ MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_clone, STRING_HANDLE, handle);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_construct, const char*, psz);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_construct_n, const char*, psz, size_t, n);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_with_memory, const char*, memory);
+MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_from_BUFFER_move, BUFFER_HANDLE, buffer);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_quoted, const char*, source);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_JSON, const char*, source);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_from_byte_array, const unsigned char*, source, size_t, size);
@@ -35,8 +37,12 @@ MOCKABLE_FUNCTION(, int, STRING_empty, STRING_HANDLE, handle);
 MOCKABLE_FUNCTION(, size_t, STRING_length, STRING_HANDLE, handle);
 MOCKABLE_FUNCTION(, int, STRING_compare, STRING_HANDLE, s1, STRING_HANDLE, s2);
 
+/* makes room for a string of length characters so that appending up to that length does not reallocate */
+MOCKABLE_FUNCTION(, int, STRING_reserve, STRING_HANDLE, handle, size_t, length);
+
 extern STRING_HANDLE STRING_construct_sprintf(const char* format, ...);
 extern int STRING_sprintf(STRING_HANDLE s1, const char* format, ...);
+extern int STRING_append_format(STRING_HANDLE handle, const char* format, ...);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*this header contains macros for a vector specialized for one element type.
+VECTOR_HANDLE only knows the size of its elements at run time, so every push_back and every access goes
+through memcpy and a multiplication by elementSize. DECLARE_TYPED_VECTOR(type) introduces a vector of "type"
+instead, the element size is a compile time constant and the functions are inline, so that pushing and reading
+elements become direct stores and loads.
+
+The vector is a plain struct that can be embedded in another struct or live on the stack (there is no handle
+to allocate), it has to be initialized with the _init function and released with the _clear function.
+The storage is allocated with realloc/free from the translation unit that uses DECLARE_TYPED_VECTOR, so it
+follows gballoc the same way the code around it does. Elements are copied as values, so "type" has to be
+something that can be copied with "=" (a pointer, a number, a struct of those) and, because it is pasted into
+the names, a single identifier (a typedef for pointer types).
+
+Example:
+    DECLARE_TYPED_VECTOR(OPTION);
+    TYPED_VECTOR(OPTION) options;
+    TYPED_VECTOR_FUNCTION(OPTION, init)(&options);
+    if (TYPED_VECTOR_FUNCTION(OPTION, push_back)(&options, option) != 0) ...
+    for (i = 0; i < options.count; i++) ... options.storage[i] ...
+    TYPED_VECTOR_FUNCTION(OPTION, clear)(&options);
+*/
+
+#ifndef TYPED_VECTOR_H
+#define TYPED_VECTOR_H
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "azure_c_shared_utility/macro_utils.h"
+
+#if defined(_MSC_VER) && !defined(__cplusplus)
+#define TYPED_VECTOR_INLINE static __inline
+#else
+#define TYPED_VECTOR_INLINE static inline
+#endif
+
+#define TYPED_VECTOR(type) C2(type, _VECTOR)
+#define TYPED_VECTOR_FUNCTION(type, name) C3(TYPED_VECTOR(type), _, name)
+
+#define DECLARE_TYPED_VECTOR(type)                                                                              \
+typedef struct C2(TYPED_VECTOR(type), _TAG)                                                                     \
+{                                                                                                               \
+    type* storage;                                                                                              \
+    size_t count;                                                                                               \
+    size_t capacity;                                                                                            \
+} TYPED_VECTOR(type);                                                                                           \
+                                                                                                                \
+TYPED_VECTOR_INLINE void TYPED_VECTOR_FUNCTION(type, init)(TYPED_VECTOR(type)* vector)                          \
+{                                                                                                               \
+    vector->storage = NULL;                                                                                     \
+    vector->count = 0;                                                                                          \
+    vector->capacity = 0;                                                                                       \
+}                                                                                                               \
+                                                                                                                \
+/*releases the storage, the vector is empty after this and can be used again*/                                  \
+TYPED_VECTOR_INLINE void TYPED_VECTOR_FUNCTION(type, clear)(TYPED_VECTOR(type)* vector)                         \
+{                                                                                                               \
+    free(vector->storage);                                                                                      \
+    vector->storage = NULL;                                                                                     \
+    vector->count = 0;                                                                                          \
+    vector->capacity = 0;                                                                                       \
+}                                                                                                               \
+                                                                                                                \
+/*returns 0 when there is room for at least capacity elements*/                                                 \
+TYPED_VECTOR_INLINE int TYPED_VECTOR_FUNCTION(type, reserve)(TYPED_VECTOR(type)* vector, size_t capacity)       \
+{                                                                                                               \
+    int result;                                                                                                 \
+    if (capacity <= vector->capacity)                                                                           \
+    {                                                                                                           \
+        result = 0;                                                                                             \
+    }                                                                                                           \
+    else if (capacity > ((size_t)~(size_t)0) / sizeof(type))                                                    \
+    {                                                                                                           \
+        result = __LINE__;                                                                                      \
+    }                                                                                                           \
+    else                                                                                                        \
+    {                                                                                                           \
+        type* temp = (type*)realloc(vector->storage, capacity * sizeof(type));                                  \
+        if (temp == NULL)                                                                                       \
+        {                                                                                                       \
+            result = __LINE__;                                                                                  \
+        }                                                                                                       \
+        else                                                                                                    \
+        {                                                                                                       \
+            vector->storage = temp;                                                                             \
+            vector->capacity = capacity;                                                                        \
+            result = 0;                                                                                         \
+        }                                                                                                       \
+    }                                                                                                           \
+    return result;                                                                                              \
+}                                                                                                               \
+                                                                                                                \
+/*the storage doubles when it is full, the rarely taken path is kept out of push_back*/                         \
+TYPED_VECTOR_INLINE int TYPED_VECTOR_FUNCTION(type, grow)(TYPED_VECTOR(type)* vector)                           \
+{                                                                                                               \
+    size_t newCapacity = (vector->capacity == 0) ? 1 : vector->capacity * 2;                                    \
+    return (newCapacity < vector->capacity) ? __LINE__ : TYPED_VECTOR_FUNCTION(type, reserve)(vector, newCapacity); \
+}                                                                                                               \
+                                                                                                                \
+TYPED_VECTOR_INLINE int TYPED_VECTOR_FUNCTION(type, push_back)(TYPED_VECTOR(type)* vector, type element)        \
+{                                                                                                               \
+    int result;                                                                                                 \
+    if ((vector->count == vector->capacity) && (TYPED_VECTOR_FUNCTION(type, grow)(vector) != 0))                \
+    {                                                                                                           \
+        result = __LINE__;                                                                                      \
+    }                                                                                                           \
+    else                                                                                                        \
+    {                                                                                                           \
+        vector->storage[vector->count++] = element;                                                             \
+        result = 0;                                                                                             \
+    }                                                                                                           \
+    return result;                                                                                              \
+}                                                                                                               \
+                                                                                                                \
+TYPED_VECTOR_INLINE void TYPED_VECTOR_FUNCTION(type, pop_back)(TYPED_VECTOR(type)* vector)                      \
+{                                                                                                               \
+    if (vector->count > 0)                                                                                      \
+    {                                                                                                           \
+        vector->count--;                                                                                        \
+    }                                                                                                           \
+}                                                                                                               \
+                                                                                                                \
+/*removes numElements elements starting at index, the ones after them move down, the storage is kept*/          \
+TYPED_VECTOR_INLINE void TYPED_VECTOR_FUNCTION(type, erase)(TYPED_VECTOR(type)* vector, size_t index, size_t numElements) \
+{                                                                                                               \
+    if ((index < vector->count) && (numElements <= vector->count - index))                                      \
+    {                                                                                                           \
+        (void)memmove(vector->storage + index, vector->storage + index + numElements,                           \
+            (vector->count - index - numElements) * sizeof(type));                                              \
+        vector->count -= numElements;                                                                           \
+    }                                                                                                           \
+}                                                                                                               \
+                                                                                                                \
+/*NULL when index is out of range, code that already checked the index can use storage[index] directly*/        \
+TYPED_VECTOR_INLINE type* TYPED_VECTOR_FUNCTION(type, element)(const TYPED_VECTOR(type)* vector, size_t index)  \
+{                                                                                                               \
+    return (index < vector->count) ? vector->storage + index : NULL;                                            \
+}                                                                                                               \
+                                                                                                                \
+TYPED_VECTOR_INLINE size_t TYPED_VECTOR_FUNCTION(type, size)(const TYPED_VECTOR(type)* vector)                  \
+{                                                                                                               \
+    return vector->count;                                                                                       \
+}
+
+#endif /*TYPED_VECTOR_H*/
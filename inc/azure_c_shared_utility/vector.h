@@ -21,15 +21,21 @@ typedef struct VECTOR_TAG* VECTOR_HANDLE;
 
 typedef bool(*PREDICATE_FUNCTION)(const void* element, const void* value);
 
+/* like the comparator of qsort/bsearch: < 0, 0 or > 0. The searches below pass the key they are given as left and an element as right */
+typedef int(*VECTOR_COMPARE_FUNCTION)(const void* left, const void* right);
+
 /* creation */
 MOCKABLE_FUNCTION(, VECTOR_HANDLE, VECTOR_create, size_t, elementSize);
 MOCKABLE_FUNCTION(, void, VECTOR_destroy, VECTOR_HANDLE, handle);
 
 /* insertion */
 MOCKABLE_FUNCTION(, int, VECTOR_push_back, VECTOR_HANDLE, handle, const void*, elements, size_t, numElements);
+/* for a vector sorted by compare: inserts a copy of element after the elements that are not greater than it */
+MOCKABLE_FUNCTION(, int, VECTOR_insert_sorted, VECTOR_HANDLE, handle, const void*, element, VECTOR_COMPARE_FUNCTION, compare);
 
 /* removal */
 MOCKABLE_FUNCTION(, void, VECTOR_erase, VECTOR_HANDLE, handle, void*, elements, size_t, numElements);
+MOCKABLE_FUNCTION(, void, VECTOR_pop_back, VECTOR_HANDLE, handle);
 MOCKABLE_FUNCTION(, void, VECTOR_clear, VECTOR_HANDLE, handle);
 
 /* access */
@@ -38,8 +44,17 @@ MOCKABLE_FUNCTION(, void*, VECTOR_front, const VECTOR_HANDLE, handle);
 MOCKABLE_FUNCTION(, void*, VECTOR_back, const VECTOR_HANDLE, handle);
 MOCKABLE_FUNCTION(, void*, VECTOR_find_if, const VECTOR_HANDLE, handle, PREDICATE_FUNCTION, pred, const void*, value);
 
+/* sorted access, VECTOR_bsearch and VECTOR_lower_bound expect the vector to be sorted by the same compare */
+MOCKABLE_FUNCTION(, void, VECTOR_sort, VECTOR_HANDLE, handle, VECTOR_COMPARE_FUNCTION, compare);
+MOCKABLE_FUNCTION(, void*, VECTOR_bsearch, const VECTOR_HANDLE, handle, const void*, key, VECTOR_COMPARE_FUNCTION, compare);
+/* index of the first element that is not less than key, VECTOR_size if there is none */
+MOCKABLE_FUNCTION(, size_t, VECTOR_lower_bound, const VECTOR_HANDLE, handle, const void*, key, VECTOR_COMPARE_FUNCTION, compare);
+
 /* capacity */
 MOCKABLE_FUNCTION(, size_t, VECTOR_size, const VECTOR_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, VECTOR_capacity, const VECTOR_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, VECTOR_reserve, VECTOR_HANDLE, handle, size_t, capacity);
+MOCKABLE_FUNCTION(, void, VECTOR_shrink_to_fit, VECTOR_HANDLE, handle);
 
 #ifdef __cplusplus
 }
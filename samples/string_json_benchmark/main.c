@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/*times STRING_new_JSON on telemetry like keys and values. Run string_json_benchmark and string_json_benchmark_scalar
+on the same machine to compare the SIMD scan with the byte by byte one*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/strings.h"
+
+#ifdef STRING_JSON_BENCHMARK_SCALAR
+#define BENCHMARK_PATH "scalar"
+#else
+#define BENCHMARK_PATH "default"
+#endif
+
+#define ITERATIONS 1000000
+
+static const struct BENCHMARK_INPUT_TAG
+{
+    const char* name;
+    const char* source;
+} inputs[] =
+{
+    { "short key", "temperature" },
+    { "clean value", "Contoso thermostat, building 42, floor 3, north wing, meeting room Lakeview" },
+    { "url value", "https://contoso.azure-devices.net/devices/thermostat-0042/messages/events?api-version=2016-11-14" },
+    { "quoted value", "{\"temperature\":21.5,\"humidity\":40,\"status\":\"ok\",\"path\":\"C:\\\\data\\\\log.txt\"}" },
+    { "control characters", "line one\r\nline two\r\n\tindented line three\r\nline four without anything special in it\r\n" }
+};
+
+/*tickcounter only counts seconds on some platforms, clock() is good enough to compare two runs*/
+int main(void)
+{
+    int result = 0;
+    size_t i;
+    (void)printf("STRING_new_JSON (%s path), %d calls per input\r\n", BENCHMARK_PATH, ITERATIONS);
+    for (i = 0; (result == 0) && (i < sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        clock_t start;
+        clock_t end;
+        size_t outputLength = 0;
+        size_t j;
+        start = clock();
+        for (j = 0; j < ITERATIONS; j++)
+        {
+            STRING_HANDLE json = STRING_new_JSON(inputs[i].source);
+            if (json == NULL)
+            {
+                (void)printf("STRING_new_JSON failed for %s\r\n", inputs[i].name);
+                result = __LINE__;
+                break;
+            }
+            else
+            {
+                /*keeps the compiler from throwing the work away*/
+                outputLength += STRING_length(json);
+                STRING_delete(json);
+            }
+        }
+        end = clock();
+
+        if (result == 0)
+        {
+            unsigned long elapsed = (unsigned long)((double)(end - start) * 1000.0 / CLOCKS_PER_SEC);
+            double megabytes = (double)strlen(inputs[i].source) * ITERATIONS / (1024.0 * 1024.0);
+            (void)printf("%-20s %4lu bytes: %6lu ms, %8.1f MB/s (%lu bytes produced)\r\n",
+                inputs[i].name, (unsigned long)strlen(inputs[i].source), elapsed,
+                (elapsed == 0) ? 0.0 : megabytes * 1000.0 / elapsed, (unsigned long)outputLength);
+        }
+    }
+    return result;
+}
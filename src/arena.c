@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/arena.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+/* every pointer handed out by ARENA_alloc is aligned like the block payload, which is aligned for any basic type */
+typedef union ARENA_ALIGNMENT_TAG
+{
+    long double longDoubleValue;
+    long long longLongValue;
+    void* pointerValue;
+    void(*functionValue)(void);
+} ARENA_ALIGNMENT;
+
+typedef struct ARENA_BLOCK_TAG
+{
+    struct ARENA_BLOCK_TAG* next;
+    size_t size;
+    ARENA_ALIGNMENT payload[1];
+} ARENA_BLOCK;
+
+typedef struct ARENA_TAG
+{
+    size_t blockSize;
+    ARENA_BLOCK* firstBlock;
+    ARENA_BLOCK* currentBlock;
+    size_t used;
+} ARENA;
+
+#define ARENA_BLOCK_HEADER_SIZE offsetof(ARENA_BLOCK, payload)
+
+static ARENA_BLOCK* allocateBlock(size_t size)
+{
+    ARENA_BLOCK* result;
+    if (size > ((size_t)~(size_t)0) - ARENA_BLOCK_HEADER_SIZE)
+    {
+        LogError("arena block size too big: %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else if ((result = (ARENA_BLOCK*)malloc(ARENA_BLOCK_HEADER_SIZE + size)) == NULL)
+    {
+        LogError("unable to malloc an arena block");
+    }
+    else
+    {
+        result->next = NULL;
+        result->size = size;
+    }
+    return result;
+}
+
+ARENA_HANDLE ARENA_create(size_t blockSize)
+{
+    ARENA* result;
+    if (blockSize == 0)
+    {
+        /*Codes_SRS_ARENA_07_001: [If blockSize is 0, ARENA_create shall fail and return NULL.]*/
+        LogError("invalid arg: blockSize = 0");
+        result = NULL;
+    }
+    /*Codes_SRS_ARENA_07_002: [ARENA_create shall allocate the arena and return a non-NULL handle to it.]*/
+    else if ((result = (ARENA*)malloc(sizeof(ARENA))) == NULL)
+    {
+        /*Codes_SRS_ARENA_07_003: [If any allocation fails, ARENA_create shall fail and return NULL.]*/
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /*Codes_SRS_ARENA_07_004: [The memory for the allocations is obtained in blocks of blockSize bytes, the first block shall be allocated by the first ARENA_alloc call.]*/
+        result->blockSize = blockSize;
+        result->firstBlock = NULL;
+        result->currentBlock = NULL;
+        result->used = 0;
+    }
+    return (ARENA_HANDLE)result;
+}
+
+void ARENA_destroy(ARENA_HANDLE handle)
+{
+    /*Codes_SRS_ARENA_07_005: [If handle is NULL, ARENA_destroy shall do nothing.]*/
+    if (handle != NULL)
+    {
+        /*Codes_SRS_ARENA_07_006: [ARENA_destroy shall free all the blocks of the arena and the arena itself.]*/
+        ARENA_BLOCK* block = handle->firstBlock;
+        while (block != NULL)
+        {
+            ARENA_BLOCK* next = block->next;
+            free(block);
+            block = next;
+        }
+        free(handle);
+    }
+}
+
+void* ARENA_alloc(ARENA_HANDLE handle, size_t size)
+{
+    void* result;
+    if ((handle == NULL) || (size == 0))
+    {
+        /*Codes_SRS_ARENA_07_007: [If handle is NULL or size is 0, ARENA_alloc shall fail and return NULL.]*/
+        LogError("invalid arg: handle = %p, size = %lu", handle, (unsigned long)size);
+        result = NULL;
+    }
+    else if (size > ((size_t)~(size_t)0) - sizeof(ARENA_ALIGNMENT))
+    {
+        LogError("size too big: %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        size_t alignedSize = (size + sizeof(ARENA_ALIGNMENT) - 1) / sizeof(ARENA_ALIGNMENT) * sizeof(ARENA_ALIGNMENT);
+
+        /*Codes_SRS_ARENA_07_009: [ARENA_alloc shall reuse the blocks kept by ARENA_reset before allocating new ones.]*/
+        while ((handle->currentBlock != NULL) &&
+            (handle->currentBlock->size - handle->used < alignedSize) &&
+            (handle->currentBlock->next != NULL))
+        {
+            handle->currentBlock = handle->currentBlock->next;
+            handle->used = 0;
+        }
+
+        if ((handle->currentBlock == NULL) ||
+            (handle->currentBlock->size - handle->used < alignedSize))
+        {
+            /*Codes_SRS_ARENA_07_010: [If the remaining blocks cannot hold size bytes, ARENA_alloc shall allocate a new block of blockSize bytes, or of size bytes if size is bigger than blockSize.]*/
+            ARENA_BLOCK* block = allocateBlock((alignedSize > handle->blockSize) ? alignedSize : handle->blockSize);
+            if (block == NULL)
+            {
+                /*Codes_SRS_ARENA_07_011: [If allocating the new block fails, ARENA_alloc shall fail and return NULL.]*/
+                result = NULL;
+            }
+            else
+            {
+                if (handle->currentBlock == NULL)
+                {
+                    handle->firstBlock = block;
+                }
+                else
+                {
+                    handle->currentBlock->next = block;
+                }
+                handle->currentBlock = block;
+                handle->used = 0;
+            }
+        }
+
+        if ((handle->currentBlock != NULL) &&
+            (handle->currentBlock->size - handle->used >= alignedSize))
+        {
+            /*Codes_SRS_ARENA_07_008: [ARENA_alloc shall return a pointer to size bytes of memory, aligned for any basic type, that stays valid until the next ARENA_reset or ARENA_destroy.]*/
+            result = (unsigned char*)handle->currentBlock->payload + handle->used;
+            handle->used += alignedSize;
+        }
+        else
+        {
+            result = NULL;
+        }
+    }
+    return result;
+}
+
+char* ARENA_strdup(ARENA_HANDLE handle, const char* source)
+{
+    char* result;
+    if ((handle == NULL) || (source == NULL))
+    {
+        /*Codes_SRS_ARENA_07_012: [If handle or source is NULL, ARENA_strdup shall fail and return NULL.]*/
+        LogError("invalid arg: handle = %p, source = %p", handle, source);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_ARENA_07_013: [ARENA_strdup shall copy source (including the terminating '\0') in memory obtained with ARENA_alloc and return the copy.]*/
+        size_t size = strlen(source) + 1;
+        if ((result = (char*)ARENA_alloc(handle, size)) == NULL)
+        {
+            /*Codes_SRS_ARENA_07_014: [If ARENA_alloc fails, ARENA_strdup shall fail and return NULL.]*/
+            LogError("unable to ARENA_alloc");
+        }
+        else
+        {
+            (void)memcpy(result, source, size);
+        }
+    }
+    return result;
+}
+
+void ARENA_reset(ARENA_HANDLE handle)
+{
+    /*Codes_SRS_ARENA_07_015: [If handle is NULL, ARENA_reset shall do nothing.]*/
+    if (handle != NULL)
+    {
+        /*Codes_SRS_ARENA_07_016: [ARENA_reset shall release all the allocations made since the arena was created or last reset, without freeing the blocks that hold them.]*/
+        handle->currentBlock = handle->firstBlock;
+        handle->used = 0;
+    }
+}
@@ -23,8 +23,57 @@ typedef struct BUFFER_TAG
 {
     unsigned char* buffer;
     size_t size;
+    size_t capacity;
+    size_t headroom;
 }BUFFER;
 
+/* buffer points headroom bytes into the allocated block, the free space in front of the data is what BUFFER_prepend/BUFFER_push_front consume */
+static unsigned char* BUFFER_allocation(BUFFER* b)
+{
+    return (b->buffer == NULL) ? NULL : b->buffer - b->headroom;
+}
+
+/* makes room for at least required bytes, growing the capacity geometrically so that repeated enlarge/append calls cost amortized O(1) copies per byte */
+static int BUFFER_grow(BUFFER* b, size_t required)
+{
+    int result;
+    if (required <= b->capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t newCapacity = (b->capacity > ((size_t)~(size_t)0) / 2) ? required : b->capacity * 2;
+        unsigned char* temp;
+        if (newCapacity < required)
+        {
+            newCapacity = required;
+        }
+        if (newCapacity > ((size_t)~(size_t)0) - b->headroom)
+        {
+            newCapacity = required;
+        }
+
+        if (required > ((size_t)~(size_t)0) - b->headroom)
+        {
+            LogError("size overflow");
+            result = __LINE__;
+        }
+        else if ((temp = (unsigned char*)realloc(BUFFER_allocation(b), b->headroom + newCapacity)) == NULL)
+        {
+            LogError("unable to realloc to %lu bytes", (unsigned long)newCapacity);
+            result = __LINE__;
+        }
+        else
+        {
+            b->buffer = temp + b->headroom;
+            b->capacity = newCapacity;
+            result = 0;
+        }
+    }
+    return result;
+}
+
 /* Codes_SRS_BUFFER_07_001: [BUFFER_new shall allocate a BUFFER_HANDLE that will contain a NULL unsigned char*.] */
 BUFFER_HANDLE BUFFER_new(void)
 {
@@ -34,6 +83,8 @@ BUFFER_HANDLE BUFFER_new(void)
     {
         temp->buffer = NULL;
         temp->size = 0;
+        temp->capacity = 0;
+        temp->headroom = 0;
     }
     return (BUFFER_HANDLE)temp;
 }
@@ -56,6 +107,8 @@ static int BUFFER_safemalloc(BUFFER* handleptr, size_t size)
     {
         // we still consider the real buffer size is 0
         handleptr->size = size;
+        handleptr->capacity = sizetomalloc;
+        handleptr->headroom = 0;
         result = 0;
     }
     return result;
@@ -97,6 +150,60 @@ BUFFER_HANDLE BUFFER_create(const unsigned char* source, size_t size)
     return (BUFFER_HANDLE)result;
 }
 
+BUFFER_HANDLE BUFFER_create_with_moved_memory(unsigned char* memory, size_t size)
+{
+    BUFFER* result;
+    if ((memory == NULL) && (size > 0))
+    {
+        /* Codes_SRS_BUFFER_07_053: [If memory is NULL and size is not 0, BUFFER_create_with_moved_memory shall return NULL.] */
+        LogError("invalid arg: memory is NULL, size = %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else if ((result = (BUFFER*)malloc(sizeof(BUFFER))) == NULL)
+    {
+        /* Codes_SRS_BUFFER_07_055: [If allocating the BUFFER fails, BUFFER_create_with_moved_memory shall return NULL and the caller shall keep the ownership of memory.] */
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_07_054: [Otherwise BUFFER_create_with_moved_memory shall return a BUFFER that takes the ownership of memory (which shall have been allocated with malloc) without copying it.] */
+        result->buffer = memory;
+        result->size = size;
+        result->capacity = size;
+        result->headroom = 0;
+    }
+    return (BUFFER_HANDLE)result;
+}
+
+unsigned char* BUFFER_detach(BUFFER_HANDLE handle, size_t* size)
+{
+    unsigned char* result;
+    if ((handle == NULL) || (size == NULL))
+    {
+        /* Codes_SRS_BUFFER_07_056: [If handle or size is NULL, BUFFER_detach shall return NULL.] */
+        LogError("invalid arg: handle = %p, size = %p", handle, size);
+        result = NULL;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        result = BUFFER_allocation(b);
+        if ((result != NULL) && (b->headroom > 0) && (b->size > 0))
+        {
+            /* the block has to be freeable by the caller, so the content moves down over the headroom */
+            (void)memmove(result, b->buffer, b->size);
+        }
+
+        /* Codes_SRS_BUFFER_07_057: [BUFFER_detach shall return the memory holding the content of the buffer (to be freed by the caller with free), set *size to the size of the content and leave the buffer empty, as if created by BUFFER_new.] */
+        *size = b->size;
+        b->buffer = NULL;
+        b->size = 0;
+        b->capacity = 0;
+        b->headroom = 0;
+    }
+    return result;
+}
+
 /* Codes_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE along with the Buffer.] */
 void BUFFER_delete(BUFFER_HANDLE handle)
 {
@@ -107,7 +214,7 @@ void BUFFER_delete(BUFFER_HANDLE handle)
         if (b->buffer != NULL)
         {
             /* Codes_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE along with the Buffer.] */
-            free(b->buffer);
+            free(BUFFER_allocation(b));
         }
         free(b);
     }
@@ -129,9 +236,11 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
     {
         /* Codes_SRS_BUFFER_01_003: [If size is zero, source can be NULL.] */
         BUFFER* b = (BUFFER*)handle;
-        free(b->buffer);
+        free(BUFFER_allocation(b));
         b->buffer = NULL;
         b->size = 0;
+        b->capacity = 0;
+        b->headroom = 0;
 
         result = 0;
     }
@@ -142,11 +251,17 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
             /* Codes_SRS_BUFFER_01_001: [If size is positive and source is NULL, BUFFER_build shall return nonzero] */
             result = __LINE__;
         }
+        else if (size > ((size_t)~(size_t)0) - ((BUFFER*)handle)->headroom)
+        {
+            /* Codes_SRS_BUFFER_07_010: [BUFFER_build shall return nonzero if any error is encountered.] */
+            LogError("size overflow");
+            result = __LINE__;
+        }
         else
         {
             BUFFER* b = (BUFFER*)handle;
             /* Codes_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
-            unsigned char* newBuffer = (unsigned char*)realloc(b->buffer, size);
+            unsigned char* newBuffer = (unsigned char*)realloc(BUFFER_allocation(b), b->headroom + size);
             if (newBuffer == NULL)
             {
                 /* Codes_SRS_BUFFER_07_010: [BUFFER_build shall return nonzero if any error is encountered.] */
@@ -154,8 +269,9 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
             }
             else
             {
-                b->buffer = newBuffer;
+                b->buffer = newBuffer + b->headroom;
                 b->size = size;
+                b->capacity = size;
                 /* Codes_SRS_BUFFER_01_002: [The size argument can be zero, in which case nothing shall be copied from source.] */
                 (void)memcpy(b->buffer, source, size);
 
@@ -201,6 +317,7 @@ int BUFFER_pre_build(BUFFER_HANDLE handle, size_t size)
             else
             {
                 b->size = size;
+                b->capacity = size;
                 result = 0;
             }
         }
@@ -241,9 +358,11 @@ extern int BUFFER_unbuild(BUFFER_HANDLE handle)
         BUFFER* b = (BUFFER*)handle;
         if (b->buffer != NULL)
         {
-            free(b->buffer);
+            free(BUFFER_allocation(b));
             b->buffer = NULL;
             b->size = 0;
+            b->capacity = 0;
+            b->headroom = 0;
             result = 0;
         }
         else
@@ -269,18 +388,23 @@ int BUFFER_enlarge(BUFFER_HANDLE handle, size_t enlargeSize)
         /* Codes_SRS_BUFFER_07_017: [BUFFER_enlarge shall return a nonzero result if any parameters are NULL or zero.] */
         result = __LINE__;
     }
+    else if (enlargeSize > ((size_t)~(size_t)0) - ((BUFFER*)handle)->size)
+    {
+        /* Codes_SRS_BUFFER_07_018: [BUFFER_enlarge shall return a nonzero result if any error is encountered.] */
+        LogError("size overflow");
+        result = __LINE__;
+    }
     else
     {
         BUFFER* b = (BUFFER*)handle;
-        unsigned char* temp = (unsigned char*)realloc(b->buffer, b->size + enlargeSize);
-        if (temp == NULL)
+        /* Codes_SRS_BUFFER_07_030: [When BUFFER_enlarge or BUFFER_append need more memory than the current capacity, the capacity shall grow to the bigger of twice the current capacity and the needed size.] */
+        if (BUFFER_grow(b, b->size + enlargeSize) != 0)
         {
             /* Codes_SRS_BUFFER_07_018: [BUFFER_enlarge shall return a nonzero result if any error is encountered.] */
             result = __LINE__;
         }
         else
         {
-            b->buffer = temp;
             b->size += enlargeSize;
             result = 0;
         }
@@ -306,6 +430,106 @@ int BUFFER_size(BUFFER_HANDLE handle, size_t* size)
     return result;
 }
 
+int BUFFER_reserve(BUFFER_HANDLE handle, size_t capacity)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_BUFFER_07_031: [If handle is NULL, BUFFER_reserve shall return a nonzero value.] */
+        LogError("invalid arg: handle is NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        if (capacity <= b->capacity)
+        {
+            /* Codes_SRS_BUFFER_07_032: [If capacity is not bigger than the current capacity, BUFFER_reserve shall do nothing and return zero.] */
+            result = 0;
+        }
+        else if (capacity > ((size_t)~(size_t)0) - b->headroom)
+        {
+            /* Codes_SRS_BUFFER_07_034: [If reallocating fails, BUFFER_reserve shall return a nonzero value and the buffer shall be unchanged.] */
+            LogError("size overflow");
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_BUFFER_07_033: [Otherwise BUFFER_reserve shall reallocate the underlying memory to hold exactly capacity bytes, keeping the content and the size of the buffer, and return zero.] */
+            unsigned char* temp = (unsigned char*)realloc(BUFFER_allocation(b), b->headroom + capacity);
+            if (temp == NULL)
+            {
+                /* Codes_SRS_BUFFER_07_034: [If reallocating fails, BUFFER_reserve shall return a nonzero value and the buffer shall be unchanged.] */
+                LogError("unable to realloc to %lu bytes", (unsigned long)capacity);
+                result = __LINE__;
+            }
+            else
+            {
+                b->buffer = temp + b->headroom;
+                b->capacity = capacity;
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
+
+int BUFFER_shrink_to_fit(BUFFER_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_BUFFER_07_035: [If handle is NULL, BUFFER_shrink_to_fit shall return a nonzero value.] */
+        LogError("invalid arg: handle is NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        /* a non-NULL buffer of size 0 keeps 1 byte, the same way BUFFER_create does */
+        size_t fitSize = (b->size == 0) ? 1 : b->size;
+        if ((b->buffer == NULL) || (b->capacity <= fitSize))
+        {
+            /* Codes_SRS_BUFFER_07_036: [If the capacity does not exceed the size of the buffer, BUFFER_shrink_to_fit shall do nothing and return zero.] */
+            result = 0;
+        }
+        else
+        {
+            /* Codes_SRS_BUFFER_07_037: [Otherwise BUFFER_shrink_to_fit shall reallocate the underlying memory to the size of the buffer and return zero.] */
+            unsigned char* temp = (unsigned char*)realloc(BUFFER_allocation(b), b->headroom + fitSize);
+            if (temp == NULL)
+            {
+                /* Codes_SRS_BUFFER_07_038: [If reallocating fails, BUFFER_shrink_to_fit shall return a nonzero value and the buffer shall be unchanged.] */
+                LogError("unable to realloc to %lu bytes", (unsigned long)fitSize);
+                result = __LINE__;
+            }
+            else
+            {
+                b->buffer = temp + b->headroom;
+                b->capacity = fitSize;
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
+
+size_t BUFFER_capacity(BUFFER_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_BUFFER_07_040: [If handle is NULL, BUFFER_capacity shall return 0.] */
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_07_039: [BUFFER_capacity shall return the number of bytes the buffer can hold without reallocating.] */
+        result = ((BUFFER*)handle)->capacity;
+    }
+    return result;
+}
+
 /* Codes_SRS_BUFFER_07_024: [BUFFER_append concatenates b2 onto b1 without modifying b2 and shall return zero on success.] */
 int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
 {
@@ -336,11 +560,17 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 // b2->size = 0, whatever b1->size is, do nothing
                 result = 0;
             }
+            else if (b2->size > ((size_t)~(size_t)0) - b1->size)
+            {
+                /* Codes_SRS_BUFFER_07_023: [BUFFER_append shall return a nonzero upon any error that is encountered.] */
+                LogError("size overflow");
+                result = __LINE__;
+            }
             else
             {
                 // b2->size != 0, whatever b1->size is
-                unsigned char* temp = (unsigned char*)realloc(b1->buffer, b1->size + b2->size);
-                if (temp == NULL)
+                /* Codes_SRS_BUFFER_07_030: [When BUFFER_enlarge or BUFFER_append need more memory than the current capacity, the capacity shall grow to the bigger of twice the current capacity and the needed size.] */
+                if (BUFFER_grow(b1, b1->size + b2->size) != 0)
                 {
                     /* Codes_SRS_BUFFER_07_023: [BUFFER_append shall return a nonzero upon any error that is encountered.] */
                     result = __LINE__;
@@ -348,7 +578,6 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 else
                 {
                     /* Codes_SRS_BUFFER_07_024: [BUFFER_append concatenates b2 onto b1 without modifying b2 and shall return zero on success.]*/
-                    b1->buffer = temp;
                     // Append the BUFFER
                     (void)memcpy(&b1->buffer[b1->size], b2->buffer, b2->size);
                     b1->size += b2->size;
@@ -360,6 +589,52 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
     return result;
 }
 
+/* puts size (non zero) bytes in front of the data of b, in the headroom when it is big enough, otherwise in a new block that has no headroom */
+static int BUFFER_push_front_bytes(BUFFER* b, const unsigned char* source, size_t size)
+{
+    int result;
+    if (size <= b->headroom)
+    {
+        /* Codes_SRS_BUFFER_07_041: [If the headroom of the buffer can hold the new bytes, BUFFER_prepend and BUFFER_push_front shall copy them in the headroom, without copying the content of the buffer.] */
+        b->buffer -= size;
+        b->headroom -= size;
+        b->capacity += size;
+        b->size += size;
+        (void)memcpy(b->buffer, source, size);
+        result = 0;
+    }
+    else if (size > ((size_t)~(size_t)0) - b->size)
+    {
+        LogError("size overflow");
+        result = __LINE__;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_07_042: [Otherwise BUFFER_prepend and BUFFER_push_front shall allocate a new block for the new bytes followed by the content of the buffer.] */
+        unsigned char* temp = (unsigned char*)malloc(b->size + size);
+        if (temp == NULL)
+        {
+            LogError("unable to malloc");
+            result = __LINE__;
+        }
+        else
+        {
+            (void)memcpy(temp, source, size);
+            if (b->size > 0)
+            {
+                (void)memcpy(&temp[size], b->buffer, b->size);
+            }
+            free(BUFFER_allocation(b));
+            b->buffer = temp;
+            b->size += size;
+            b->capacity = b->size;
+            b->headroom = 0;
+            result = 0;
+        }
+    }
+    return result;
+}
+
 int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
 {
     int result;
@@ -390,33 +665,111 @@ int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 // do nothing
                 result = 0;
             }
+            else if (BUFFER_push_front_bytes(b1, b2->buffer, b2->size) != 0)
+            {
+                /* Codes_SRS_BUFFER_01_005: [ BUFFER_prepend shall return a non-zero upon value any error that is encountered. ]*/
+                result = __LINE__;
+            }
             else
             {
-                // b2->size != 0
-                unsigned char* temp = (unsigned char*)malloc(b1->size + b2->size);
-                if (temp == NULL)
-                {
-                    /* Codes_SRS_BUFFER_01_005: [ BUFFER_prepend shall return a non-zero upon value any error that is encountered. ]*/
-                    result = __LINE__;
-                }
-                else
-                {
-                    /* Codes_SRS_BUFFER_01_004: [ BUFFER_prepend concatenates handle1 onto handle2 without modifying handle1 and shall return zero on success. ]*/
-                    // Append the BUFFER
-                    (void)memcpy(temp, b2->buffer, b2->size);
-                    // start from b1->size to append b1
-                    (void)memcpy(&temp[b2->size], b1->buffer, b1->size);
-                    free(b1->buffer);
-                    b1->buffer = temp;
-                    b1->size += b2->size;
-                    result = 0;
-                }
+                /* Codes_SRS_BUFFER_01_004: [ BUFFER_prepend concatenates handle1 onto handle2 without modifying handle1 and shall return zero on success. ]*/
+                result = 0;
             }
         }
     }
     return result;
 }
 
+int BUFFER_push_front(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
+{
+    int result;
+    if ((handle == NULL) || ((source == NULL) && (size > 0)))
+    {
+        /* Codes_SRS_BUFFER_07_043: [If handle is NULL, or source is NULL and size is not 0, BUFFER_push_front shall return a nonzero value.] */
+        LogError("invalid arg: handle = %p, source = %p, size = %lu", handle, source, (unsigned long)size);
+        result = __LINE__;
+    }
+    else if (size == 0)
+    {
+        /* Codes_SRS_BUFFER_07_044: [If size is 0, BUFFER_push_front shall do nothing and return zero.] */
+        result = 0;
+    }
+    /* Codes_SRS_BUFFER_07_045: [Otherwise BUFFER_push_front shall put the size bytes at source in front of the content of the buffer and return zero.] */
+    else if (BUFFER_push_front_bytes((BUFFER*)handle, source, size) != 0)
+    {
+        /* Codes_SRS_BUFFER_07_046: [If any error occurs, BUFFER_push_front shall return a nonzero value and the buffer shall be unchanged.] */
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+BUFFER_HANDLE BUFFER_create_with_headroom(const unsigned char* source, size_t size, size_t headroom)
+{
+    BUFFER* result;
+    if ((source == NULL) && (size > 0))
+    {
+        /* Codes_SRS_BUFFER_07_047: [If source is NULL and size is not 0, BUFFER_create_with_headroom shall return NULL.] */
+        LogError("invalid arg: source is NULL, size = %lu", (unsigned long)size);
+        result = NULL;
+    }
+    else if (size > ((size_t)~(size_t)0) - headroom)
+    {
+        LogError("size overflow");
+        result = NULL;
+    }
+    else if ((result = (BUFFER*)malloc(sizeof(BUFFER))) == NULL)
+    {
+        /* Codes_SRS_BUFFER_07_050: [If allocating memory fails, BUFFER_create_with_headroom shall return NULL.] */
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_07_048: [BUFFER_create_with_headroom shall allocate one block for headroom bytes followed by size bytes and shall copy size bytes from source after the headroom.] */
+        /* as in BUFFER_create, an empty buffer still gets 1 byte of memory */
+        size_t sizeToMalloc = ((headroom + size) == 0) ? 1 : (headroom + size);
+        unsigned char* allocation = (unsigned char*)malloc(sizeToMalloc);
+        if (allocation == NULL)
+        {
+            /* Codes_SRS_BUFFER_07_050: [If allocating memory fails, BUFFER_create_with_headroom shall return NULL.] */
+            LogError("unable to malloc");
+            free(result);
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_BUFFER_07_049: [Prepending up to headroom bytes to the new buffer shall not allocate memory nor copy its content.] */
+            result->buffer = allocation + headroom;
+            result->size = size;
+            result->capacity = sizeToMalloc - headroom;
+            result->headroom = headroom;
+            if (size > 0)
+            {
+                (void)memcpy(result->buffer, source, size);
+            }
+        }
+    }
+    return (BUFFER_HANDLE)result;
+}
+
+size_t BUFFER_headroom(BUFFER_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_BUFFER_07_052: [If handle is NULL, BUFFER_headroom shall return 0.] */
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_BUFFER_07_051: [BUFFER_headroom shall return the number of bytes that can be prepended to the buffer without reallocating.] */
+        result = ((BUFFER*)handle)->headroom;
+    }
+    return result;
+}
 
 /* Codes_SRS_BUFFER_07_025: [BUFFER_u_char shall return a pointer to the underlying unsigned char*.] */
 unsigned char* BUFFER_u_char(BUFFER_HANDLE handle)
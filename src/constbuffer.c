@@ -17,6 +17,8 @@
 typedef struct CONSTBUFFER_HANDLE_DATA_TAG
 {
     CONSTBUFFER alias;
+    /*for a slice: the const buffer that owns the memory (and on which the slice holds a reference), NULL otherwise*/
+    struct CONSTBUFFER_HANDLE_DATA_TAG* owner;
 }CONSTBUFFER_HANDLE_DATA;
 
 DEFINE_REFCOUNT_TYPE(CONSTBUFFER_HANDLE_DATA);
@@ -37,6 +39,7 @@ static CONSTBUFFER_HANDLE CONSTBUFFER_Create_Internal(const unsigned char* sourc
     else
     {
         /*Codes_SRS_CONSTBUFFER_02_002: [Otherwise, CONSTBUFFER_Create shall create a copy of the memory area pointed to by source having size bytes.]*/
+        result->owner = NULL;
         result->alias.size = size;
         if (size == 0)
         {
@@ -105,6 +108,98 @@ CONSTBUFFER_HANDLE CONSTBUFFER_CreateFromBuffer(BUFFER_HANDLE buffer)
     return (CONSTBUFFER_HANDLE)result;
 }
 
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateWithMoveMemory(unsigned char* source, size_t size)
+{
+    CONSTBUFFER_HANDLE_DATA* result;
+    if ((source == NULL) && (size != 0))
+    {
+        /*Codes_SRS_CONSTBUFFER_07_001: [If source is NULL and size is different than 0 then CONSTBUFFER_CreateWithMoveMemory shall fail and return NULL.]*/
+        LogError("invalid arguments passed to CONSTBUFFER_CreateWithMoveMemory");
+        result = NULL;
+    }
+    /*Codes_SRS_CONSTBUFFER_07_004: [The non-NULL handle returned by CONSTBUFFER_CreateWithMoveMemory shall have its ref count set to "1".]*/
+    else if ((result = REFCOUNT_TYPE_CREATE(CONSTBUFFER_HANDLE_DATA)) == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_07_003: [If any error occurs, CONSTBUFFER_CreateWithMoveMemory shall fail, return NULL and leave the ownership of source with the caller.]*/
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_07_002: [Otherwise CONSTBUFFER_CreateWithMoveMemory shall take the ownership of source (which shall have been allocated with malloc) without copying it, and return a non-NULL handle.]*/
+        result->alias.buffer = source;
+        result->alias.size = size;
+        result->owner = NULL;
+    }
+    return (CONSTBUFFER_HANDLE)result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateFromBufferWithMove(BUFFER_HANDLE buffer)
+{
+    CONSTBUFFER_HANDLE_DATA* result;
+    if (buffer == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_07_005: [If buffer is NULL then CONSTBUFFER_CreateFromBufferWithMove shall fail and return NULL.]*/
+        LogError("invalid arg passed to CONSTBUFFER_CreateFromBufferWithMove");
+        result = NULL;
+    }
+    /*Codes_SRS_CONSTBUFFER_07_008: [The non-NULL handle returned by CONSTBUFFER_CreateFromBufferWithMove shall have its ref count set to "1".]*/
+    else if ((result = REFCOUNT_TYPE_CREATE(CONSTBUFFER_HANDLE_DATA)) == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_07_007: [If any error occurs, CONSTBUFFER_CreateFromBufferWithMove shall fail, return NULL and leave buffer unchanged.]*/
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_07_006: [Otherwise CONSTBUFFER_CreateFromBufferWithMove shall take the memory of buffer with BUFFER_detach, without copying it, and return a non-NULL handle. buffer is left empty.]*/
+        size_t size;
+        unsigned char* memory = BUFFER_detach(buffer, &size);
+        if (size == 0)
+        {
+            /*an empty BUFFER may still own a byte of memory, an empty CONSTBUFFER has a NULL buffer*/
+            free(memory);
+            memory = NULL;
+        }
+        result->alias.buffer = memory;
+        result->alias.size = size;
+        result->owner = NULL;
+    }
+    return (CONSTBUFFER_HANDLE)result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateSlice(CONSTBUFFER_HANDLE handle, size_t offset, size_t length)
+{
+    CONSTBUFFER_HANDLE_DATA* result;
+    if (handle == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_07_009: [If handle is NULL then CONSTBUFFER_CreateSlice shall fail and return NULL.]*/
+        LogError("invalid arg: handle is NULL");
+        result = NULL;
+    }
+    else if ((offset > handle->alias.size) || (length > handle->alias.size - offset))
+    {
+        /*Codes_SRS_CONSTBUFFER_07_010: [If offset + length exceeds the size of handle then CONSTBUFFER_CreateSlice shall fail and return NULL.]*/
+        LogError("invalid arg: offset = %lu, length = %lu, size = %lu", (unsigned long)offset, (unsigned long)length, (unsigned long)handle->alias.size);
+        result = NULL;
+    }
+    /*Codes_SRS_CONSTBUFFER_07_014: [The non-NULL handle returned by CONSTBUFFER_CreateSlice shall have its ref count set to "1".]*/
+    else if ((result = REFCOUNT_TYPE_CREATE(CONSTBUFFER_HANDLE_DATA)) == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_07_013: [If any error occurs, CONSTBUFFER_CreateSlice shall fail and return NULL.]*/
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_07_011: [Otherwise CONSTBUFFER_CreateSlice shall return a handle whose content is the length bytes of handle starting at offset, referencing the memory of handle without copying it.]*/
+        /*Codes_SRS_CONSTBUFFER_07_012: [CONSTBUFFER_CreateSlice shall increment the reference count of the const buffer that owns the memory (handle itself, or the owner of handle when handle is a slice); CONSTBUFFER_Destroy of the slice shall release it.]*/
+        CONSTBUFFER_HANDLE_DATA* owner = (handle->owner != NULL) ? handle->owner : handle;
+        INC_REF(CONSTBUFFER_HANDLE_DATA, owner);
+        result->owner = owner;
+        result->alias.buffer = (length == 0) ? NULL : handle->alias.buffer + offset;
+        result->alias.size = length;
+    }
+    return (CONSTBUFFER_HANDLE)result;
+}
+
 CONSTBUFFER_HANDLE CONSTBUFFER_Clone(CONSTBUFFER_HANDLE constbufferHandle)
 {
     if (constbufferHandle == NULL)
@@ -147,7 +242,15 @@ void CONSTBUFFER_Destroy(CONSTBUFFER_HANDLE constbufferHandle)
         {
             /*Codes_SRS_CONSTBUFFER_02_017: [If the refcount reaches zero, then CONSTBUFFER_Destroy shall deallocate all resources used by the CONSTBUFFER_HANDLE.]*/
             CONSTBUFFER_HANDLE_DATA* constbufferHandleData = (CONSTBUFFER_HANDLE_DATA*)constbufferHandle;
-            free((void*)constbufferHandleData->alias.buffer);
+            if (constbufferHandleData->owner != NULL)
+            {
+                /*Codes_SRS_CONSTBUFFER_07_012: [CONSTBUFFER_CreateSlice shall increment the reference count of the const buffer that owns the memory (handle itself, or the owner of handle when handle is a slice); CONSTBUFFER_Destroy of the slice shall release it.]*/
+                CONSTBUFFER_Destroy(constbufferHandleData->owner);
+            }
+            else
+            {
+                free((void*)constbufferHandleData->alias.buffer);
+            }
             free(constbufferHandleData);
         }
     }
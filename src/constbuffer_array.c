@@ -0,0 +1,322 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+//
+// PUT NO INCLUDES BEFORE HERE
+//
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+#include "azure_c_shared_utility/gballoc.h"
+
+#include "azure_c_shared_utility/constbuffer_array.h"
+#include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/refcount.h"
+
+#define CONSTBUFFER_ARRAY_INITIAL_CAPACITY 4
+
+/*the buffers are kept in a ring (items[head], items[(head + 1) % capacity], ...) so that adding/removing at either end is O(1)*/
+typedef struct CONSTBUFFER_ARRAY_HANDLE_DATA_TAG
+{
+    CONSTBUFFER_HANDLE* items;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    size_t totalLength;
+}CONSTBUFFER_ARRAY_HANDLE_DATA;
+
+DEFINE_REFCOUNT_TYPE(CONSTBUFFER_ARRAY_HANDLE_DATA);
+
+static size_t slotOf(const CONSTBUFFER_ARRAY_HANDLE_DATA* array, size_t index)
+{
+    return (array->head + index) % array->capacity;
+}
+
+static int makeRoomForOneMore(CONSTBUFFER_ARRAY_HANDLE_DATA* array)
+{
+    int result;
+    if (array->count < array->capacity)
+    {
+        result = 0;
+    }
+    else if (array->capacity > ((size_t)~(size_t)0) / (2 * sizeof(CONSTBUFFER_HANDLE)))
+    {
+        LogError("too many buffers");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t newCapacity = (array->capacity == 0) ? CONSTBUFFER_ARRAY_INITIAL_CAPACITY : array->capacity * 2;
+        CONSTBUFFER_HANDLE* newItems = (CONSTBUFFER_HANDLE*)malloc(newCapacity * sizeof(CONSTBUFFER_HANDLE));
+        if (newItems == NULL)
+        {
+            LogError("unable to malloc");
+            result = __LINE__;
+        }
+        else
+        {
+            size_t i;
+            /*the ring is unrolled in the new storage*/
+            for (i = 0; i < array->count; i++)
+            {
+                newItems[i] = array->items[slotOf(array, i)];
+            }
+            free(array->items);
+            array->items = newItems;
+            array->capacity = newCapacity;
+            array->head = 0;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static int addBuffer(CONSTBUFFER_ARRAY_HANDLE_DATA* array, CONSTBUFFER_HANDLE constbufferHandle, int atFront)
+{
+    int result;
+    const CONSTBUFFER* content = CONSTBUFFER_GetContent(constbufferHandle);
+    if (content == NULL)
+    {
+        LogError("unable to CONSTBUFFER_GetContent");
+        result = __LINE__;
+    }
+    else if (content->size > ((size_t)~(size_t)0) - array->totalLength)
+    {
+        LogError("total length overflow");
+        result = __LINE__;
+    }
+    else if (makeRoomForOneMore(array) != 0)
+    {
+        LogError("unable to grow the array");
+        result = __LINE__;
+    }
+    else
+    {
+        CONSTBUFFER_HANDLE clone = CONSTBUFFER_Clone(constbufferHandle);
+        if (clone == NULL)
+        {
+            LogError("unable to CONSTBUFFER_Clone");
+            result = __LINE__;
+        }
+        else
+        {
+            if (atFront)
+            {
+                array->head = (array->head + array->capacity - 1) % array->capacity;
+                array->items[array->head] = clone;
+            }
+            else
+            {
+                array->items[slotOf(array, array->count)] = clone;
+            }
+            array->count++;
+            array->totalLength += content->size;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static CONSTBUFFER_HANDLE removeBuffer(CONSTBUFFER_ARRAY_HANDLE_DATA* array, int atFront)
+{
+    CONSTBUFFER_HANDLE result;
+    if (atFront)
+    {
+        result = array->items[array->head];
+        array->head = (array->head + 1) % array->capacity;
+    }
+    else
+    {
+        result = array->items[slotOf(array, array->count - 1)];
+    }
+    array->count--;
+    array->totalLength -= CONSTBUFFER_GetContent(result)->size;
+    return result;
+}
+
+CONSTBUFFER_ARRAY_HANDLE CONSTBUFFER_ARRAY_Create(void)
+{
+    /*Codes_SRS_CONSTBUFFER_ARRAY_07_001: [CONSTBUFFER_ARRAY_Create shall allocate an empty array and return a non-NULL handle to it, with the ref count set to "1".]*/
+    CONSTBUFFER_ARRAY_HANDLE_DATA* result = REFCOUNT_TYPE_CREATE(CONSTBUFFER_ARRAY_HANDLE_DATA);
+    if (result == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_002: [If any error occurs, CONSTBUFFER_ARRAY_Create shall return NULL.]*/
+        LogError("unable to malloc");
+    }
+    else
+    {
+        /*the storage for the buffers is allocated by the first add*/
+        result->items = NULL;
+        result->capacity = 0;
+        result->head = 0;
+        result->count = 0;
+        result->totalLength = 0;
+    }
+    return (CONSTBUFFER_ARRAY_HANDLE)result;
+}
+
+CONSTBUFFER_ARRAY_HANDLE CONSTBUFFER_ARRAY_Clone(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle)
+{
+    if (constbufferArrayHandle == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_003: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_Clone shall fail and return NULL.]*/
+        LogError("invalid arg");
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_004: [Otherwise, CONSTBUFFER_ARRAY_Clone shall increment the reference count and return constbufferArrayHandle.]*/
+        INC_REF(CONSTBUFFER_ARRAY_HANDLE_DATA, constbufferArrayHandle);
+    }
+    return constbufferArrayHandle;
+}
+
+void CONSTBUFFER_ARRAY_Destroy(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle)
+{
+    /*Codes_SRS_CONSTBUFFER_ARRAY_07_005: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_Destroy shall do nothing.]*/
+    if (constbufferArrayHandle != NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_006: [Otherwise, CONSTBUFFER_ARRAY_Destroy shall decrement the reference count.]*/
+        if (DEC_REF(CONSTBUFFER_ARRAY_HANDLE_DATA, constbufferArrayHandle) == DEC_RETURN_ZERO)
+        {
+            /*Codes_SRS_CONSTBUFFER_ARRAY_07_007: [If the reference count reaches zero, CONSTBUFFER_ARRAY_Destroy shall release the reference it holds on every buffer (with CONSTBUFFER_Destroy) and free the array.]*/
+            CONSTBUFFER_ARRAY_HANDLE_DATA* array = (CONSTBUFFER_ARRAY_HANDLE_DATA*)constbufferArrayHandle;
+            size_t i;
+            for (i = 0; i < array->count; i++)
+            {
+                CONSTBUFFER_Destroy(array->items[slotOf(array, i)]);
+            }
+            free(array->items);
+            free(array);
+        }
+    }
+}
+
+int CONSTBUFFER_ARRAY_AddFront(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle, CONSTBUFFER_HANDLE constbufferHandle)
+{
+    int result;
+    if ((constbufferArrayHandle == NULL) || (constbufferHandle == NULL))
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_008: [If constbufferArrayHandle or constbufferHandle is NULL then CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail and return a non-zero value.]*/
+        LogError("invalid arg: constbufferArrayHandle = %p, constbufferHandle = %p", constbufferArrayHandle, constbufferHandle);
+        result = __LINE__;
+    }
+    /*Codes_SRS_CONSTBUFFER_ARRAY_07_009: [CONSTBUFFER_ARRAY_AddFront shall insert constbufferHandle before the first buffer of the array, taking a reference on it with CONSTBUFFER_Clone, and return 0.]*/
+    else if (addBuffer(constbufferArrayHandle, constbufferHandle, 1) != 0)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_011: [If any error occurs, CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail, leave the array unchanged and return a non-zero value.]*/
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+int CONSTBUFFER_ARRAY_AddBack(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle, CONSTBUFFER_HANDLE constbufferHandle)
+{
+    int result;
+    if ((constbufferArrayHandle == NULL) || (constbufferHandle == NULL))
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_008: [If constbufferArrayHandle or constbufferHandle is NULL then CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail and return a non-zero value.]*/
+        LogError("invalid arg: constbufferArrayHandle = %p, constbufferHandle = %p", constbufferArrayHandle, constbufferHandle);
+        result = __LINE__;
+    }
+    /*Codes_SRS_CONSTBUFFER_ARRAY_07_010: [CONSTBUFFER_ARRAY_AddBack shall insert constbufferHandle after the last buffer of the array, taking a reference on it with CONSTBUFFER_Clone, and return 0.]*/
+    else if (addBuffer(constbufferArrayHandle, constbufferHandle, 0) != 0)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_011: [If any error occurs, CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail, leave the array unchanged and return a non-zero value.]*/
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_ARRAY_RemoveFront(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle)
+{
+    CONSTBUFFER_HANDLE result;
+    if ((constbufferArrayHandle == NULL) || (constbufferArrayHandle->count == 0))
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_012: [If constbufferArrayHandle is NULL or the array is empty then CONSTBUFFER_ARRAY_RemoveFront and CONSTBUFFER_ARRAY_RemoveBack shall return NULL.]*/
+        LogError("invalid arg: constbufferArrayHandle = %p is NULL or empty", constbufferArrayHandle);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_013: [CONSTBUFFER_ARRAY_RemoveFront shall remove the first buffer of the array and return it; the reference the array held on it passes to the caller.]*/
+        result = removeBuffer(constbufferArrayHandle, 1);
+    }
+    return result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_ARRAY_RemoveBack(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle)
+{
+    CONSTBUFFER_HANDLE result;
+    if ((constbufferArrayHandle == NULL) || (constbufferArrayHandle->count == 0))
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_012: [If constbufferArrayHandle is NULL or the array is empty then CONSTBUFFER_ARRAY_RemoveFront and CONSTBUFFER_ARRAY_RemoveBack shall return NULL.]*/
+        LogError("invalid arg: constbufferArrayHandle = %p is NULL or empty", constbufferArrayHandle);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_014: [CONSTBUFFER_ARRAY_RemoveBack shall remove the last buffer of the array and return it; the reference the array held on it passes to the caller.]*/
+        result = removeBuffer(constbufferArrayHandle, 0);
+    }
+    return result;
+}
+
+size_t CONSTBUFFER_ARRAY_GetCount(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle)
+{
+    size_t result;
+    if (constbufferArrayHandle == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_015: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_GetCount and CONSTBUFFER_ARRAY_GetTotalLength shall return 0.]*/
+        LogError("invalid arg");
+        result = 0;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_016: [CONSTBUFFER_ARRAY_GetCount shall return the number of buffers in the array.]*/
+        result = constbufferArrayHandle->count;
+    }
+    return result;
+}
+
+size_t CONSTBUFFER_ARRAY_GetTotalLength(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle)
+{
+    size_t result;
+    if (constbufferArrayHandle == NULL)
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_015: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_GetCount and CONSTBUFFER_ARRAY_GetTotalLength shall return 0.]*/
+        LogError("invalid arg");
+        result = 0;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_017: [CONSTBUFFER_ARRAY_GetTotalLength shall return the sum of the sizes of all the buffers in the array, without walking the buffers.]*/
+        result = constbufferArrayHandle->totalLength;
+    }
+    return result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_ARRAY_GetBuffer(CONSTBUFFER_ARRAY_HANDLE constbufferArrayHandle, size_t index)
+{
+    CONSTBUFFER_HANDLE result;
+    if ((constbufferArrayHandle == NULL) || (index >= constbufferArrayHandle->count))
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_018: [If constbufferArrayHandle is NULL or index is not smaller than the number of buffers then CONSTBUFFER_ARRAY_GetBuffer shall return NULL.]*/
+        LogError("invalid arg: constbufferArrayHandle = %p, index = %lu", constbufferArrayHandle, (unsigned long)index);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_ARRAY_07_019: [Otherwise CONSTBUFFER_ARRAY_GetBuffer shall return the buffer at index (0 being the front of the array), without taking a reference on it.]*/
+        result = constbufferArrayHandle->items[slotOf(constbufferArrayHandle, index)];
+    }
+    return result;
+}
@@ -140,6 +140,7 @@ bool ConstMap_ContainsKey(CONSTMAP_HANDLE handle, const char* key )
 		}
 		else
 		{
+			/*Codes_SRS_CONSTMAP_07_002: [ConstMap_ContainsKey and ConstMap_GetValue shall find key through the lookups of the cloned map, which only read it.]*/
 			/*Codes_SRS_CONSTMAP_17_025: [Otherwise if a key exists then ConstMap_ContainsKey shall return true.]*/
 			MAP_RESULT mapResult = Map_ContainsKey(((CONSTMAP_HANDLE_DATA *)handle)->map, key, &keyExists);
 			if (mapResult != MAP_OK)
@@ -199,6 +200,7 @@ const char* ConstMap_GetValue(CONSTMAP_HANDLE handle, const char* key)
 		}
 		else
 		{
+			/*Codes_SRS_CONSTMAP_07_002: [ConstMap_ContainsKey and ConstMap_GetValue shall find key through the lookups of the cloned map, which only read it.]*/
 			/*Codes_SRS_CONSTMAP_17_041: [If the key is not found, then ConstMap_GetValue returns NULL.]*/
 			/*Codes_SRS_CONSTMAP_17_042: [Otherwise, ConstMap_GetValue returns the key's value.]*/
 			value = Map_GetValueFromKey(((CONSTMAP_HANDLE_DATA *)handle)->map, key);
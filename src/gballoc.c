@@ -6,19 +6,37 @@
 #include <crtdbg.h>
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include "azure_c_shared_utility/lock.h"
 #include "azure_c_shared_utility/xlogging.h"
-#include <stdint.h>
+
+/* this file implements the GB_DEBUG_ALLOC flavor of the API and must never have its own allocations redirected to gballoc */
+#undef GB_MEASURE_MEMORY_FOR_THIS
+#ifndef GB_DEBUG_ALLOC
+#define GB_DEBUG_ALLOC
+#endif
+#include "azure_c_shared_utility/gballoc.h"
 
 #ifndef SIZE_MAX
 #define SIZE_MAX ((size_t)~(size_t)0)
 #endif
 
+/* the pooled allocator relies on the block header of the sharded accounting mode to find the size class of a block being freed */
+#if defined(GB_POOLED_ALLOCATIONS) && !defined(GB_SHARDED_ACCOUNTING)
+#define GB_SHARDED_ACCOUNTING
+#endif
+
+#if !defined(GB_SHARDED_ACCOUNTING)
+
 typedef struct ALLOCATION_TAG
 {
     size_t size;
     void* ptr;
     void* next;
+    GBALLOC_ALLOCATION_SITE* site;
+    size_t siteGeneration;
 } ALLOCATION;
 
 typedef enum GBALLOC_STATE_TAG
@@ -27,13 +45,185 @@ typedef enum GBALLOC_STATE_TAG
     GBALLOC_STATE_NOT_INIT
 } GBALLOC_STATE;
 
-static ALLOCATION* head = NULL;
+/* the tracked allocations are kept in a hash index keyed by the block address so that free/realloc do not have to walk all the live allocations */
+/* the index starts on a static bucket array (no allocation needed for it) and doubles whenever the average chain length exceeds GBALLOC_MAX_LOAD_FACTOR */
+/* GBALLOC_INITIAL_BUCKET_COUNT has to be a power of 2 */
+#define GBALLOC_INITIAL_BUCKET_COUNT 256
+#define GBALLOC_MAX_LOAD_FACTOR 2
+
+static ALLOCATION* initialBuckets[GBALLOC_INITIAL_BUCKET_COUNT];
+static ALLOCATION** buckets = initialBuckets;
+static size_t bucketCount = GBALLOC_INITIAL_BUCKET_COUNT;
+static size_t allocationCount = 0;
 static size_t totalSize = 0;
 static size_t maxSize = 0;
 static GBALLOC_STATE gballocState = GBALLOC_STATE_NOT_INIT;
 
 static LOCK_HANDLE gballocThreadSafeLock = NULL;
 
+/* allocation sites (file/line of the gballoc_xxx_at callers) are aggregated in an open addressing table that is only allocated when the first site is recorded */
+/* once the table is full (or cannot be allocated) the remaining sites are aggregated in otherAllocationSites so that the totals stay right */
+/* gballoc_deinit drops the table; blocks that outlive it keep a stale site pointer that siteGeneration tells apart */
+/* GBALLOC_MAX_ALLOCATION_SITES has to be a power of 2 */
+#define GBALLOC_MAX_ALLOCATION_SITES 1024
+
+static GBALLOC_ALLOCATION_SITE* allocationSites = NULL;
+static GBALLOC_ALLOCATION_SITE otherAllocationSites = { "<other>", 0, 0, 0, 0, 0 };
+static size_t siteGeneration = 0;
+
+static size_t getBucketIndex(const void* ptr, size_t count)
+{
+    /* the low bits of a heap address carry no information (alignment), so they are dropped before mixing */
+    size_t key = (size_t)((uintptr_t)ptr >> 3);
+    key ^= key >> 15;
+    key *= (size_t)0x9E3779B1;
+    key ^= key >> 13;
+    return key & (count - 1);
+}
+
+/* returns the link that points to the ALLOCATION tracking ptr, or the terminating NULL link of the bucket if ptr is not tracked */
+static ALLOCATION** findAllocationLink(const void* ptr)
+{
+    ALLOCATION** link = &buckets[getBucketIndex(ptr, bucketCount)];
+    while ((*link != NULL) && ((*link)->ptr != ptr))
+    {
+        link = (ALLOCATION**)&(*link)->next;
+    }
+    return link;
+}
+
+static void growBuckets(void)
+{
+    size_t newBucketCount = bucketCount * 2;
+    ALLOCATION** newBuckets;
+
+    if ((newBucketCount < bucketCount) ||
+        ((newBuckets = (ALLOCATION**)calloc(newBucketCount, sizeof(ALLOCATION*))) == NULL))
+    {
+        /* not growing only makes the chains longer, tracking stays correct */
+        LogError("Failed to grow the allocation index.");
+    }
+    else
+    {
+        size_t i;
+        for (i = 0; i < bucketCount; i++)
+        {
+            ALLOCATION* curr = buckets[i];
+            while (curr != NULL)
+            {
+                ALLOCATION* next = (ALLOCATION*)curr->next;
+                size_t newIndex = getBucketIndex(curr->ptr, newBucketCount);
+                curr->next = newBuckets[newIndex];
+                newBuckets[newIndex] = curr;
+                curr = next;
+            }
+        }
+
+        if (buckets != initialBuckets)
+        {
+            free(buckets);
+        }
+
+        buckets = newBuckets;
+        bucketCount = newBucketCount;
+    }
+}
+
+/* returns the aggregate for file/line or NULL if the allocation is not attributed to a site */
+static GBALLOC_ALLOCATION_SITE* getAllocationSite(const char* file, int line)
+{
+    GBALLOC_ALLOCATION_SITE* result;
+
+    if (file == NULL)
+    {
+        result = NULL;
+    }
+    else if ((allocationSites == NULL) &&
+        ((allocationSites = (GBALLOC_ALLOCATION_SITE*)calloc(GBALLOC_MAX_ALLOCATION_SITES, sizeof(GBALLOC_ALLOCATION_SITE))) == NULL))
+    {
+        result = &otherAllocationSites;
+    }
+    else
+    {
+        /* __FILE__ literals are not guaranteed to be merged, so the pointer is only a shortcut and the names are compared otherwise */
+        size_t index = (getBucketIndex(file, GBALLOC_MAX_ALLOCATION_SITES) + (size_t)line * 31) & (GBALLOC_MAX_ALLOCATION_SITES - 1);
+        size_t probeCount;
+
+        result = &otherAllocationSites;
+        for (probeCount = 0; probeCount < GBALLOC_MAX_ALLOCATION_SITES; probeCount++)
+        {
+            GBALLOC_ALLOCATION_SITE* site = &allocationSites[index];
+            if (site->file == NULL)
+            {
+                site->file = file;
+                site->line = line;
+                result = site;
+                break;
+            }
+            else if ((site->line == line) && ((site->file == file) || (strcmp(site->file, file) == 0)))
+            {
+                result = site;
+                break;
+            }
+
+            index = (index + 1) & (GBALLOC_MAX_ALLOCATION_SITES - 1);
+        }
+    }
+
+    return result;
+}
+
+static GBALLOC_ALLOCATION_SITE* getCurrentAllocationSite(const ALLOCATION* allocation)
+{
+    return (allocation->siteGeneration == siteGeneration) ? allocation->site : NULL;
+}
+
+static void attachAllocationSite(ALLOCATION* allocation, const char* file, int line)
+{
+    GBALLOC_ALLOCATION_SITE* site = getAllocationSite(file, line);
+    allocation->site = site;
+    allocation->siteGeneration = siteGeneration;
+    if (site != NULL)
+    {
+        site->liveBytes += allocation->size;
+        site->liveCount++;
+        site->allocationCount++;
+        site->allocatedBytes += allocation->size;
+    }
+}
+
+static void detachAllocationSite(ALLOCATION* allocation)
+{
+    GBALLOC_ALLOCATION_SITE* site = getCurrentAllocationSite(allocation);
+    if (site != NULL)
+    {
+        site->liveBytes -= allocation->size;
+        site->liveCount--;
+    }
+}
+
+static void resizeOnAllocationSite(ALLOCATION* allocation, size_t size)
+{
+    GBALLOC_ALLOCATION_SITE* site = getCurrentAllocationSite(allocation);
+    if (site != NULL)
+    {
+        site->liveBytes = site->liveBytes - allocation->size + size;
+    }
+}
+
+static void addAllocation(ALLOCATION* allocation)
+{
+    size_t index = getBucketIndex(allocation->ptr, bucketCount);
+    allocation->next = buckets[index];
+    buckets[index] = allocation;
+    allocationCount++;
+
+    if (allocationCount > bucketCount * GBALLOC_MAX_LOAD_FACTOR)
+    {
+        growBuckets();
+    }
+}
+
 int gballoc_init(void)
 {
     int result;
@@ -70,12 +260,35 @@ void gballoc_deinit(void)
     {
         /* Codes_SRS_GBALLOC_01_028: [gballoc_deinit shall free all resources allocated by gballoc_init.] */
         (void)Lock_Deinit(gballocThreadSafeLock);
+
+        /* a grown index is only dropped when nothing is tracked anymore, otherwise the outstanding blocks could not be freed after a new init */
+        if ((allocationCount == 0) && (buckets != initialBuckets))
+        {
+            free(buckets);
+            buckets = initialBuckets;
+            bucketCount = GBALLOC_INITIAL_BUCKET_COUNT;
+        }
+
+        /* the allocation sites are dropped, the blocks that are still tracked stop being attributed to a site */
+        if ((allocationSites != NULL) || (otherAllocationSites.allocationCount > 0))
+        {
+            if (allocationSites != NULL)
+            {
+                free(allocationSites);
+                allocationSites = NULL;
+            }
+            siteGeneration++;
+            otherAllocationSites.liveBytes = 0;
+            otherAllocationSites.liveCount = 0;
+            otherAllocationSites.allocationCount = 0;
+            otherAllocationSites.allocatedBytes = 0;
+        }
     }
 
     gballocState = GBALLOC_STATE_NOT_INIT;
 }
 
-void* gballoc_malloc(size_t size)
+static void* trackedMalloc(size_t size, const char* file, int line)
 {
     void* result;
 
@@ -112,8 +325,9 @@ void* gballoc_malloc(size_t size)
             /* Codes_SRS_GBALLOC_01_004: [If the underlying malloc call is successful, gb_malloc shall increment the total memory used with the amount indicated by size.] */
             allocation->ptr = result;
             allocation->size = size;
-            allocation->next = head;
-            head = allocation;
+            /* Codes_SRS_GBALLOC_07_020: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall attribute a successful allocation to the site identified by file and line by increasing the live bytes, live count, allocation count and allocated bytes of the site.] */
+            attachAllocationSite(allocation, file, line);
+            addAllocation(allocation);
 
             totalSize += size;
             /* Codes_SRS_GBALLOC_01_011: [The maximum total memory used shall be the maximum of the total memory used at any point.] */
@@ -130,7 +344,18 @@ void* gballoc_malloc(size_t size)
     return result;
 }
 
-void* gballoc_calloc(size_t nmemb, size_t size)
+void* gballoc_malloc(size_t size)
+{
+    return trackedMalloc(size, NULL, 0);
+}
+
+void* gballoc_malloc_at(size_t size, const char* file, int line)
+{
+    /* Codes_SRS_GBALLOC_07_019: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc.] */
+    return trackedMalloc(size, file, line);
+}
+
+static void* trackedCalloc(size_t nmemb, size_t size, const char* file, int line)
 {
     void* result;
 
@@ -167,8 +392,9 @@ void* gballoc_calloc(size_t nmemb, size_t size)
             /* Codes_SRS_GBALLOC_01_021: [If the underlying calloc call is successful, gballoc_calloc shall increment the total memory used with nmemb*size.] */
             allocation->ptr = result;
             allocation->size = nmemb * size;
-            allocation->next = head;
-            head = allocation;
+            /* Codes_SRS_GBALLOC_07_020: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall attribute a successful allocation to the site identified by file and line by increasing the live bytes, live count, allocation count and allocated bytes of the site.] */
+            attachAllocationSite(allocation, file, line);
+            addAllocation(allocation);
 
             totalSize += allocation->size;
             /* Codes_SRS_GBALLOC_01_011: [The maximum total memory used shall be the maximum of the total memory used at any point.] */
@@ -185,9 +411,20 @@ void* gballoc_calloc(size_t nmemb, size_t size)
     return result;
 }
 
-void* gballoc_realloc(void* ptr, size_t size)
+void* gballoc_calloc(size_t nmemb, size_t size)
 {
-    ALLOCATION* curr;
+    return trackedCalloc(nmemb, size, NULL, 0);
+}
+
+void* gballoc_calloc_at(size_t nmemb, size_t size, const char* file, int line)
+{
+    /* Codes_SRS_GBALLOC_07_019: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc.] */
+    return trackedCalloc(nmemb, size, file, line);
+}
+
+static void* trackedRealloc(void* ptr, size_t size, const char* file, int line)
+{
+    ALLOCATION** link = NULL;
     void* result;
     ALLOCATION* allocation = NULL;
 
@@ -212,19 +449,8 @@ void* gballoc_realloc(void* ptr, size_t size)
     }
     else
     {
-        curr = head;
-        while (curr != NULL)
-        {
-            if (curr->ptr == ptr)
-            {
-                allocation = curr;
-                break;
-            }
-            else
-            {
-                curr = (ALLOCATION*)curr->next;
-            }
-        }
+        link = findAllocationLink(ptr);
+        allocation = *link;
     }
 
     if (allocation == NULL)
@@ -249,17 +475,35 @@ void* gballoc_realloc(void* ptr, size_t size)
             if (ptr != NULL)
             {
                 /* Codes_SRS_GBALLOC_01_006: [If the underlying realloc call is successful, gballoc_realloc shall look up the size associated with the pointer ptr and decrease the total memory used with that size.] */
-                allocation->ptr = result;
                 totalSize -= allocation->size;
-                allocation->size = size;
+                /* Codes_SRS_GBALLOC_07_021: [gballoc_realloc_at shall attribute the block to the site of the gballoc_realloc_at call, while gballoc_realloc shall leave the block attributed to its current site.] */
+                if (file != NULL)
+                {
+                    detachAllocationSite(allocation);
+                    allocation->size = size;
+                    attachAllocationSite(allocation, file, line);
+                }
+                else
+                {
+                    resizeOnAllocationSite(allocation, size);
+                    allocation->size = size;
+                }
+                if (result != ptr)
+                {
+                    /* Codes_SRS_GBALLOC_07_001: [If the underlying realloc returns a different pointer than ptr, gballoc_realloc shall track the size under the new pointer so that it can be found by subsequent gballoc_realloc and gballoc_free calls.] */
+                    *link = (ALLOCATION*)allocation->next;
+                    allocationCount--;
+                    allocation->ptr = result;
+                    addAllocation(allocation);
+                }
             }
             else
             {
                 /* add block */
                 allocation->ptr = result;
                 allocation->size = size;
-                allocation->next = head;
-                head = allocation;
+                attachAllocationSite(allocation, file, line);
+                addAllocation(allocation);
             }
 
             /* Codes_SRS_GBALLOC_01_007: [If realloc is successful, gballoc_realloc shall also increment the total memory used value tracked by this module.] */
@@ -279,10 +523,21 @@ void* gballoc_realloc(void* ptr, size_t size)
     return result;
 }
 
+void* gballoc_realloc(void* ptr, size_t size)
+{
+    return trackedRealloc(ptr, size, NULL, 0);
+}
+
+void* gballoc_realloc_at(void* ptr, size_t size, const char* file, int line)
+{
+    /* Codes_SRS_GBALLOC_07_019: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc.] */
+    return trackedRealloc(ptr, size, file, line);
+}
+
 void gballoc_free(void* ptr)
 {
-    ALLOCATION* curr = head;
-    ALLOCATION* prev = NULL;
+    ALLOCATION** link;
+    ALLOCATION* curr;
 
     if (gballocState != GBALLOC_STATE_INIT)
     {
@@ -297,38 +552,28 @@ void gballoc_free(void* ptr)
     }
     else
     {
-    /* Codes_SRS_GBALLOC_01_009: [gballoc_free shall also look up the size associated with the ptr pointer and decrease the total memory used with the associated size amount.] */
-    while (curr != NULL)
-    {
-        if (curr->ptr == ptr)
+        /* Codes_SRS_GBALLOC_01_009: [gballoc_free shall also look up the size associated with the ptr pointer and decrease the total memory used with the associated size amount.] */
+        link = findAllocationLink(ptr);
+        curr = *link;
+        if (curr != NULL)
         {
             /* Codes_SRS_GBALLOC_01_008: [gballoc_free shall call the C99 free function.] */
             free(ptr);
             totalSize -= curr->size;
-            if (prev != NULL)
-            {
-                prev->next = curr->next;
-            }
-            else
-            {
-                head = (ALLOCATION*)curr->next;
-            }
+            /* Codes_SRS_GBALLOC_07_022: [gballoc_free shall decrease the live bytes and live count of the site the block is attributed to.] */
+            detachAllocationSite(curr);
+            *link = (ALLOCATION*)curr->next;
+            allocationCount--;
 
             free(curr);
-            break;
         }
+        else if (ptr != NULL)
+        {
+            /* Codes_SRS_GBALLOC_01_019: [When the ptr pointer cannot be found in the pointers tracked by gballoc, gballoc_free shall not free any memory.] */
 
-        prev = curr;
-        curr = (ALLOCATION*)curr->next;
-    }
-
-        if ((curr == NULL) && (ptr != NULL))
-    {
-        /* Codes_SRS_GBALLOC_01_019: [When the ptr pointer cannot be found in the pointers tracked by gballoc, gballoc_free shall not free any memory.] */
-
-        /* could not find the allocation */
-        LogError("Could not free allocation for address %p (not found)", ptr);
-    }
+            /* could not find the allocation */
+            LogError("Could not free allocation for address %p (not found)", ptr);
+        }
         (void)Unlock(gballocThreadSafeLock);
     }
 }
@@ -386,3 +631,885 @@ size_t gballoc_getCurrentMemoryUsed(void)
 
     return result;
 }
+
+/* inserts candidate in sites[0..*count), which is kept sorted by decreasing live bytes, dropping the last entry when the array is full */
+static void insertTopAllocationSite(GBALLOC_ALLOCATION_SITE* sites, size_t maxSites, size_t* count, const GBALLOC_ALLOCATION_SITE* candidate)
+{
+    size_t position = *count;
+
+    if ((position < maxSites) || (sites[maxSites - 1].liveBytes < candidate->liveBytes))
+    {
+        if (position == maxSites)
+        {
+            position--;
+        }
+        else
+        {
+            (*count)++;
+        }
+
+        while ((position > 0) && (sites[position - 1].liveBytes < candidate->liveBytes))
+        {
+            sites[position] = sites[position - 1];
+            position--;
+        }
+
+        sites[position] = *candidate;
+    }
+}
+
+size_t gballoc_getAllocationSites(GBALLOC_ALLOCATION_SITE* sites, size_t maxSites)
+{
+    size_t result;
+
+    if ((sites == NULL) && (maxSites > 0))
+    {
+        /* Codes_SRS_GBALLOC_07_025: [If sites is NULL and maxSites is not 0, gballoc_getAllocationSites shall return 0.] */
+        LogError("Invalid arguments: GBALLOC_ALLOCATION_SITE* sites = %p, size_t maxSites = %lu", sites, (unsigned long)maxSites);
+        result = 0;
+    }
+    else if (gballocState != GBALLOC_STATE_INIT)
+    {
+        /* Codes_SRS_GBALLOC_07_026: [If gballoc was not initialized gballoc_getAllocationSites shall return 0.] */
+        LogError("gballoc is not initialized.");
+        result = 0;
+    }
+    /* Codes_SRS_GBALLOC_07_024: [gballoc_getAllocationSites shall ensure thread safety by using the lock created by gballoc_Init.] */
+    else if (LOCK_OK != Lock(gballocThreadSafeLock))
+    {
+        /* Codes_SRS_GBALLOC_07_027: [If the lock cannot be acquired, gballoc_getAllocationSites shall return 0.] */
+        LogError("Failed to get the Lock.");
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_023: [gballoc_getAllocationSites shall copy to sites the (up to) maxSites sites with the most live bytes, sorted by decreasing live bytes, and return the number of sites copied.] */
+        size_t i;
+        result = 0;
+        if (maxSites > 0)
+        {
+            if (allocationSites != NULL)
+            {
+                for (i = 0; i < GBALLOC_MAX_ALLOCATION_SITES; i++)
+                {
+                    if (allocationSites[i].file != NULL)
+                    {
+                        insertTopAllocationSite(sites, maxSites, &result, &allocationSites[i]);
+                    }
+                }
+            }
+
+            if (otherAllocationSites.allocationCount > 0)
+            {
+                insertTopAllocationSite(sites, maxSites, &result, &otherAllocationSites);
+            }
+        }
+
+        (void)Unlock(gballocThreadSafeLock);
+    }
+
+    return result;
+}
+
+size_t gballoc_getPoolRequestCount(void)
+{
+    /* Codes_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+    return SIZE_MAX;
+}
+
+size_t gballoc_getPoolHitCount(void)
+{
+    /* Codes_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+    return SIZE_MAX;
+}
+
+#else /* GB_SHARDED_ACCOUNTING */
+
+/* in sharded accounting mode the size of every block is kept in a header placed in front of the block handed out to the caller and the */
+/* memory counters are spread over GBALLOC_SHARD_COUNT cache line sized shards that are only touched with atomic operations. */
+/* Each thread is assigned a shard the first time it allocates, so no lock is taken on the allocation/free paths. */
+/* The header also records the shard that accounted for the block so that a free on another thread decrements the same shard. */
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#ifdef _WIN64
+#define GBALLOC_ATOMIC_ADD(var, value) ((size_t)InterlockedExchangeAdd64((volatile LONG64*)(var), (LONG64)(value)))
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) ((size_t)InterlockedCompareExchange64((volatile LONG64*)(var), (LONG64)(desired), (LONG64)(expected)) == (expected))
+#else
+#define GBALLOC_ATOMIC_ADD(var, value) ((size_t)InterlockedExchangeAdd((volatile LONG*)(var), (LONG)(value)))
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) ((size_t)InterlockedCompareExchange((volatile LONG*)(var), (LONG)(desired), (LONG)(expected)) == (expected))
+#endif
+#define GBALLOC_ATOMIC_LOAD(var) (*(volatile size_t*)(var))
+#define GBALLOC_SPIN_LOCK(var) while (InterlockedExchange((volatile LONG*)(var), 1) != 0) {}
+#define GBALLOC_SPIN_UNLOCK(var) (void)InterlockedExchange((volatile LONG*)(var), 0)
+#define GBALLOC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define GBALLOC_ATOMIC_ADD(var, value) __atomic_fetch_add((var), (value), __ATOMIC_RELAXED)
+#define GBALLOC_ATOMIC_CAS(var, expected, desired) __atomic_compare_exchange_n((var), &(expected), (desired), 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define GBALLOC_ATOMIC_LOAD(var) __atomic_load_n((var), __ATOMIC_RELAXED)
+#define GBALLOC_SPIN_LOCK(var) while (__atomic_exchange_n((var), 1, __ATOMIC_ACQUIRE) != 0) {}
+#define GBALLOC_SPIN_UNLOCK(var) __atomic_store_n((var), 0, __ATOMIC_RELEASE)
+#define GBALLOC_THREAD_LOCAL __thread
+#else
+#error do not know how to atomically add to a size_t :(. Platform support needs to be extended to your platform or GB_SHARDED_ACCOUNTING needs to be turned off.
+#endif
+
+/* GBALLOC_SHARD_COUNT has to be a power of 2 and smaller than 256 (the shard index is stored in the low byte of the block tag) */
+#define GBALLOC_SHARD_COUNT 16
+#define GBALLOC_CACHE_LINE_SIZE 64
+
+#define GBALLOC_TAG_MAGIC ((uint32_t)0x6BA10000)
+#define GBALLOC_TAG_MAGIC_MASK ((uint32_t)0xFFFF0000)
+#define GBALLOC_TAG_SHARD(tag) ((size_t)(tag) & 0xFF)
+#define GBALLOC_TAG_POOLED ((uint32_t)0x8000)
+#define GBALLOC_UNTRACKED_SHARD 0xFF
+
+typedef union GBALLOC_SHARD_TAG
+{
+    struct
+    {
+        size_t totalSize;
+        size_t maxSize;
+        size_t poolRequestCount;
+        size_t poolHitCount;
+    } counters;
+    unsigned char cacheLine[GBALLOC_CACHE_LINE_SIZE];
+} GBALLOC_SHARD;
+
+/* the union makes the header as aligned as anything malloc can return, so the caller's block keeps malloc's alignment guarantees */
+/* size and the two 32 bit fields still fit the 16 bytes of the header on 64 bit platforms */
+typedef union BLOCK_HEADER_TAG
+{
+    struct
+    {
+        size_t size;
+        /* the gballoc_init the block was accounted under, 32 bits wrap only after 4 billion init/deinit cycles */
+        uint32_t generation;
+        /* GBALLOC_TAG_MAGIC | GBALLOC_TAG_POOLED | shard index */
+        uint32_t tag;
+    } info;
+    long double alignLongDouble;
+    long long alignLongLong;
+    void* alignPointer;
+    unsigned char alignBytes[16];
+} BLOCK_HEADER;
+
+typedef enum GBALLOC_STATE_TAG
+{
+    GBALLOC_STATE_INIT,
+    GBALLOC_STATE_NOT_INIT
+} GBALLOC_STATE;
+
+static GBALLOC_SHARD shards[GBALLOC_SHARD_COUNT];
+static volatile GBALLOC_STATE gballocState = GBALLOC_STATE_NOT_INIT;
+/* the generation changes with every gballoc_init so that blocks accounted before a deinit are not subtracted from the new counters */
+static uint32_t generation = 0;
+static size_t nextShard = 0;
+static GBALLOC_THREAD_LOCAL size_t threadShard = 0; /* 0 means no shard has been assigned to this thread yet, otherwise it is shard index + 1 */
+
+static size_t getThreadShard(void)
+{
+    if (threadShard == 0)
+    {
+        threadShard = (GBALLOC_ATOMIC_ADD(&nextShard, 1) & (GBALLOC_SHARD_COUNT - 1)) + 1;
+    }
+
+    return threadShard - 1;
+}
+
+static void writeTag(BLOCK_HEADER* header, uint32_t pooledFlag)
+{
+    size_t shardIndex = (gballocState == GBALLOC_STATE_INIT) ? getThreadShard() : GBALLOC_UNTRACKED_SHARD;
+    header->info.generation = generation;
+    header->info.tag = GBALLOC_TAG_MAGIC | pooledFlag | (uint32_t)shardIndex;
+}
+
+static GBALLOC_SHARD* getAccountingShard(const BLOCK_HEADER* header)
+{
+    GBALLOC_SHARD* result;
+
+    /* Codes_SRS_GBALLOC_07_033: [When GB_SHARDED_ACCOUNTING is defined gballoc_free and gballoc_realloc shall only change the counters for blocks that were counted since the last gballoc_init.] */
+    if ((gballocState != GBALLOC_STATE_INIT) ||
+        (GBALLOC_TAG_SHARD(header->info.tag) == GBALLOC_UNTRACKED_SHARD) ||
+        (header->info.generation != generation))
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = &shards[GBALLOC_TAG_SHARD(header->info.tag)];
+    }
+
+    return result;
+}
+
+static void accountAllocation(GBALLOC_SHARD* shard, size_t size)
+{
+    size_t newTotal = GBALLOC_ATOMIC_ADD(&shard->counters.totalSize, size) + size;
+    size_t currentMax = GBALLOC_ATOMIC_LOAD(&shard->counters.maxSize);
+
+    /* several threads can share a shard, so the peak has to be raised with a compare and swap */
+    while ((currentMax < newTotal) &&
+        !GBALLOC_ATOMIC_CAS(&shard->counters.maxSize, currentMax, newTotal))
+    {
+        currentMax = GBALLOC_ATOMIC_LOAD(&shard->counters.maxSize);
+    }
+}
+
+static void accountFree(GBALLOC_SHARD* shard, size_t size)
+{
+    (void)GBALLOC_ATOMIC_ADD(&shard->counters.totalSize, (size_t)0 - size);
+}
+
+#if defined(GB_POOLED_ALLOCATIONS)
+
+/* small blocks are served from per size class slabs. A slab is one underlying malloc carved into GBALLOC_POOL_SLAB_SIZE / block size blocks. */
+/* Free blocks are kept first in a per thread cache (no synchronization at all) and then in a per size class list protected by a spin lock. */
+/* Slabs are never given back to the underlying allocator, the blocks in them are reused for the lifetime of the process. */
+/* When a thread exits, a thread exit callback gives the blocks left in its cache back to the shared lists, so that they are not lost. */
+
+#if defined(_MSC_VER)
+typedef DWORD GBALLOC_THREAD_EXIT_KEY;
+#define GBALLOC_THREAD_EXIT_CALLBACK(name) static void WINAPI name(PVOID value)
+#define GBALLOC_CREATE_THREAD_EXIT_KEY(key, callback) (((*(key) = FlsAlloc(callback)) == FLS_OUT_OF_INDEXES) ? __LINE__ : 0)
+#define GBALLOC_ARM_THREAD_EXIT_KEY(key) (FlsSetValue((key), (PVOID)1) ? 0 : __LINE__)
+#else
+#include <pthread.h>
+typedef pthread_key_t GBALLOC_THREAD_EXIT_KEY;
+#define GBALLOC_THREAD_EXIT_CALLBACK(name) static void name(void* value)
+#define GBALLOC_CREATE_THREAD_EXIT_KEY(key, callback) pthread_key_create((key), (callback))
+#define GBALLOC_ARM_THREAD_EXIT_KEY(key) pthread_setspecific((key), (void*)1)
+#endif
+
+#define GBALLOC_POOL_GRANULE 16
+#define GBALLOC_POOL_MAX_SIZE 256
+#define GBALLOC_POOL_CLASS_COUNT 8
+#define GBALLOC_POOL_SLAB_SIZE 16384
+#define GBALLOC_POOL_THREAD_CACHE_SIZE 64
+#define GBALLOC_POOL_TRANSFER_COUNT 32
+
+typedef struct POOL_FREE_BLOCK_TAG
+{
+    struct POOL_FREE_BLOCK_TAG* next;
+} POOL_FREE_BLOCK;
+
+typedef struct POOL_SIZE_CLASS_TAG
+{
+    size_t spinLock;
+    POOL_FREE_BLOCK* freeList;
+} POOL_SIZE_CLASS;
+
+static const size_t poolClassSizes[GBALLOC_POOL_CLASS_COUNT] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+/* size class index indexed by the number of GBALLOC_POOL_GRANULE needed for a size */
+static const unsigned char poolClassByGranules[GBALLOC_POOL_MAX_SIZE / GBALLOC_POOL_GRANULE + 1] = { 0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7 };
+
+static POOL_SIZE_CLASS poolClasses[GBALLOC_POOL_CLASS_COUNT];
+static GBALLOC_THREAD_LOCAL POOL_FREE_BLOCK* threadPoolCache[GBALLOC_POOL_CLASS_COUNT];
+static GBALLOC_THREAD_LOCAL size_t threadPoolCacheCount[GBALLOC_POOL_CLASS_COUNT];
+static GBALLOC_THREAD_LOCAL int threadPoolCacheRegistered = 0;
+
+typedef enum THREAD_EXIT_KEY_STATE_TAG
+{
+    THREAD_EXIT_KEY_NOT_CREATED,
+    THREAD_EXIT_KEY_CREATED,
+    THREAD_EXIT_KEY_FAILED
+} THREAD_EXIT_KEY_STATE;
+
+static size_t threadExitKeyLock = 0;
+static THREAD_EXIT_KEY_STATE threadExitKeyState = THREAD_EXIT_KEY_NOT_CREATED;
+static GBALLOC_THREAD_EXIT_KEY threadExitKey;
+
+static size_t getPoolClass(size_t size)
+{
+    return poolClassByGranules[(size + GBALLOC_POOL_GRANULE - 1) / GBALLOC_POOL_GRANULE];
+}
+
+static size_t getPoolBlockSize(size_t poolClass)
+{
+    return sizeof(BLOCK_HEADER) + poolClassSizes[poolClass];
+}
+
+/* moves up to count blocks from the thread cache to the shared list of the size class */
+static void releaseThreadPoolBlocks(size_t poolClass, size_t count)
+{
+    POOL_FREE_BLOCK* first = threadPoolCache[poolClass];
+    POOL_FREE_BLOCK* last = first;
+    size_t moved = 1;
+
+    while ((moved < count) && (last->next != NULL))
+    {
+        last = last->next;
+        moved++;
+    }
+
+    threadPoolCache[poolClass] = last->next;
+    threadPoolCacheCount[poolClass] -= moved;
+
+    GBALLOC_SPIN_LOCK(&poolClasses[poolClass].spinLock);
+    last->next = poolClasses[poolClass].freeList;
+    poolClasses[poolClass].freeList = first;
+    GBALLOC_SPIN_UNLOCK(&poolClasses[poolClass].spinLock);
+}
+
+/* gives all the blocks in the cache of the calling thread back to the shared lists */
+static void drainThreadPoolCache(void)
+{
+    size_t poolClass;
+    for (poolClass = 0; poolClass < GBALLOC_POOL_CLASS_COUNT; poolClass++)
+    {
+        if (threadPoolCache[poolClass] != NULL)
+        {
+            releaseThreadPoolBlocks(poolClass, threadPoolCacheCount[poolClass]);
+        }
+    }
+}
+
+GBALLOC_THREAD_EXIT_CALLBACK(onThreadExit)
+{
+    /* Codes_SRS_GBALLOC_07_031: [When GB_POOLED_ALLOCATIONS is defined the blocks cached by a thread shall be given back to the pool shared by all threads when the thread exits.] */
+    (void)value;
+    /* the destructors that run after this one can still free blocks, they register the thread again */
+    threadPoolCacheRegistered = 0;
+    drainThreadPoolCache();
+}
+
+/* called before blocks are put in the cache of the calling thread, arms the thread exit callback once per thread */
+static void registerThreadPoolCache(void)
+{
+    if (!threadPoolCacheRegistered)
+    {
+        THREAD_EXIT_KEY_STATE state;
+
+        GBALLOC_SPIN_LOCK(&threadExitKeyLock);
+        if (threadExitKeyState == THREAD_EXIT_KEY_NOT_CREATED)
+        {
+            threadExitKeyState = (GBALLOC_CREATE_THREAD_EXIT_KEY(&threadExitKey, onThreadExit) == 0) ? THREAD_EXIT_KEY_CREATED : THREAD_EXIT_KEY_FAILED;
+        }
+        state = threadExitKeyState;
+        GBALLOC_SPIN_UNLOCK(&threadExitKeyLock);
+
+        if ((state != THREAD_EXIT_KEY_CREATED) ||
+            (GBALLOC_ARM_THREAD_EXIT_KEY(threadExitKey) != 0))
+        {
+            LogError("Unable to register the thread exit callback, the pooled blocks cached by this thread are lost when it exits.");
+        }
+
+        /* failing is not retried on every free */
+        threadPoolCacheRegistered = 1;
+    }
+}
+
+/* moves up to GBALLOC_POOL_TRANSFER_COUNT blocks from the shared list of the size class to the (empty) thread cache */
+static void acquireThreadPoolBlocks(size_t poolClass)
+{
+    POOL_FREE_BLOCK* first;
+
+    GBALLOC_SPIN_LOCK(&poolClasses[poolClass].spinLock);
+    first = poolClasses[poolClass].freeList;
+    if (first != NULL)
+    {
+        POOL_FREE_BLOCK* last = first;
+        size_t moved = 1;
+        while ((moved < GBALLOC_POOL_TRANSFER_COUNT) && (last->next != NULL))
+        {
+            last = last->next;
+            moved++;
+        }
+
+        poolClasses[poolClass].freeList = last->next;
+        last->next = NULL;
+        threadPoolCacheCount[poolClass] = moved;
+    }
+    GBALLOC_SPIN_UNLOCK(&poolClasses[poolClass].spinLock);
+
+    threadPoolCache[poolClass] = first;
+}
+
+static int addPoolSlab(size_t poolClass)
+{
+    int result;
+    size_t blockSize = getPoolBlockSize(poolClass);
+    size_t blockCount = GBALLOC_POOL_SLAB_SIZE / blockSize;
+    unsigned char* slab = (unsigned char*)malloc(blockCount * blockSize);
+
+    if (slab == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+        for (i = 0; i < blockCount; i++)
+        {
+            POOL_FREE_BLOCK* block = (POOL_FREE_BLOCK*)(slab + (i * blockSize));
+            block->next = threadPoolCache[poolClass];
+            threadPoolCache[poolClass] = block;
+        }
+        threadPoolCacheCount[poolClass] += blockCount;
+
+        /* keep the thread cache bounded, the rest of the slab is available to the other threads */
+        if (threadPoolCacheCount[poolClass] > GBALLOC_POOL_THREAD_CACHE_SIZE)
+        {
+            releaseThreadPoolBlocks(poolClass, threadPoolCacheCount[poolClass] - GBALLOC_POOL_TRANSFER_COUNT);
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
+
+/* returns a block with room for a header and poolClassSizes[poolClass] bytes, or NULL if no new slab could be allocated */
+static BLOCK_HEADER* allocatePoolBlock(size_t poolClass, int* isHit)
+{
+    BLOCK_HEADER* result;
+
+    *isHit = 1;
+    if (threadPoolCache[poolClass] == NULL)
+    {
+        registerThreadPoolCache();
+        acquireThreadPoolBlocks(poolClass);
+        if (threadPoolCache[poolClass] == NULL)
+        {
+            *isHit = 0;
+            if (addPoolSlab(poolClass) != 0)
+            {
+                LogError("Failed to allocate a slab for the pool.");
+            }
+        }
+    }
+
+    if (threadPoolCache[poolClass] == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        POOL_FREE_BLOCK* block = threadPoolCache[poolClass];
+        threadPoolCache[poolClass] = block->next;
+        threadPoolCacheCount[poolClass]--;
+        result = (BLOCK_HEADER*)block;
+    }
+
+    return result;
+}
+
+static void freePoolBlock(BLOCK_HEADER* header)
+{
+    size_t poolClass = getPoolClass(header->info.size);
+    POOL_FREE_BLOCK* block = (POOL_FREE_BLOCK*)header;
+
+    registerThreadPoolCache();
+    block->next = threadPoolCache[poolClass];
+    threadPoolCache[poolClass] = block;
+    threadPoolCacheCount[poolClass]++;
+
+    if (threadPoolCacheCount[poolClass] > GBALLOC_POOL_THREAD_CACHE_SIZE)
+    {
+        releaseThreadPoolBlocks(poolClass, GBALLOC_POOL_TRANSFER_COUNT);
+    }
+}
+
+static void accountPoolRequest(int isHit)
+{
+    if (gballocState == GBALLOC_STATE_INIT)
+    {
+        GBALLOC_SHARD* shard = &shards[getThreadShard()];
+        (void)GBALLOC_ATOMIC_ADD(&shard->counters.poolRequestCount, 1);
+        if (isHit)
+        {
+            (void)GBALLOC_ATOMIC_ADD(&shard->counters.poolHitCount, 1);
+        }
+    }
+}
+
+#endif /* GB_POOLED_ALLOCATIONS */
+
+/* ptr has to come from gballoc: the header of memory that gballoc did not allocate cannot be read without undefined behavior, */
+/* the magic only catches the common mistakes, like a double free or a pointer that is not the start of a block */
+static BLOCK_HEADER* getBlockHeader(void* ptr)
+{
+    BLOCK_HEADER* result = (BLOCK_HEADER*)ptr - 1;
+
+    if ((result->info.tag & GBALLOC_TAG_MAGIC_MASK) != GBALLOC_TAG_MAGIC)
+    {
+        LogError("Address %p was not allocated by gballoc", ptr);
+        result = NULL;
+    }
+
+    return result;
+}
+
+int gballoc_init(void)
+{
+    int result;
+
+    if (gballocState != GBALLOC_STATE_NOT_INIT)
+    {
+        /* Codes_SRS_GBALLOC_01_025: [Init after Init shall fail and return a non-zero value.] */
+        result = __LINE__;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_007: [When GB_SHARDED_ACCOUNTING is defined gballoc_init shall not create a lock.] */
+        /* Codes_SRS_GBALLOC_01_002: [Upon initialization the total memory used and maximum total memory used tracked by the module shall be set to 0.] */
+        (void)memset(shards, 0, sizeof(shards));
+        generation++;
+        gballocState = GBALLOC_STATE_INIT;
+
+        /* Codes_SRS_GBALLOC_01_024: [gballoc_init shall initialize the gballoc module and return 0 upon success.] */
+        result = 0;
+    }
+
+    return result;
+}
+
+void gballoc_deinit(void)
+{
+    gballocState = GBALLOC_STATE_NOT_INIT;
+#if defined(GB_POOLED_ALLOCATIONS)
+    /* Codes_SRS_GBALLOC_07_032: [When GB_POOLED_ALLOCATIONS is defined gballoc_deinit shall give the blocks cached by the calling thread back to the pool shared by all threads.] */
+    drainThreadPoolCache();
+#endif
+}
+
+void* gballoc_malloc(size_t size)
+{
+    void* result;
+    BLOCK_HEADER* header;
+    uint32_t pooledFlag = 0;
+
+#if defined(GB_POOLED_ALLOCATIONS)
+    if (size <= GBALLOC_POOL_MAX_SIZE)
+    {
+        int isHit;
+
+        /* Codes_SRS_GBALLOC_07_010: [When GB_POOLED_ALLOCATIONS is defined gballoc_malloc shall serve sizes up to 256 bytes from the pool of the smallest size class that can hold size bytes.] */
+        header = allocatePoolBlock(getPoolClass(size), &isHit);
+        /* Codes_SRS_GBALLOC_07_013: [Every pooled allocation request shall be counted, and it shall be counted as a hit when it did not need a new slab.] */
+        accountPoolRequest(isHit);
+        if (header != NULL)
+        {
+            pooledFlag = GBALLOC_TAG_POOLED;
+        }
+    }
+    else
+    {
+        header = NULL;
+    }
+
+    /* Codes_SRS_GBALLOC_07_012: [If no block can be obtained from the pool, gballoc_malloc shall fall back to the underlying malloc.] */
+    if (header != NULL)
+    {
+        result = header + 1;
+    }
+    else
+#endif
+    if (size > SIZE_MAX - sizeof(BLOCK_HEADER))
+    {
+        LogError("Allocation size too big.");
+        result = NULL;
+    }
+    /* Codes_SRS_GBALLOC_07_002: [When GB_SHARDED_ACCOUNTING is defined gballoc_malloc shall allocate with one underlying malloc call room for a header followed by size bytes, store size in the header and return the address that follows the header.] */
+    else if ((header = (BLOCK_HEADER*)malloc(sizeof(BLOCK_HEADER) + size)) == NULL)
+    {
+        /* Codes_SRS_GBALLOC_01_012: [When the underlying malloc call fails, gballoc_malloc shall return NULL and size should not be counted towards total memory used.] */
+        result = NULL;
+    }
+    else
+    {
+        result = header + 1;
+    }
+
+    if (result != NULL)
+    {
+        GBALLOC_SHARD* shard;
+
+        header->info.size = size;
+        /* Codes_SRS_GBALLOC_07_008: [When GB_SHARDED_ACCOUNTING is defined blocks allocated while gballoc is not initialized shall carry a header but shall never be counted.] */
+        writeTag(header, pooledFlag);
+        if ((shard = getAccountingShard(header)) != NULL)
+        {
+            /* Codes_SRS_GBALLOC_07_003: [When GB_SHARDED_ACCOUNTING is defined gballoc_malloc, gballoc_calloc, gballoc_realloc and gballoc_free shall not acquire any lock and shall update the counters of the shard assigned to the calling thread with atomic operations.] */
+            accountAllocation(shard, size);
+        }
+    }
+
+    return result;
+}
+
+void* gballoc_calloc(size_t nmemb, size_t size)
+{
+    void* result;
+    size_t totalSize = nmemb * size;
+
+    if ((size != 0) && (totalSize / size != nmemb))
+    {
+        LogError("Allocation size too big.");
+        result = NULL;
+    }
+    else if ((result = gballoc_malloc(totalSize)) != NULL)
+    {
+        /* Codes_SRS_GBALLOC_01_021: [If the underlying calloc call is successful, gballoc_calloc shall increment the total memory used with nmemb*size.] */
+        (void)memset(result, 0, totalSize);
+    }
+
+    return result;
+}
+
+void* gballoc_realloc(void* ptr, size_t size)
+{
+    void* result;
+
+    if (ptr == NULL)
+    {
+        /* Codes_SRS_GBALLOC_01_017: [When ptr is NULL, gballoc_realloc shall call the underlying realloc with ptr being NULL and the realloc result shall be tracked by gballoc.] */
+        result = gballoc_malloc(size);
+    }
+    else
+    {
+        BLOCK_HEADER* header = getBlockHeader(ptr);
+        BLOCK_HEADER* newHeader;
+
+        if (header == NULL)
+        {
+            /* Codes_SRS_GBALLOC_07_009: [When GB_SHARDED_ACCOUNTING is defined and the header in front of ptr was not written by gballoc, gballoc_realloc shall return NULL without calling the underlying realloc and gballoc_free shall not free any memory.] */
+            result = NULL;
+        }
+#if defined(GB_POOLED_ALLOCATIONS)
+        else if ((header->info.tag & GBALLOC_TAG_POOLED) != 0)
+        {
+            if ((size <= GBALLOC_POOL_MAX_SIZE) && (getPoolClass(size) == getPoolClass(header->info.size)))
+            {
+                /* Codes_SRS_GBALLOC_07_015: [When GB_POOLED_ALLOCATIONS is defined and ptr is a pooled block whose size class can hold size bytes, gballoc_realloc shall return ptr without calling the underlying realloc.] */
+                GBALLOC_SHARD* shard = getAccountingShard(header);
+                if (shard != NULL)
+                {
+                    accountFree(shard, header->info.size);
+                    accountAllocation(shard, size);
+                }
+
+                header->info.size = size;
+                result = ptr;
+            }
+            /* Codes_SRS_GBALLOC_07_016: [Otherwise gballoc_realloc shall allocate a new block with gballoc_malloc, copy the contents and free the pooled block.] */
+            else if ((result = gballoc_malloc(size)) != NULL)
+            {
+                (void)memcpy(result, ptr, (size < header->info.size) ? size : header->info.size);
+                gballoc_free(ptr);
+            }
+        }
+#endif
+        else if (size > SIZE_MAX - sizeof(BLOCK_HEADER))
+        {
+            LogError("Allocation size too big.");
+            result = NULL;
+        }
+        else if ((newHeader = (BLOCK_HEADER*)realloc(header, sizeof(BLOCK_HEADER) + size)) == NULL)
+        {
+            /* Codes_SRS_GBALLOC_01_014: [When the underlying realloc call fails, gballoc_realloc shall return NULL and no change should be made to the counted total memory usage.] */
+            result = NULL;
+        }
+        else
+        {
+            GBALLOC_SHARD* shard = getAccountingShard(newHeader);
+            if (shard != NULL)
+            {
+                /* Codes_SRS_GBALLOC_01_006: [If the underlying realloc call is successful, gballoc_realloc shall look up the size associated with the pointer ptr and decrease the total memory used with that size.] */
+                accountFree(shard, newHeader->info.size);
+                /* Codes_SRS_GBALLOC_01_007: [If realloc is successful, gballoc_realloc shall also increment the total memory used value tracked by this module.] */
+                accountAllocation(shard, size);
+            }
+
+            newHeader->info.size = size;
+            result = newHeader + 1;
+        }
+    }
+
+    return result;
+}
+
+void gballoc_free(void* ptr)
+{
+    if (ptr != NULL)
+    {
+        BLOCK_HEADER* header = getBlockHeader(ptr);
+        if (header != NULL)
+        {
+            /* Codes_SRS_GBALLOC_07_004: [When GB_SHARDED_ACCOUNTING is defined gballoc_free shall decrement the shard that accounted for the block, regardless of the thread calling gballoc_free.] */
+            GBALLOC_SHARD* shard = getAccountingShard(header);
+            if (shard != NULL)
+            {
+                accountFree(shard, header->info.size);
+            }
+
+#if defined(GB_POOLED_ALLOCATIONS)
+            if ((header->info.tag & GBALLOC_TAG_POOLED) != 0)
+            {
+                /* clearing the tag makes a double free show up as an untracked pointer */
+                header->info.tag = 0;
+
+                /* Codes_SRS_GBALLOC_07_011: [When GB_POOLED_ALLOCATIONS is defined gballoc_free shall return pooled blocks to the pool instead of calling the underlying free.] */
+                freePoolBlock(header);
+            }
+            else
+#endif
+            {
+                /* clearing the tag makes a double free show up as an untracked pointer */
+                header->info.tag = 0;
+
+                /* Codes_SRS_GBALLOC_01_008: [gballoc_free shall call the C99 free function.] */
+                free(header);
+            }
+        }
+    }
+}
+
+size_t gballoc_getMaximumMemoryUsed(void)
+{
+    size_t result;
+
+    /* Codes_SRS_GBALLOC_01_038: [If gballoc was not initialized gballoc_getMaximumMemoryUsed shall return MAX_INT_SIZE.] */
+    if (gballocState != GBALLOC_STATE_INIT)
+    {
+        LogError("gballoc is not initialized.");
+        result = SIZE_MAX;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_006: [When GB_SHARDED_ACCOUNTING is defined gballoc_getMaximumMemoryUsed shall return the sum of the maximum values reached by each shard, which is an upper bound of the maximum total memory used.] */
+        size_t i;
+        result = 0;
+        for (i = 0; i < GBALLOC_SHARD_COUNT; i++)
+        {
+            result += GBALLOC_ATOMIC_LOAD(&shards[i].counters.maxSize);
+        }
+    }
+
+    return result;
+}
+
+size_t gballoc_getCurrentMemoryUsed(void)
+{
+    size_t result;
+
+    /* Codes_SRS_GBALLOC_01_044: [If gballoc was not initialized gballoc_getCurrentMemoryUsed shall return SIZE_MAX.] */
+    if (gballocState != GBALLOC_STATE_INIT)
+    {
+        LogError("gballoc is not initialized.");
+        result = SIZE_MAX;
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_005: [When GB_SHARDED_ACCOUNTING is defined gballoc_getCurrentMemoryUsed shall return the sum of the counters of all the shards.] */
+        size_t i;
+        result = 0;
+        for (i = 0; i < GBALLOC_SHARD_COUNT; i++)
+        {
+            result += GBALLOC_ATOMIC_LOAD(&shards[i].counters.totalSize);
+        }
+    }
+
+    return result;
+}
+
+/* allocation sites are only recorded by the lock based accounting, the lock free one has no place to aggregate them without serializing the callers again */
+void* gballoc_malloc_at(size_t size, const char* file, int line)
+{
+    (void)file;
+    (void)line;
+    return gballoc_malloc(size);
+}
+
+void* gballoc_calloc_at(size_t nmemb, size_t size, const char* file, int line)
+{
+    (void)file;
+    (void)line;
+    return gballoc_calloc(nmemb, size);
+}
+
+void* gballoc_realloc_at(void* ptr, size_t size, const char* file, int line)
+{
+    (void)file;
+    (void)line;
+    return gballoc_realloc(ptr, size);
+}
+
+size_t gballoc_getAllocationSites(GBALLOC_ALLOCATION_SITE* sites, size_t maxSites)
+{
+    /* Codes_SRS_GBALLOC_07_028: [When GB_SHARDED_ACCOUNTING is defined allocation sites are not recorded and gballoc_getAllocationSites shall return 0.] */
+    (void)sites;
+    (void)maxSites;
+    return 0;
+}
+
+static size_t sumPoolCounter(int countHits)
+{
+    size_t result;
+
+    /* Codes_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+#if defined(GB_POOLED_ALLOCATIONS)
+    if (gballocState == GBALLOC_STATE_INIT)
+    {
+        size_t i;
+        result = 0;
+        for (i = 0; i < GBALLOC_SHARD_COUNT; i++)
+        {
+            result += countHits ?
+                GBALLOC_ATOMIC_LOAD(&shards[i].counters.poolHitCount) :
+                GBALLOC_ATOMIC_LOAD(&shards[i].counters.poolRequestCount);
+        }
+    }
+    else
+#else
+    (void)countHits;
+#endif
+    {
+        result = SIZE_MAX;
+    }
+
+    return result;
+}
+
+size_t gballoc_getPoolRequestCount(void)
+{
+    /* Codes_SRS_GBALLOC_07_017: [gballoc_getPoolRequestCount shall return the number of allocations that were requested from the pool since the module initialization.] */
+    return sumPoolCounter(0);
+}
+
+size_t gballoc_getPoolHitCount(void)
+{
+    /* Codes_SRS_GBALLOC_07_018: [gballoc_getPoolHitCount shall return the number of pooled allocations that were served without allocating a new slab since the module initialization.] */
+    return sumPoolCounter(1);
+}
+
+#endif /* GB_SHARDED_ACCOUNTING */
+
+void gballoc_dumpAllocationSites(size_t topCount)
+{
+    GBALLOC_ALLOCATION_SITE* sites;
+
+    if (topCount == 0)
+    {
+        /* Codes_SRS_GBALLOC_07_030: [If topCount is 0, gballoc_dumpAllocationSites shall not log anything.] */
+    }
+    else if ((sites = (GBALLOC_ALLOCATION_SITE*)malloc(topCount * sizeof(GBALLOC_ALLOCATION_SITE))) == NULL)
+    {
+        LogError("Cannot allocate memory for the allocation sites.");
+    }
+    else
+    {
+        /* Codes_SRS_GBALLOC_07_029: [gballoc_dumpAllocationSites shall log one line per site returned by gballoc_getAllocationSites for topCount sites.] */
+        size_t count = gballoc_getAllocationSites(sites, topCount);
+        size_t i;
+        for (i = 0; i < count; i++)
+        {
+            LogInfo("%s:%d live bytes: %lu, live blocks: %lu, allocations: %lu, allocated bytes: %lu",
+                sites[i].file, sites[i].line,
+                (unsigned long)sites[i].liveBytes, (unsigned long)sites[i].liveCount,
+                (unsigned long)sites[i].allocationCount, (unsigned long)sites[i].allocatedBytes);
+        }
+
+        free(sites);
+    }
+}
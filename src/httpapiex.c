@@ -12,6 +12,7 @@
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "azure_c_shared_utility/vector.h"
+#include "azure_c_shared_utility/string_intern.h"
 
 typedef struct HTTPAPIEX_SAVED_OPTION_TAG
 {
@@ -521,7 +522,7 @@ void HTTPAPIEX_Destroy(HTTPAPIEX_HANDLE handle)
         for (i = 0; i < vectorSize; i++)
         {
             HTTPAPIEX_SAVED_OPTION*savedOption = VECTOR_element(handleData->savedOptions, i);
-            free((void*)savedOption->optionName);
+            string_intern_release(savedOption->optionName);
             free((void*)savedOption->value);
         }
         VECTOR_destroy(handleData->savedOptions);
@@ -536,7 +537,9 @@ void HTTPAPIEX_Destroy(HTTPAPIEX_HANDLE handle)
 
 static bool sameName(const void* element, const void* value)
 {
-    return (strcmp(((HTTPAPIEX_SAVED_OPTION*)element)->optionName, value) == 0) ? true : false;
+    /*value is interned, so the saved options only need strcmp when their name was interned before a string_intern_deinit*/
+    const char* optionName = ((HTTPAPIEX_SAVED_OPTION*)element)->optionName;
+    return ((optionName == value) || (strcmp(optionName, value) == 0)) ? true : false;
 }
 
 /*return 0 on success, any other value is error*/
@@ -545,30 +548,35 @@ static int createOrUpdateOption(HTTPAPIEX_HANDLE_DATA* handleData, const char* o
 {
     /*this function is called after the option value has been saved (cloned)*/
     int result;
-    
-    /*decide bwtween update or create*/
-    HTTPAPIEX_SAVED_OPTION* whereIsIt = VECTOR_find_if(handleData->savedOptions, sameName, optionName);
-    if (whereIsIt != NULL)
+    /*Codes_SRS_HTTPAPIEX_07_001: [The saved optionName shall be obtained from string_intern_acquire, so that all the handles share one copy of it.]*/
+    const char* internedName = string_intern_acquire(optionName);
+    if (internedName == NULL)
     {
-        free((void*)(whereIsIt->value));
-        whereIsIt->value = value;
-        result = 0;
+        LogError("unable to string_intern_acquire");
+        free((void*)value);
+        result = __LINE__;
     }
     else
     {
-        HTTPAPIEX_SAVED_OPTION newOption;
-        if (mallocAndStrcpy_s((char**)&(newOption.optionName), optionName) != 0)
+        /*decide bwtween update or create*/
+        HTTPAPIEX_SAVED_OPTION* whereIsIt = VECTOR_find_if(handleData->savedOptions, sameName, internedName);
+        if (whereIsIt != NULL)
         {
-            free((void*)value);
-            result = __LINE__;
+            /*the saved option already holds a reference to its name*/
+            string_intern_release(internedName);
+            free((void*)(whereIsIt->value));
+            whereIsIt->value = value;
+            result = 0;
         }
         else
         {
+            HTTPAPIEX_SAVED_OPTION newOption;
+            newOption.optionName = internedName;
             newOption.value = value;
             if (VECTOR_push_back(handleData->savedOptions, &newOption, 1) != 0)
             {
                 LogError("unable to VECTOR_push_back");
-                free((void*)newOption.optionName);
+                string_intern_release(newOption.optionName);
                 free((void*)value);
                 result = __LINE__;
             }
@@ -8,6 +8,7 @@
 #include "azure_c_shared_utility/gballoc.h"
 
 #include "azure_c_shared_utility/map.h"
+#include "azure_c_shared_utility/arena.h"
 #include "azure_c_shared_utility/httpheaders.h"
 #include <string.h>
 #include "azure_c_shared_utility/crt_abstractions.h"
@@ -33,10 +34,11 @@ HTTP_HEADERS_HANDLE HTTPHeaders_Alloc(void)
     else
     {
         /*Codes_SRS_HTTP_HEADERS_99_004:[ After a successful init, HTTPHeaders_GetHeaderCount shall report 0 existing headers.]*/
-        result->headers = Map_Create(NULL);
+        /*Codes_SRS_HTTP_HEADERS_07_003: [The header names shall be interned, so that all the HTTP_HEADERS_HANDLEs share one copy of each name.]*/
+        result->headers = Map_CreateWithInternedKeys(NULL);
         if (result->headers == NULL)
         {
-            LogError("Map_Create failed");
+            LogError("Map_CreateWithInternedKeys failed");
             free(result);
             result = NULL;
         }
@@ -203,6 +205,26 @@ const char* HTTPHeaders_FindHeaderValue(HTTP_HEADERS_HANDLE httpHeadersHandle, c
 
 }
 
+const char* HTTPHeaders_FindHeaderValueView(HTTP_HEADERS_HANDLE httpHeadersHandle, STRING_VIEW name)
+{
+    const char* result;
+    /*Codes_SRS_HTTP_HEADERS_07_004: [ The return value shall be NULL if httpHeadersHandle is NULL or if the data of name is NULL.]*/
+    if (
+        (httpHeadersHandle == NULL) ||
+        (name.data == NULL)
+        )
+    {
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_HTTP_HEADERS_07_005: [ HTTPHeaders_FindHeaderValueView shall return the value stored for the name that has exactly the characters of name, or NULL if there is no such name.]*/
+        HTTP_HEADERS_HANDLE_DATA* handleData = (HTTP_HEADERS_HANDLE_DATA*)httpHeadersHandle;
+        result = Map_GetValueFromKeyView(handleData->headers, name);
+    }
+    return result;
+}
+
 HTTP_HEADERS_RESULT HTTPHeaders_GetHeaderCount(HTTP_HEADERS_HANDLE handle, size_t* headerCount)
 {
     HTTP_HEADERS_RESULT result;
@@ -237,7 +259,8 @@ HTTP_HEADERS_RESULT HTTPHeaders_GetHeaderCount(HTTP_HEADERS_HANDLE handle, size_
 }
 
 /*produces a string in *destination that is equal to name: value*/
-HTTP_HEADERS_RESULT HTTPHeaders_GetHeader(HTTP_HEADERS_HANDLE handle, size_t index, char** destination)
+/*the name+": "+value string is malloc-ed when arena is NULL, otherwise it is taken from arena*/
+static HTTP_HEADERS_RESULT getHeader(HTTP_HEADERS_HANDLE handle, size_t index, ARENA_HANDLE arena, char** destination)
 {
     HTTP_HEADERS_RESULT result = HTTP_HEADERS_OK;
 
@@ -276,7 +299,10 @@ HTTP_HEADERS_RESULT HTTPHeaders_GetHeader(HTTP_HEADERS_HANDLE handle, size_t ind
             {
                 size_t keyLen = strlen(keys[index]);
                 size_t valueLen = strlen(values[index]);
-                *destination = (char*)malloc(sizeof(char) * (keyLen + /*COLON_AND_SPACE_LENGTH*/ 2 + valueLen + /*EOL*/ 1));
+                size_t headerLen = keyLen + /*COLON_AND_SPACE_LENGTH*/ 2 + valueLen + /*EOL*/ 1;
+                *destination = (arena == NULL) ?
+                    (char*)malloc(sizeof(char) * headerLen) :
+                    (char*)ARENA_alloc(arena, sizeof(char) * headerLen);
                 if (*destination == NULL)
                 {
                     /*Codes_SRS_HTTP_HEADERS_99_034:[ The function shall return HTTP_HEADERS_ERROR when an internal error occurs]*/
@@ -303,6 +329,30 @@ HTTP_HEADERS_RESULT HTTPHeaders_GetHeader(HTTP_HEADERS_HANDLE handle, size_t ind
     return result;
 }
 
+HTTP_HEADERS_RESULT HTTPHeaders_GetHeader(HTTP_HEADERS_HANDLE handle, size_t index, char** destination)
+{
+    return getHeader(handle, index, NULL, destination);
+}
+
+HTTP_HEADERS_RESULT HTTPHeaders_GetHeaderInArena(HTTP_HEADERS_HANDLE handle, size_t index, ARENA_HANDLE arena, char** destination)
+{
+    HTTP_HEADERS_RESULT result;
+
+    /*Codes_SRS_HTTP_HEADERS_07_001: [If arena is NULL, HTTPHeaders_GetHeaderInArena shall return HTTP_HEADERS_INVALID_ARG.]*/
+    if (arena == NULL)
+    {
+        result = HTTP_HEADERS_INVALID_ARG;
+        LogError("invalid arg (NULL arena), result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+    }
+    else
+    {
+        /*Codes_SRS_HTTP_HEADERS_07_002: [Otherwise HTTPHeaders_GetHeaderInArena shall behave like HTTPHeaders_GetHeader, except that the name+": "+value string shall be allocated with ARENA_alloc from arena.]*/
+        result = getHeader(handle, index, arena, destination);
+    }
+
+    return result;
+}
+
 HTTP_HEADERS_HANDLE HTTPHeaders_Clone(HTTP_HEADERS_HANDLE handle)
 {
     HTTP_HEADERS_HANDLE_DATA* result;
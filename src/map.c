@@ -10,33 +10,166 @@
 #include "azure_c_shared_utility/map.h"
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/refcount.h"
+#include "azure_c_shared_utility/string_intern.h"
+#include "azure_c_shared_utility/string_hash.h"
 
 DEFINE_ENUM_STRINGS(MAP_RESULT, MAP_RESULT_VALUES);
 
+/*the index is an open addressing (linear probing) hash table of positions in keys/values, the arrays keep the insertion order*/
+/*position is 1 based, 0 marks an empty slot*/
+typedef struct MAP_INDEX_SLOT_TAG
+{
+    size_t hash;
+    size_t position;
+}MAP_INDEX_SLOT;
+
+/*up to this many pairs a linear scan is as fast as hashing, so small maps do not get an index at all*/
+#define MAP_INDEX_THRESHOLD 8
+#define MAP_INDEX_MIN_CAPACITY 16
+
+/*Map_Clone does not copy anything, the source and the clone share the same keys/values (and index) through this.*/
+/*Shared storage is never modified, the first change made through any of the handles copies it first*/
+typedef struct MAP_SHARED_STORAGE_TAG
+{
+    char** keys;
+    char** values;
+    size_t count;
+    MAP_INDEX_SLOT* index;
+    bool internKeys;
+}MAP_SHARED_STORAGE;
+
+DEFINE_REFCOUNT_TYPE(MAP_SHARED_STORAGE);
+
 typedef struct MAP_HANDLE_DATA_TAG
 {
     char** keys;
     char** values;
     size_t count;
+    size_t capacity; /*how many pairs keys and values have room for*/
     MAP_FILTER_CALLBACK mapFilterCallback;
+    MAP_INDEX_SLOT* index;
+    size_t indexCapacity;
+    MAP_SHARED_STORAGE* volatile shared; /*NULL when this handle is the only owner of keys/values/index, set by the first Map_Clone*/
+    bool internKeys; /*the keys come from string_intern_acquire instead of being private copies*/
 }MAP_HANDLE_DATA;
 
 #define LOG_MAP_ERROR LogError("result = %s", ENUM_TO_STRING(MAP_RESULT, result));
 
-MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
+/*several threads can clone the same map at the same time, the first of them that creates the shared storage installs it by compare and swap.*/
+/*Like refcount.h, Windows uses the Interlocked functions, gcc its builtins, and single threaded platforms can define REFCOUNT_ATOMIC_DONTCARE.*/
+#if defined(WIN32)
+#include "windows.h"
+#define MAP_LOAD_SHARED(handleData) ((MAP_SHARED_STORAGE*)InterlockedCompareExchangePointer((PVOID volatile*)&(handleData)->shared, NULL, NULL))
+#define MAP_SET_SHARED_IF_NULL(handleData, newShared) ((MAP_SHARED_STORAGE*)InterlockedCompareExchangePointer((PVOID volatile*)&(handleData)->shared, (newShared), NULL))
+#elif defined(__GNUC__)
+#define MAP_LOAD_SHARED(handleData) ((MAP_SHARED_STORAGE*)__atomic_load_n(&(handleData)->shared, __ATOMIC_ACQUIRE))
+#define MAP_SET_SHARED_IF_NULL(handleData, newShared) ((MAP_SHARED_STORAGE*)__sync_val_compare_and_swap(&(handleData)->shared, NULL, (newShared)))
+#elif defined(REFCOUNT_ATOMIC_DONTCARE)
+/*single threaded platforms*/
+static MAP_SHARED_STORAGE* setSharedIfNull(MAP_SHARED_STORAGE* volatile* target, MAP_SHARED_STORAGE* newShared)
+{
+    MAP_SHARED_STORAGE* result = *target;
+    if (result == NULL)
+    {
+        *target = newShared;
+    }
+    return result;
+}
+#define MAP_LOAD_SHARED(handleData) ((handleData)->shared)
+#define MAP_SET_SHARED_IF_NULL(handleData, newShared) setSharedIfNull(&(handleData)->shared, (newShared))
+#else
+#error do not know how to atomically compare and swap a pointer. Platform support needs to be extended to your platform.
+#endif
+
+static MAP_HANDLE_DATA* Map_CreateInternal(MAP_FILTER_CALLBACK mapFilterFunc, bool internKeys)
 {
-    /*Codes_SRS_MAP_02_001: [Map_Create shall create a new, empty map.]*/
     MAP_HANDLE_DATA* result = (MAP_HANDLE_DATA*)malloc(sizeof(MAP_HANDLE_DATA));
-    /*Codes_SRS_MAP_02_002: [If during creation there are any error, then Map_Create shall return NULL.]*/
     if (result != NULL)
     {
-        /*Codes_SRS_MAP_02_003: [Otherwise, it shall return a non-NULL handle that can be used in subsequent calls.] */
         result->keys = NULL;
         result->values = NULL;
         result->count = 0;
+        result->capacity = 0;
         result->mapFilterCallback = mapFilterFunc;
+        result->index = NULL;
+        result->indexCapacity = 0;
+        result->shared = NULL;
+        result->internKeys = internKeys;
+    }
+    return result;
+}
+
+MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
+{
+    /*Codes_SRS_MAP_02_001: [Map_Create shall create a new, empty map.]*/
+    /*Codes_SRS_MAP_02_002: [If during creation there are any error, then Map_Create shall return NULL.]*/
+    /*Codes_SRS_MAP_02_003: [Otherwise, it shall return a non-NULL handle that can be used in subsequent calls.] */
+    return (MAP_HANDLE)Map_CreateInternal(mapFilterFunc, false);
+}
+
+MAP_HANDLE Map_CreateWithInternedKeys(MAP_FILTER_CALLBACK mapFilterFunc)
+{
+    /*Codes_SRS_MAP_07_031: [Map_CreateWithInternedKeys shall create a new, empty map the same way Map_Create does.]*/
+    /*Codes_SRS_MAP_07_032: [The keys of that map shall be obtained from string_intern_acquire instead of being copied, and given back with string_intern_release.]*/
+    return (MAP_HANDLE)Map_CreateInternal(mapFilterFunc, true);
+}
+
+/*keys are copied with this, so that maps with interned keys share them with everybody else that interned the same characters*/
+static int Map_CopyString(char** destination, const char* source, bool intern)
+{
+    int result;
+    if (!intern)
+    {
+        result = mallocAndStrcpy_s(destination, source);
+    }
+    else if ((*destination = (char*)string_intern_acquire(source)) == NULL)
+    {
+        LogError("unable to string_intern_acquire");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static void Map_FreeString(char* string, bool intern)
+{
+    if (intern)
+    {
+        string_intern_release(string);
+    }
+    else
+    {
+        free(string);
+    }
+}
+
+static void Map_FreeStorage(char** keys, char** values, size_t count, MAP_INDEX_SLOT* index, bool internKeys)
+{
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        Map_FreeString(keys[i], internKeys);
+        free(values[i]);
+    }
+    free(keys);
+    free(values);
+    if (index != NULL)
+    {
+        free(index);
+    }
+}
+
+static void Map_ReleaseSharedStorage(MAP_SHARED_STORAGE* shared)
+{
+    if (DEC_REF(MAP_SHARED_STORAGE, shared) == DEC_RETURN_ZERO)
+    {
+        Map_FreeStorage(shared->keys, shared->values, shared->count, shared->index, shared->internKeys);
+        free(shared);
     }
-    return (MAP_HANDLE)result;
 }
 
 void Map_Destroy(MAP_HANDLE handle)
@@ -46,22 +179,22 @@ void Map_Destroy(MAP_HANDLE handle)
     {
         /*Codes_SRS_MAP_02_004: [Map_Destroy shall release all resources associated with the map.] */
         MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA*)handle;
-        size_t i;
-      
-        for (i = 0; i < handleData->count; i++)
+        if (handleData->shared != NULL)
         {
-            free(handleData->keys[i]);
-            free(handleData->values[i]);
+            /*Codes_SRS_MAP_07_028: [When the last map that shares the storage is destroyed, the storage shall be released.]*/
+            Map_ReleaseSharedStorage(handleData->shared);
+        }
+        else
+        {
+            Map_FreeStorage(handleData->keys, handleData->values, handleData->count, handleData->index, handleData->internKeys);
         }
-        free(handleData->keys);
-        free(handleData->values);
         free(handleData);
     }
 }
 
 /*makes a copy of a vector of const char*, having size "size". source cannot be NULL*/
 /*returns NULL if it fails*/
-static char** Map_CloneVector(const char*const * source, size_t count)
+static char** Map_CloneVector(const char*const * source, size_t count, bool intern)
 {
     char** result;
     result = (char**)malloc(count *sizeof(char*));
@@ -74,7 +207,7 @@ static char** Map_CloneVector(const char*const * source, size_t count)
         size_t i;
         for (i = 0; i < count; i++)
         {
-            if (mallocAndStrcpy_s(result + i, source[i]) != 0)
+            if (Map_CopyString(result + i, source[i], intern) != 0)
             {
                 break;
             }
@@ -89,7 +222,7 @@ static char** Map_CloneVector(const char*const * source, size_t count)
             size_t j;
             for (j = 0; j < i; j++)
             {
-                free(result[j]);
+                Map_FreeString(result[j], intern);
             }
             free(result);
             result = NULL;
@@ -98,6 +231,109 @@ static char** Map_CloneVector(const char*const * source, size_t count)
     return result;
 }
 
+/*gives handleData keys/values of its own before it changes them, that is where the copy Map_Clone did not make happens*/
+static int Map_MakeStorageOwned(MAP_HANDLE_DATA* handleData)
+{
+    int result;
+    if (handleData->shared == NULL)
+    {
+        result = 0;
+    }
+    /*the other maps can only stop sharing, so once handleData is the last one the storage cannot become shared again behind its back*/
+    else if (GET_REF(MAP_SHARED_STORAGE, handleData->shared) == 1)
+    {
+        /*Codes_SRS_MAP_07_034: [If the other maps that shared the storage are gone, the first change shall take the keys, values and index back without copying them.]*/
+        free(handleData->shared);
+        handleData->shared = NULL;
+        result = 0;
+    }
+    else
+    {
+        char** newKeys;
+        char** newValues;
+        /*Codes_SRS_MAP_07_029: [The first change made to a map that shares its storage shall copy the keys and values first, the other maps shall not see the change.]*/
+        if ((newKeys = Map_CloneVector((const char* const*)handleData->keys, handleData->count, handleData->internKeys)) == NULL)
+        {
+            /*Codes_SRS_MAP_07_030: [If that copy fails, the change shall fail with MAP_ERROR and leave the map unchanged.]*/
+            LogError("unable to copy the shared keys");
+            result = __LINE__;
+        }
+        else if ((newValues = Map_CloneVector((const char* const*)handleData->values, handleData->count, false)) == NULL)
+        {
+            size_t i;
+            /*Codes_SRS_MAP_07_030: [If that copy fails, the change shall fail with MAP_ERROR and leave the map unchanged.]*/
+            LogError("unable to copy the shared values");
+            for (i = 0; i < handleData->count; i++)
+            {
+                Map_FreeString(newKeys[i], handleData->internKeys);
+            }
+            free(newKeys);
+            result = __LINE__;
+        }
+        else
+        {
+            /*the shared index stays with the shared storage, its slots are still right for the copy*/
+            if (handleData->index != NULL)
+            {
+                MAP_INDEX_SLOT* newIndex = (MAP_INDEX_SLOT*)malloc(handleData->indexCapacity * sizeof(MAP_INDEX_SLOT));
+                if (newIndex == NULL)
+                {
+                    /*Codes_SRS_MAP_07_014: [If the index cannot be allocated, the map shall keep working by comparing all the keys.]*/
+                    LogError("unable to malloc the map index, lookups stay linear");
+                    handleData->indexCapacity = 0;
+                }
+                else
+                {
+                    (void)memcpy(newIndex, handleData->index, handleData->indexCapacity * sizeof(MAP_INDEX_SLOT));
+                }
+                handleData->index = newIndex;
+            }
+            Map_ReleaseSharedStorage(handleData->shared);
+            handleData->shared = NULL;
+            handleData->keys = newKeys;
+            handleData->values = newValues;
+            handleData->capacity = handleData->count;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*returns the storage that handleData shares with its clones, creating it the first time. Only reads handleData otherwise, so that*/
+/*clones of the same map can be made from several threads. NULL when the storage cannot be allocated*/
+static MAP_SHARED_STORAGE* Map_GetSharedStorage(MAP_HANDLE_DATA* handleData)
+{
+    MAP_SHARED_STORAGE* result = MAP_LOAD_SHARED(handleData);
+    if (result == NULL)
+    {
+        MAP_SHARED_STORAGE* newShared = REFCOUNT_TYPE_CREATE(MAP_SHARED_STORAGE);
+        if (newShared == NULL)
+        {
+            LogError("unable to malloc");
+        }
+        else
+        {
+            /*the count of 1 is handleData's own reference*/
+            newShared->keys = handleData->keys;
+            newShared->values = handleData->values;
+            newShared->count = handleData->count;
+            newShared->index = handleData->index;
+            newShared->internKeys = handleData->internKeys;
+            /*Codes_SRS_MAP_07_035: [Map_Clone shall only read handle, clones of the same map can be made from several threads at the same time.]*/
+            if ((result = MAP_SET_SHARED_IF_NULL(handleData, newShared)) != NULL)
+            {
+                /*another thread cloning the same map installed its storage first, that one is used*/
+                free(newShared);
+            }
+            else
+            {
+                result = newShared;
+            }
+        }
+    }
+    return result;
+}
+
 /*Codes_SRS_MAP_02_039: [Map_Clone shall make a copy of the map indicated by parameter handle and return a non-NULL handle to it.]*/
 MAP_HANDLE Map_Clone(MAP_HANDLE handle)
 {
@@ -123,37 +359,37 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
             if (handleData->count == 0)  
             {
                 result->count = 0;
+                result->capacity = 0;
                 result->keys = NULL;
                 result->values = NULL;
                 result->mapFilterCallback = NULL;
+                result->index = NULL;
+                result->indexCapacity = 0;
+                result->shared = NULL;
+                result->internKeys = handleData->internKeys;
             }
             else
             {
-                result->mapFilterCallback = handleData->mapFilterCallback;
-                result->count = handleData->count;
-                if( (result->keys = Map_CloneVector((const char* const*)handleData->keys, handleData->count))==NULL)
+                MAP_SHARED_STORAGE* shared = Map_GetSharedStorage(handleData);
+                if (shared == NULL)
                 {
                     /*Codes_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-                    LogError("unable to clone keys");
-                    free(result);
-                    result = NULL;
-                }
-                else if ((result->values = Map_CloneVector((const char* const*)handleData->values, handleData->count)) == NULL)
-                {
-                    /*Codes_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-                    LogError("unable to clone values");
-                    size_t i;
-                    for (i = 0; i < result->count; i++)
-                    {
-                        free(result->keys[i]); 
-                    }
-                    free(result->keys);
                     free(result);
                     result = NULL;
                 }
                 else
                 {
-                    /*all fine, return it*/
+                    /*Codes_SRS_MAP_07_027: [Map_Clone shall not copy the keys and values, the clone shall share them with handle.]*/
+                    (void)INC_REF(MAP_SHARED_STORAGE, shared);
+                    result->mapFilterCallback = handleData->mapFilterCallback;
+                    result->count = handleData->count;
+                    result->capacity = handleData->capacity;
+                    result->keys = handleData->keys;
+                    result->values = handleData->values;
+                    result->index = handleData->index;
+                    result->indexCapacity = handleData->indexCapacity;
+                    result->shared = shared;
+                    result->internKeys = handleData->internKeys;
                 }
             }
         }
@@ -161,50 +397,96 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
     return (MAP_HANDLE)result;
 }
 
-static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
+/*grows keys and values to exactly capacity pairs, never shrinks*/
+static int Map_ReserveStorageKeysValues(MAP_HANDLE_DATA* handleData, size_t capacity)
 {
     int result;
-    char** newKeys = (char**)realloc(handleData->keys, (handleData->count + 1) * sizeof(char*));
-    if (newKeys == NULL)
+    if (capacity <= handleData->capacity)
     {
-        LogError("realloc error");
+        result = 0;
+    }
+    else if (capacity > ((size_t)~(size_t)0) / sizeof(char*))
+    {
+        LogError("too many pairs for a map");
         result = __LINE__;
     }
     else
     {
-        char** newValues;
-        handleData->keys = newKeys;
-        handleData->keys[handleData->count] = NULL;
-        newValues = (char**)realloc(handleData->values, (handleData->count + 1) * sizeof(char*));
-        if (newValues == NULL)
+        char** newKeys = (char**)realloc(handleData->keys, capacity * sizeof(char*));
+        if (newKeys == NULL)
         {
             LogError("realloc error");
-            if (handleData->count == 0) /*avoiding an implementation defined behavior */
-            {
-                free(handleData->keys);
-                handleData->keys = NULL;
-            }
-            else
+            result = __LINE__;
+        }
+        else
+        {
+            char** newValues;
+            handleData->keys = newKeys;
+            newValues = (char**)realloc(handleData->values, capacity * sizeof(char*));
+            if (newValues == NULL)
             {
-                char** undoneKeys = (char**)realloc(handleData->keys, (handleData->count) * sizeof(char*));
-                if (undoneKeys == NULL)
+                LogError("realloc error");
+                if (handleData->capacity == 0) /*avoiding an implementation defined behavior */
                 {
-                    LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
+                    free(handleData->keys);
+                    handleData->keys = NULL;
                 }
                 else
                 {
-                    handleData->keys = undoneKeys;
+                    char** undoneKeys = (char**)realloc(handleData->keys, (handleData->capacity) * sizeof(char*));
+                    if (undoneKeys == NULL)
+                    {
+                        LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
+                    }
+                    else
+                    {
+                        handleData->keys = undoneKeys;
+                    }
                 }
+                result = __LINE__;
             }
-            result = __LINE__;
+            else
+            {
+                handleData->values = newValues;
+                handleData->capacity = capacity;
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
+
+/*makes room for one more pair, doubling the storage when it is full so that adding n pairs reallocs only log(n) times*/
+static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
+{
+    int result;
+    if (handleData->count == handleData->capacity)
+    {
+        size_t newCapacity;
+        if (handleData->capacity == 0)
+        {
+            newCapacity = 1;
+        }
+        else if (handleData->capacity > ((size_t)~(size_t)0) / 2)
+        {
+            newCapacity = handleData->capacity + 1;
         }
         else
         {
-            handleData->values = newValues;
-            handleData->values[handleData->count] = NULL;
-            handleData->count++;
-            result = 0;
+            newCapacity = handleData->capacity * 2;
         }
+        result = Map_ReserveStorageKeysValues(handleData, newCapacity);
+    }
+    else
+    {
+        result = 0;
+    }
+
+    if (result == 0)
+    {
+        handleData->keys[handleData->count] = NULL;
+        handleData->values[handleData->count] = NULL;
+        handleData->count++;
     }
     return result;
 }
@@ -218,33 +500,189 @@ static void Map_DecreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
         free(handleData->values);
         handleData->values = NULL;
         handleData->count = 0;
+        handleData->capacity = 0;
         handleData->mapFilterCallback = NULL;
     }
     else
     {
         /*certainly > 1...*/
-        char** undoneValues;
-        char** undoneKeys = (char**)realloc(handleData->keys, sizeof(char*)* (handleData->count - 1)); 
-        if (undoneKeys == NULL)
+        handleData->count--;
+
+        /*only give memory back when the map is down to a quarter, so that adding and deleting around a size does not realloc every time*/
+        if (handleData->count <= handleData->capacity / 4)
         {
-            LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
+            char** undoneValues;
+            char** undoneKeys = (char**)realloc(handleData->keys, sizeof(char*)* (handleData->capacity / 2));
+            if (undoneKeys == NULL)
+            {
+                LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
+            }
+            else
+            {
+                handleData->keys = undoneKeys;
+            }
+
+            undoneValues = (char**)realloc(handleData->values, sizeof(char*)* (handleData->capacity / 2));
+            if (undoneValues == NULL)
+            {
+                LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
+            }
+            else
+            {
+                handleData->values = undoneValues;
+            }
+
+            /*both arrays have at least this much room, whichever realloc failed keeps a bigger array*/
+            handleData->capacity /= 2;
+        }
+    }
+}
+
+/*position is 1 based, as it is stored in the slots*/
+static void Map_IndexInsert(MAP_INDEX_SLOT* index, size_t indexCapacity, size_t hash, size_t position)
+{
+    size_t mask = indexCapacity - 1;
+    size_t slot = hash & mask;
+    while (index[slot].position != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    index[slot].hash = hash;
+    index[slot].position = position;
+}
+
+static void Map_IndexDestroy(MAP_HANDLE_DATA* handleData)
+{
+    if (handleData->index != NULL)
+    {
+        free(handleData->index);
+        handleData->index = NULL;
+        handleData->indexCapacity = 0;
+    }
+}
+
+/*the index only speeds up lookups, a map that cannot allocate one keeps working with linear scans and tries again at the next change*/
+/*when the map already has an index (it is growing) the hashes are taken from its slots, the keys are only hashed when there is none*/
+static void Map_IndexCreate(MAP_HANDLE_DATA* handleData)
+{
+    MAP_INDEX_SLOT* newIndex;
+    /*at most half full, with room for the next key*/
+    size_t capacity = MAP_INDEX_MIN_CAPACITY;
+    while ((capacity / 2 <= handleData->count) && (capacity <= ((size_t)~(size_t)0) / 2))
+    {
+        capacity *= 2;
+    }
+
+    if ((capacity / 2 <= handleData->count) ||
+        (capacity > ((size_t)~(size_t)0) / sizeof(MAP_INDEX_SLOT)))
+    {
+        LogError("map too big to index");
+        Map_IndexDestroy(handleData);
+    }
+    else if ((newIndex = (MAP_INDEX_SLOT*)malloc(capacity * sizeof(MAP_INDEX_SLOT))) == NULL)
+    {
+        /*Codes_SRS_MAP_07_014: [If the index cannot be allocated, the map shall keep working by comparing all the keys.]*/
+        LogError("unable to malloc the map index, lookups stay linear");
+        Map_IndexDestroy(handleData);
+    }
+    else
+    {
+        size_t i;
+        (void)memset(newIndex, 0, capacity * sizeof(MAP_INDEX_SLOT));
+        if (handleData->index != NULL)
+        {
+            for (i = 0; i < handleData->indexCapacity; i++)
+            {
+                if (handleData->index[i].position != 0)
+                {
+                    Map_IndexInsert(newIndex, capacity, handleData->index[i].hash, handleData->index[i].position);
+                }
+            }
+            free(handleData->index);
         }
         else
         {
-            handleData->keys = undoneKeys;
+            for (i = 0; i < handleData->count; i++)
+            {
+                Map_IndexInsert(newIndex, capacity, string_hash(handleData->keys[i], NULL), i + 1);
+            }
         }
+        handleData->index = newIndex;
+        handleData->indexCapacity = capacity;
+    }
+}
 
-        undoneValues = (char**)realloc(handleData->values, sizeof(char*)* (handleData->count - 1));
-        if (undoneValues == NULL)
+/*called after the pair at position count - 1 has been added*/
+/*Codes_SRS_MAP_07_033: [The index shall be built and kept up to date by the calls that change the map, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall not change the map.]*/
+static void Map_IndexAdd(MAP_HANDLE_DATA* handleData)
+{
+    if (handleData->index == NULL)
+    {
+        if (handleData->count > MAP_INDEX_THRESHOLD)
         {
-            LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
+            /*hashes all the keys, the new one included*/
+            Map_IndexCreate(handleData);
         }
-        else
+    }
+    else
+    {
+        if (handleData->count > handleData->indexCapacity / 2)
         {
-            handleData->values = undoneValues;
+            /*moves the slots there are, the new key is not in them yet*/
+            Map_IndexCreate(handleData);
         }
 
-        handleData->count--;
+        if (handleData->index != NULL)
+        {
+            Map_IndexInsert(handleData->index, handleData->indexCapacity, string_hash(handleData->keys[handleData->count - 1], NULL), handleData->count);
+        }
+    }
+}
+
+/*called after the pair at position has been removed, all the pairs after it have moved one position down*/
+static void Map_IndexRemove(MAP_HANDLE_DATA* handleData, size_t position)
+{
+    /*Codes_SRS_MAP_07_015: [Map_GetInternals and Map_ToJSON shall produce the pairs in the order they were added, also after pairs were deleted.]*/
+    if (handleData->count <= MAP_INDEX_THRESHOLD)
+    {
+        Map_IndexDestroy(handleData);
+    }
+    else if (handleData->index == NULL)
+    {
+        Map_IndexCreate(handleData);
+    }
+    else
+    {
+        size_t mask = handleData->indexCapacity - 1;
+        size_t hole = 0;
+        size_t slot;
+        while (handleData->index[hole].position != position + 1)
+        {
+            hole++;
+        }
+
+        /*backward shift deletion: the slots that follow in the same run move back into the hole when that is not before where their hash starts probing*/
+        /*so that lookups do not stop early, nothing is hashed again*/
+        slot = (hole + 1) & mask;
+        while (handleData->index[slot].position != 0)
+        {
+            size_t start = handleData->index[slot].hash & mask;
+            if (((slot - start) & mask) >= ((slot - hole) & mask))
+            {
+                handleData->index[hole] = handleData->index[slot];
+                hole = slot;
+            }
+            slot = (slot + 1) & mask;
+        }
+        handleData->index[hole].position = 0;
+
+        for (slot = 0; slot < handleData->indexCapacity; slot++)
+        {
+            if (handleData->index[slot].position > position + 1)
+            {
+                handleData->index[slot].position--;
+            }
+        }
     }
 }
 
@@ -255,13 +693,73 @@ static char** findKey(MAP_HANDLE_DATA* handleData, const char* key)
     {
         result = NULL;
     }
+    /*Codes_SRS_MAP_07_013: [Once the map holds more than 8 pairs, Map_Add, Map_AddOrUpdate, Map_Delete, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall find keys through a hash index instead of comparing all the keys.]*/
+    else if (handleData->index != NULL)
+    {
+        size_t hash = string_hash(key, NULL);
+        size_t mask = handleData->indexCapacity - 1;
+        size_t slot = hash & mask;
+        result = NULL;
+        while (handleData->index[slot].position != 0)
+        {
+            if ((handleData->index[slot].hash == hash) &&
+                ((handleData->keys[handleData->index[slot].position - 1] == key) || (strcmp(handleData->keys[handleData->index[slot].position - 1], key) == 0)))
+            {
+                result = handleData->keys + handleData->index[slot].position - 1;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    else
+    {
+        size_t i;
+        result = NULL;
+        for (i = 0; i < handleData->count; i++)
+        {
+            /*an interned key is found without looking at its characters*/
+            if ((handleData->keys[i] == key) || (strcmp(handleData->keys[i], key) == 0))
+            {
+                result = handleData->keys + i;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+/*same as findKey, key does not need to be '\0' terminated*/
+static char** findKeyView(MAP_HANDLE_DATA* handleData, STRING_VIEW key)
+{
+    char** result;
+    if (handleData->keys == NULL)
+    {
+        result = NULL;
+    }
+    else if (handleData->index != NULL)
+    {
+        size_t hash = string_hash_n(key.data, key.length);
+        size_t mask = handleData->indexCapacity - 1;
+        size_t slot = hash & mask;
+        result = NULL;
+        while (handleData->index[slot].position != 0)
+        {
+            if ((handleData->index[slot].hash == hash) &&
+                (STRING_VIEW_equals(key, handleData->keys[handleData->index[slot].position - 1])))
+            {
+                result = handleData->keys + handleData->index[slot].position - 1;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
     else
     {
         size_t i;
         result = NULL;
         for (i = 0; i < handleData->count; i++)
         {
-            if (strcmp(handleData->keys[i], key) == 0)
+            if (STRING_VIEW_equals(key, handleData->keys[i]))
             {
                 result = handleData->keys + i;
                 break;
@@ -297,29 +795,34 @@ static char** findValue(MAP_HANDLE_DATA* handleData, const char* value)
 static int insertNewKeyValue(MAP_HANDLE_DATA* handleData, const char* key, const char* value)
 {
     int result;
-    if (Map_IncreaseStorageKeysValues(handleData) != 0) /*this increases handleData->count*/
+    if (Map_MakeStorageOwned(handleData) != 0)
+    {
+        result = __LINE__;
+    }
+    else if (Map_IncreaseStorageKeysValues(handleData) != 0) /*this increases handleData->count*/
     {
         result = __LINE__;
     }
     else
     {
-        if (mallocAndStrcpy_s(&(handleData->keys[handleData->count - 1]), key) != 0)
+        if (Map_CopyString(&(handleData->keys[handleData->count - 1]), key, handleData->internKeys) != 0)
         {
             Map_DecreaseStorageKeysValues(handleData);
-            LogError("unable to mallocAndStrcpy_s");
+            LogError("unable to copy the key");
             result = __LINE__;
         }
         else
         {
             if (mallocAndStrcpy_s(&(handleData->values[handleData->count - 1]), value) != 0)
             {
-                free(handleData->keys[handleData->count - 1]);
+                Map_FreeString(handleData->keys[handleData->count - 1], handleData->internKeys);
                 Map_DecreaseStorageKeysValues(handleData);
                 LogError("unable to mallocAndStrcpy_s");
                 result = __LINE__;
             }
             else
             {
+                Map_IndexAdd(handleData);
                 result = 0;
             }
         }
@@ -421,22 +924,176 @@ MAP_RESULT Map_AddOrUpdate(MAP_HANDLE handle, const char* key, const char* value
             {
                 /*Codes_SRS_MAP_02_016: [If the key already exists, then Map_AddOrUpdate shall overwrite the value of the existing key with parameter value.]*/
                 size_t index = whereIsIt - handleData->keys;
-                size_t valueLength = strlen(value);
-                /*try to realloc value of this key*/
-                char* newValue = (char*)realloc(handleData->values[index],valueLength  + 1);
-                if (newValue == NULL)
+                if (Map_MakeStorageOwned(handleData) != 0)
                 {
                     result = MAP_ERROR;
                     LOG_MAP_ERROR;
                 }
                 else
                 {
-                    memcpy(newValue, value, valueLength + 1);
-                    handleData->values[index] = newValue;
-                    /*Codes_SRS_MAP_02_019: [Otherwise, Map_AddOrUpdate shall return MAP_OK.] */
-                    result = MAP_OK;
+                    size_t valueLength = strlen(value);
+                    /*try to realloc value of this key*/
+                    char* newValue = (char*)realloc(handleData->values[index],valueLength  + 1);
+                    if (newValue == NULL)
+                    {
+                        result = MAP_ERROR;
+                        LOG_MAP_ERROR;
+                    }
+                    else
+                    {
+                        memcpy(newValue, value, valueLength + 1);
+                        handleData->values[index] = newValue;
+                        /*Codes_SRS_MAP_02_019: [Otherwise, Map_AddOrUpdate shall return MAP_OK.] */
+                        result = MAP_OK;
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+MAP_RESULT Map_Reserve(MAP_HANDLE handle, size_t capacity)
+{
+    MAP_RESULT result;
+    if (handle == NULL)
+    {
+        /*Codes_SRS_MAP_07_016: [If parameter handle is NULL then Map_Reserve shall return MAP_INVALIDARG.]*/
+        result = MAP_INVALIDARG;
+        LOG_MAP_ERROR;
+    }
+    else
+    {
+        MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA*)handle;
+        /*Codes_SRS_MAP_07_017: [Map_Reserve shall grow the storage of the map so that it can hold at least capacity pairs and return MAP_OK.]*/
+        /*Codes_SRS_MAP_07_018: [If capacity is not bigger than the storage the map already has, Map_Reserve shall return MAP_OK without changing anything.]*/
+        if (((capacity > handleData->count) && (Map_MakeStorageOwned(handleData) != 0)) ||
+            (Map_ReserveStorageKeysValues(handleData, capacity) != 0))
+        {
+            /*Codes_SRS_MAP_07_019: [If growing the storage fails, Map_Reserve shall return MAP_ERROR and leave the map unchanged.]*/
+            result = MAP_ERROR;
+            LOG_MAP_ERROR;
+        }
+        else
+        {
+            result = MAP_OK;
+        }
+    }
+    return result;
+}
+
+/*removes the pairs from position firstAdded to the end, used to undo a partially done Map_AddMany*/
+static void Map_RemoveAddedPairs(MAP_HANDLE_DATA* handleData, size_t firstAdded)
+{
+    while (handleData->count > firstAdded)
+    {
+        Map_FreeString(handleData->keys[handleData->count - 1], handleData->internKeys);
+        free(handleData->values[handleData->count - 1]);
+        handleData->count--;
+        Map_IndexRemove(handleData, handleData->count);
+    }
+}
+
+MAP_RESULT Map_AddMany(MAP_HANDLE handle, const char*const* keys, const char*const* values, size_t count)
+{
+    MAP_RESULT result;
+    if (
+        (handle == NULL) ||
+        (keys == NULL) ||
+        (values == NULL)
+        )
+    {
+        /*Codes_SRS_MAP_07_020: [If parameter handle, keys or values is NULL then Map_AddMany shall return MAP_INVALIDARG.]*/
+        result = MAP_INVALIDARG;
+        LOG_MAP_ERROR;
+    }
+    else
+    {
+        MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA*)handle;
+        size_t i;
+
+        /*everything that can be checked without allocating is checked before the map is touched*/
+        result = MAP_OK;
+        for (i = 0; (i < count) && (result == MAP_OK); i++)
+        {
+            if ((keys[i] == NULL) || (values[i] == NULL))
+            {
+                /*Codes_SRS_MAP_07_021: [If any of the keys or values is NULL then Map_AddMany shall return MAP_INVALIDARG.]*/
+                result = MAP_INVALIDARG;
+                LOG_MAP_ERROR;
+            }
+            else if (findKey(handleData, keys[i]) != NULL)
+            {
+                /*Codes_SRS_MAP_07_022: [If any of the keys already exists in the map, or appears more than once in keys, then Map_AddMany shall return MAP_KEYEXISTS.]*/
+                result = MAP_KEYEXISTS;
+            }
+            else if ((handleData->mapFilterCallback != NULL) && (handleData->mapFilterCallback(keys[i], values[i]) != 0))
+            {
+                /*Codes_SRS_MAP_07_023: [If the mapFilterCallback function is not NULL and it rejects any of the pairs, then Map_AddMany shall return MAP_FILTER_REJECT.]*/
+                result = MAP_FILTER_REJECT;
+            }
+            else
+            {
+                /*keep checking*/
+            }
+        }
+
+        if (result != MAP_OK)
+        {
+            /*Codes_SRS_MAP_07_025: [If Map_AddMany does not return MAP_OK, none of the pairs shall be added to the map.]*/
+        }
+        else if (count == 0)
+        {
+            /*nothing to add*/
+        }
+        /*Codes_SRS_MAP_07_024: [Otherwise, Map_AddMany shall grow the storage of the map once for all the pairs, add them in the order they are given and return MAP_OK.]*/
+        else if ((count > ((size_t)~(size_t)0) - handleData->count) ||
+            (Map_MakeStorageOwned(handleData) != 0) ||
+            (Map_ReserveStorageKeysValues(handleData, handleData->count + count) != 0))
+        {
+            /*Codes_SRS_MAP_07_026: [If any allocation fails, Map_AddMany shall return MAP_ERROR.]*/
+            result = MAP_ERROR;
+            LOG_MAP_ERROR;
+        }
+        else
+        {
+            size_t firstAdded = handleData->count;
+            for (i = 0; i < count; i++)
+            {
+                /*the keys already in the map were checked above, only the ones added by this call can collide now*/
+                if ((i > 0) && (findKey(handleData, keys[i]) != NULL))
+                {
+                    /*Codes_SRS_MAP_07_022: [If any of the keys already exists in the map, or appears more than once in keys, then Map_AddMany shall return MAP_KEYEXISTS.]*/
+                    result = MAP_KEYEXISTS;
+                    break;
+                }
+                else if (Map_CopyString(&(handleData->keys[handleData->count]), keys[i], handleData->internKeys) != 0)
+                {
+                    /*Codes_SRS_MAP_07_026: [If any allocation fails, Map_AddMany shall return MAP_ERROR.]*/
+                    result = MAP_ERROR;
+                    LOG_MAP_ERROR;
+                    break;
+                }
+                else if (mallocAndStrcpy_s(&(handleData->values[handleData->count]), values[i]) != 0)
+                {
+                    /*Codes_SRS_MAP_07_026: [If any allocation fails, Map_AddMany shall return MAP_ERROR.]*/
+                    Map_FreeString(handleData->keys[handleData->count], handleData->internKeys);
+                    result = MAP_ERROR;
+                    LOG_MAP_ERROR;
+                    break;
+                }
+                else
+                {
+                    handleData->count++;
+                    Map_IndexAdd(handleData);
                 }
             }
+
+            if (result != MAP_OK)
+            {
+                /*Codes_SRS_MAP_07_025: [If Map_AddMany does not return MAP_OK, none of the pairs shall be added to the map.]*/
+                Map_RemoveAddedPairs(handleData, firstAdded);
+            }
         }
     }
     return result;
@@ -468,12 +1125,21 @@ MAP_RESULT Map_Delete(MAP_HANDLE handle, const char* key)
         {
             /*Codes_SRS_MAP_02_023: [Otherwise, Map_Delete shall remove the key and its associated value from the map and return MAP_OK.]*/
             size_t index = whereIsIt - handleData->keys;
-            free(handleData->keys[index]);
-            free(handleData->values[index]);
-            memmove(handleData->keys + index, handleData->keys + index + 1, (handleData->count - index - 1)*sizeof(char*)); /*if order doesn't matter... then this can be optimized*/
-            memmove(handleData->values + index, handleData->values + index + 1, (handleData->count - index - 1)*sizeof(char*));
-            Map_DecreaseStorageKeysValues(handleData);
-            result = MAP_OK;
+            if (Map_MakeStorageOwned(handleData) != 0)
+            {
+                result = MAP_ERROR;
+                LOG_MAP_ERROR;
+            }
+            else
+            {
+                Map_FreeString(handleData->keys[index], handleData->internKeys);
+                free(handleData->values[index]);
+                memmove(handleData->keys + index, handleData->keys + index + 1, (handleData->count - index - 1)*sizeof(char*)); /*if order doesn't matter... then this can be optimized*/
+                memmove(handleData->values + index, handleData->values + index + 1, (handleData->count - index - 1)*sizeof(char*));
+                Map_DecreaseStorageKeysValues(handleData);
+                Map_IndexRemove(handleData, index);
+                result = MAP_OK;
+            }
         }
 
     }
@@ -559,6 +1225,37 @@ const char* Map_GetValueFromKey(MAP_HANDLE handle, const char* key)
     return result;
 }
 
+const char* Map_GetValueFromKeyView(MAP_HANDLE handle, STRING_VIEW key)
+{
+    const char* result;
+    /*Codes_SRS_MAP_07_010: [If parameter handle or the data of key is NULL then Map_GetValueFromKeyView returns NULL.]*/
+    if (
+        (handle == NULL) ||
+        (key.data == NULL)
+        )
+    {
+        result = NULL;
+        LogError("invalid parameter to Map_GetValueFromKeyView");
+    }
+    else
+    {
+        MAP_HANDLE_DATA * handleData = (MAP_HANDLE_DATA *)handle;
+        char** whereIsIt = findKeyView(handleData, key);
+        if (whereIsIt == NULL)
+        {
+            /*Codes_SRS_MAP_07_011: [If no stored key has exactly the characters of key, then Map_GetValueFromKeyView returns NULL.]*/
+            result = NULL;
+        }
+        else
+        {
+            /*Codes_SRS_MAP_07_012: [Otherwise, Map_GetValueFromKeyView returns the key's value.] */
+            size_t index = whereIsIt - handleData->keys;
+            result = handleData->values[index];
+        }
+    }
+    return result;
+}
+
 MAP_RESULT Map_GetInternals(MAP_HANDLE handle, const char*const** keys, const char*const** values, size_t* count)
 {
     MAP_RESULT result;
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+#include "azure_c_shared_utility/mpsc_queue.h"
+
+/* the algorithm is Dmitry Vyukov's intrusive MPSC node based queue: a producer swaps itself in as the head and then links */
+/* the previous head to itself. Between those two steps the entries pushed before are not reachable by the consumer, */
+/* mpsc_queue_pop then returns NULL and the entries show up at a later pop. */
+/* Like refcount.h, Windows uses the Interlocked functions, gcc its builtins, and single threaded platforms can define MPSC_QUEUE_ATOMIC_DONTCARE. */
+#if defined(WIN32)
+#include "windows.h"
+#define MPSC_EXCHANGE_POINTER(target, value) InterlockedExchangePointer((PVOID volatile*)(target), (value))
+#define MPSC_LOAD_POINTER(source) (*(source))
+#define MPSC_STORE_POINTER(target, value) (void)InterlockedExchangePointer((PVOID volatile*)(target), (value))
+#elif defined(__GNUC__)
+#define MPSC_EXCHANGE_POINTER(target, value) __atomic_exchange_n((target), (value), __ATOMIC_ACQ_REL)
+#define MPSC_LOAD_POINTER(source) __atomic_load_n((source), __ATOMIC_ACQUIRE)
+#define MPSC_STORE_POINTER(target, value) __atomic_store_n((target), (value), __ATOMIC_RELEASE)
+#elif defined(MPSC_QUEUE_ATOMIC_DONTCARE)
+/* single threaded platforms */
+static MPSC_QUEUE_ENTRY* exchangePointer(MPSC_QUEUE_ENTRY* volatile* target, MPSC_QUEUE_ENTRY* value)
+{
+    MPSC_QUEUE_ENTRY* result = *target;
+    *target = value;
+    return result;
+}
+#define MPSC_EXCHANGE_POINTER(target, value) exchangePointer((target), (value))
+#define MPSC_LOAD_POINTER(source) (*(source))
+#define MPSC_STORE_POINTER(target, value) (*(target) = (value))
+#else
+#error do not know how to atomically exchange a pointer. Platform support needs to be extended to your platform.
+#endif
+
+void mpsc_queue_init(MPSC_QUEUE* queue)
+{
+    /* Codes_SRS_MPSC_QUEUE_07_001: [mpsc_queue_init shall initialize queue as an empty queue.] */
+    queue->stub.next = NULL;
+    queue->head = &queue->stub;
+    queue->tail = &queue->stub;
+}
+
+void mpsc_queue_push(MPSC_QUEUE* queue, MPSC_QUEUE_ENTRY* entry)
+{
+    MPSC_QUEUE_ENTRY* previous;
+
+    /* Codes_SRS_MPSC_QUEUE_07_002: [mpsc_queue_push shall add entry at the end of the queue.] */
+    /* Codes_SRS_MPSC_QUEUE_07_003: [mpsc_queue_push shall not take a lock and may be called from any number of threads at the same time.] */
+    entry->next = NULL;
+    previous = (MPSC_QUEUE_ENTRY*)MPSC_EXCHANGE_POINTER(&queue->head, entry);
+    MPSC_STORE_POINTER(&previous->next, entry);
+}
+
+MPSC_QUEUE_ENTRY* mpsc_queue_pop(MPSC_QUEUE* queue)
+{
+    MPSC_QUEUE_ENTRY* result;
+    MPSC_QUEUE_ENTRY* tail = queue->tail;
+    MPSC_QUEUE_ENTRY* next = (MPSC_QUEUE_ENTRY*)MPSC_LOAD_POINTER(&tail->next);
+
+    if (tail == &queue->stub)
+    {
+        /* the stub is not an entry, skip it */
+        if (next != NULL)
+        {
+            queue->tail = next;
+            tail = next;
+            next = (MPSC_QUEUE_ENTRY*)MPSC_LOAD_POINTER(&next->next);
+        }
+    }
+
+    if (tail == &queue->stub)
+    {
+        /* Codes_SRS_MPSC_QUEUE_07_005: [If the queue is empty, mpsc_queue_pop shall return NULL.] */
+        result = NULL;
+    }
+    else if (next != NULL)
+    {
+        /* Codes_SRS_MPSC_QUEUE_07_004: [mpsc_queue_pop shall remove the oldest entry from the queue and return it.] */
+        queue->tail = next;
+        result = tail;
+    }
+    else if (tail != (MPSC_QUEUE_ENTRY*)MPSC_LOAD_POINTER(&queue->head))
+    {
+        /* Codes_SRS_MPSC_QUEUE_07_006: [If a producer has not finished linking its entry, mpsc_queue_pop shall return NULL, the entries are returned by a later call.] */
+        result = NULL;
+    }
+    else
+    {
+        /* tail is the last entry, putting the stub back behind it lets tail be removed without touching head */
+        mpsc_queue_push(queue, &queue->stub);
+        next = (MPSC_QUEUE_ENTRY*)MPSC_LOAD_POINTER(&tail->next);
+        if (next != NULL)
+        {
+            queue->tail = next;
+            result = tail;
+        }
+        else
+        {
+            /* Codes_SRS_MPSC_QUEUE_07_006: [If a producer has not finished linking its entry, mpsc_queue_pop shall return NULL, the entries are returned by a later call.] */
+            result = NULL;
+        }
+    }
+
+    return result;
+}
+
+int mpsc_queue_is_empty(MPSC_QUEUE* queue)
+{
+    /* Codes_SRS_MPSC_QUEUE_07_007: [mpsc_queue_is_empty shall return a non-zero value if nothing was pushed that was not popped yet, and 0 otherwise.] */
+    return ((queue->tail == &queue->stub) && (MPSC_LOAD_POINTER(&queue->stub.next) == NULL) && (MPSC_LOAD_POINTER(&queue->head) == &queue->stub));
+}
@@ -5,6 +5,7 @@
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/vector.h"
+#include "azure_c_shared_utility/string_intern.h"
 
 typedef struct OPTION_TAG
 {
@@ -82,8 +83,9 @@ OPTIONHANDLER_RESULT OptionHandler_AddOption(OPTIONHANDLER_HANDLE handle, const
     }
     else
     {
-        const char* cloneOfName;
-        if (mallocAndStrcpy_s((char**)&cloneOfName, name) != 0)
+        /*Codes_SRS_OPTIONHANDLER_07_001: [ OptionHandler_AddOption shall save name by calling string_intern_acquire, so that all the option handlers share one copy of it. ]*/
+        const char* cloneOfName = string_intern_acquire(name);
+        if (cloneOfName == NULL)
         {
             /*Codes_SRS_OPTIONHANDLER_02_009: [ Otherwise, OptionHandler_AddProperty shall succeed and return OPTIONHANDLER_ERROR. ]*/
             LogError("unable to clone name");
@@ -97,7 +99,7 @@ OPTIONHANDLER_RESULT OptionHandler_AddOption(OPTIONHANDLER_HANDLE handle, const
             {
                 /*Codes_SRS_OPTIONHANDLER_02_009: [ Otherwise, OptionHandler_AddProperty shall succeed and return OPTIONHANDLER_ERROR. ]*/
                 LogError("unable to clone value");
-                free((void*)cloneOfName);
+                string_intern_release(cloneOfName);
                 result = OPTIONHANDLER_ERROR;
             }
             else
@@ -111,7 +113,7 @@ OPTIONHANDLER_RESULT OptionHandler_AddOption(OPTIONHANDLER_HANDLE handle, const
                     /*Codes_SRS_OPTIONHANDLER_02_009: [ Otherwise, OptionHandler_AddProperty shall succeed and return OPTIONHANDLER_ERROR. ]*/
                     LogError("unable to VECTOR_push_back");
                     handle->destroyOption(name, cloneOfValue);
-                    free((void*)cloneOfName);
+                    string_intern_release(cloneOfName);
                     result = OPTIONHANDLER_ERROR;
                 }
                 else
@@ -181,7 +183,7 @@ void OptionHandler_Destroy(OPTIONHANDLER_HANDLE handle)
         {
             OPTION* option = (OPTION*)VECTOR_element(handle->storage, i);
             handle->destroyOption(option->name, option->storage);
-            free((void*)option->name);
+            string_intern_release(option->name);
         }
 
         VECTOR_destroy(handle->storage);
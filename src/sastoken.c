@@ -12,29 +12,11 @@
 #include "azure_c_shared_utility/base64.h"
 #include "azure_c_shared_utility/agenttime.h"
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/string_view.h"
 #include "azure_c_shared_utility/buffer_.h"
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 
-static double getExpiryValue(const char* expiryASCII)
-{
-    double value = 0;
-    size_t i = 0;
-    for (i = 0; expiryASCII[i] != '\0'; i++)
-    {
-        if (expiryASCII[i] >= '0' && expiryASCII[i] <= '9')
-        {
-            value = value * 10 + (expiryASCII[i] - '0');
-        }
-        else
-        {
-            value = 0;
-            break;
-        }
-    }
-    return value;
-}
-
 bool SASToken_Validate(STRING_HANDLE sasToken)
 {
     bool result;
@@ -155,42 +137,27 @@ bool SASToken_Validate(STRING_HANDLE sasToken)
             }
             else
             {
-                char* expiryASCII = malloc(seStop - seStart + 1);
-                /*Codes_SRS_SASTOKEN_25_031: [**If malloc fails during validation then SASToken_Validate shall return false.**]***/
-                if (expiryASCII == NULL)
+                /*Codes_SRS_SASTOKEN_07_001: [**SASToken_Validate shall read the expiry in place in the token, without allocating memory.**]***/
+                size_t expiry;
+                if ((STRING_VIEW_to_size_t(STRING_VIEW_from_n(sasTokenArray + seStart, (size_t)(seStop - seStart)), &expiry) != 0) ||
+                    (expiry == 0))
                 {
+                    /*Codes_SRS_SASTOKEN_25_029: [**SASToken_validate shall check for expiry time from token and if token has expired then would return false **]***/
                     result = false;
                 }
                 else
                 {
-                    double expiry;
-                    for (i = seStart; i < seStop; i++)
-                    {
-                        expiryASCII[i - seStart] = sasTokenArray[i];
-                    }
-                    expiryASCII[seStop - seStart] = '\0';
-
-                    expiry = getExpiryValue(expiryASCII);
-                    /*Codes_SRS_SASTOKEN_25_029: [**SASToken_validate shall check for expiry time from token and if token has expired then would return false **]***/
-                    if (expiry <= 0)
+                    double secSinceEpoch = get_difftime(get_time(NULL), (time_t)0);
+                    if ((double)expiry < secSinceEpoch)
                     {
+                        /*Codes_SRS_SASTOKEN_25_029: [**SASToken_validate shall check for expiry time from token and if token has expired then would return false **]***/
                         result = false;
                     }
                     else
                     {
-                        double secSinceEpoch = get_difftime(get_time(NULL), (time_t)0);
-                        if (expiry < secSinceEpoch)
-                        {
-                            /*Codes_SRS_SASTOKEN_25_029: [**SASToken_validate shall check for expiry time from token and if token has expired then would return false **]***/
-                            result = false;
-                        }
-                        else
-                        {
-                            /*Codes_SRS_SASTOKEN_25_030: [**SASToken_validate shall return true only if the format is obeyed and the token has not yet expired **]***/
-                            result = true;
-                        }
+                        /*Codes_SRS_SASTOKEN_25_030: [**SASToken_validate shall return true only if the format is obeyed and the token has not yet expired **]***/
+                        result = true;
                     }
-                    free(expiryASCII);
                 }
             }
         }
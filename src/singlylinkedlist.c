@@ -19,23 +19,77 @@ typedef struct LIST_ITEM_INSTANCE_TAG
 typedef struct SINGLYLINKEDLIST_INSTANCE_TAG
 {
     LIST_ITEM_INSTANCE* head;
+    LIST_ITEM_INSTANCE* tail;
+    /* removed nodes kept for the next adds, only for lists made by singlylinkedlist_create_pooled */
+    LIST_ITEM_INSTANCE* pooled_items;
+    size_t pooled_item_count;
+    size_t max_pooled_items;
 } LIST_INSTANCE;
 
 SINGLYLINKEDLIST_HANDLE singlylinkedlist_create(void)
+{
+    /* Codes_SRS_LIST_01_001: [singlylinkedlist_create shall create a new list and return a non-NULL handle on success.] */
+    /* Codes_SRS_LIST_01_002: [If any error occurs during the list creation, singlylinkedlist_create shall return NULL.] */
+    return singlylinkedlist_create_pooled(0);
+}
+
+SINGLYLINKEDLIST_HANDLE singlylinkedlist_create_pooled(size_t max_pooled_items)
 {
     LIST_INSTANCE* result;
 
-    /* Codes_SRS_LIST_01_001: [singlylinkedlist_create shall create a new list and return a non-NULL handle on success.] */
+    /* Codes_SRS_LIST_07_001: [singlylinkedlist_create_pooled shall create a new list that keeps up to max_pooled_items removed nodes to reuse them for the items added next, and return a non-NULL handle on success.] */
     result = (LIST_INSTANCE*)malloc(sizeof(LIST_INSTANCE));
     if (result != NULL)
     {
-        /* Codes_SRS_LIST_01_002: [If any error occurs during the list creation, singlylinkedlist_create shall return NULL.] */
+        /* Codes_SRS_LIST_07_002: [If any error occurs during the list creation, singlylinkedlist_create_pooled shall return NULL.] */
         result->head = NULL;
+        result->tail = NULL;
+        result->pooled_items = NULL;
+        result->pooled_item_count = 0;
+        result->max_pooled_items = max_pooled_items;
     }
 
     return result;
 }
 
+static LIST_ITEM_INSTANCE* allocate_item(LIST_INSTANCE* list_instance, const void* item)
+{
+    LIST_ITEM_INSTANCE* result;
+    if (list_instance->pooled_items != NULL)
+    {
+        result = list_instance->pooled_items;
+        list_instance->pooled_items = (LIST_ITEM_INSTANCE*)result->next;
+        list_instance->pooled_item_count--;
+    }
+    else
+    {
+        result = (LIST_ITEM_INSTANCE*)malloc(sizeof(LIST_ITEM_INSTANCE));
+    }
+
+    if (result != NULL)
+    {
+        result->next = NULL;
+        result->item = item;
+    }
+
+    return result;
+}
+
+static void release_item(LIST_INSTANCE* list_instance, LIST_ITEM_INSTANCE* item)
+{
+    if (list_instance->pooled_item_count < list_instance->max_pooled_items)
+    {
+        item->next = list_instance->pooled_items;
+        item->item = NULL;
+        list_instance->pooled_items = item;
+        list_instance->pooled_item_count++;
+    }
+    else
+    {
+        free(item);
+    }
+}
+
 void singlylinkedlist_destroy(SINGLYLINKEDLIST_HANDLE list)
 {
     /* Codes_SRS_LIST_01_004: [If the list argument is NULL, no freeing of resources shall occur.] */
@@ -50,6 +104,13 @@ void singlylinkedlist_destroy(SINGLYLINKEDLIST_HANDLE list)
             free(current_item);
         }
 
+        while (list_instance->pooled_items != NULL)
+        {
+            LIST_ITEM_INSTANCE* current_item = list_instance->pooled_items;
+            list_instance->pooled_items = (LIST_ITEM_INSTANCE*)current_item->next;
+            free(current_item);
+        }
+
         /* Codes_SRS_LIST_01_003: [singlylinkedlist_destroy shall free all resources associated with the list identified by the handle argument.] */
         free(list_instance);
     }
@@ -68,7 +129,7 @@ LIST_ITEM_HANDLE singlylinkedlist_add(SINGLYLINKEDLIST_HANDLE list, const void*
     else
     {
         LIST_INSTANCE* list_instance = (LIST_INSTANCE*)list;
-        result = (LIST_ITEM_INSTANCE*)malloc(sizeof(LIST_ITEM_INSTANCE));
+        result = allocate_item(list_instance, item);
 
         if (result == NULL)
         {
@@ -78,22 +139,51 @@ LIST_ITEM_HANDLE singlylinkedlist_add(SINGLYLINKEDLIST_HANDLE list, const void*
         else
         {
             /* Codes_SRS_LIST_01_005: [singlylinkedlist_add shall add one item to the tail of the list and on success it shall return a handle to the added item.] */
-            result->next = NULL;
-            result->item = item;
-
-            if (list_instance->head == NULL)
+            /* Codes_SRS_LIST_07_003: [singlylinkedlist_add shall not walk the list to find its tail.] */
+            if (list_instance->tail == NULL)
             {
                 list_instance->head = result;
             }
             else
             {
-                LIST_ITEM_INSTANCE* current = list_instance->head;
-                while (current->next != NULL)
-                {
-                    current = (LIST_ITEM_INSTANCE*)current->next;
-                }
+                list_instance->tail->next = result;
+            }
+
+            list_instance->tail = result;
+        }
+    }
+
+    return result;
+}
+
+LIST_ITEM_HANDLE singlylinkedlist_add_head(SINGLYLINKEDLIST_HANDLE list, const void* item)
+{
+    LIST_ITEM_INSTANCE* result;
+
+    /* Codes_SRS_LIST_07_005: [If any of the arguments is NULL, singlylinkedlist_add_head shall not add the item to the list and return NULL.] */
+    if ((list == NULL) ||
+        (item == NULL))
+    {
+        result = NULL;
+    }
+    else
+    {
+        LIST_INSTANCE* list_instance = (LIST_INSTANCE*)list;
+        result = allocate_item(list_instance, item);
 
-                current->next = result;
+        if (result == NULL)
+        {
+            /* Codes_SRS_LIST_07_006: [If allocating the new list node fails, singlylinkedlist_add_head shall return NULL.] */
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_LIST_07_004: [singlylinkedlist_add_head shall add one item to the head of the list and on success it shall return a handle to the added item.] */
+            result->next = list_instance->head;
+            list_instance->head = result;
+            if (list_instance->tail == NULL)
+            {
+                list_instance->tail = result;
             }
         }
     }
@@ -130,7 +220,12 @@ int singlylinkedlist_remove(SINGLYLINKEDLIST_HANDLE list, LIST_ITEM_HANDLE item)
                     list_instance->head = (LIST_ITEM_INSTANCE*)current_item->next;
                 }
 
-                free(current_item);
+                if (list_instance->tail == current_item)
+                {
+                    list_instance->tail = previous_item;
+                }
+
+                release_item(list_instance, current_item);
 
                 break;
             }
@@ -153,6 +248,42 @@ int singlylinkedlist_remove(SINGLYLINKEDLIST_HANDLE list, LIST_ITEM_HANDLE item)
     return result;
 }
 
+int singlylinkedlist_remove_head(SINGLYLINKEDLIST_HANDLE list)
+{
+    int result;
+
+    if (list == NULL)
+    {
+        /* Codes_SRS_LIST_07_008: [If list is NULL, singlylinkedlist_remove_head shall fail and return a non-zero value.] */
+        result = __LINE__;
+    }
+    else
+    {
+        LIST_INSTANCE* list_instance = (LIST_INSTANCE*)list;
+        LIST_ITEM_INSTANCE* head_item = list_instance->head;
+
+        if (head_item == NULL)
+        {
+            /* Codes_SRS_LIST_07_009: [If the list is empty, singlylinkedlist_remove_head shall fail and return a non-zero value.] */
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_LIST_07_007: [singlylinkedlist_remove_head shall remove the head item of the list and on success it shall return 0.] */
+            list_instance->head = (LIST_ITEM_INSTANCE*)head_item->next;
+            if (list_instance->head == NULL)
+            {
+                list_instance->tail = NULL;
+            }
+
+            release_item(list_instance, head_item);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
 LIST_ITEM_HANDLE singlylinkedlist_get_head_item(SINGLYLINKEDLIST_HANDLE list)
 {
     LIST_ITEM_HANDLE result;
@@ -0,0 +1,323 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/string_intern.h"
+#include "azure_c_shared_utility/string_hash.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/refcount.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+/* the lock is created by the first string_intern_acquire, the threads racing to do that agree on one lock by compare and swap. */
+/* Like refcount.h, Windows uses the Interlocked functions, gcc its builtins, and single threaded platforms can define REFCOUNT_ATOMIC_DONTCARE. */
+#if defined(WIN32)
+#include "windows.h"
+#define STRING_INTERN_LOAD_LOCK() ((LOCK_HANDLE)InterlockedCompareExchangePointer((PVOID volatile*)&stringInternLock, NULL, NULL))
+#define STRING_INTERN_SET_LOCK_IF_NULL(newLock) ((LOCK_HANDLE)InterlockedCompareExchangePointer((PVOID volatile*)&stringInternLock, (newLock), NULL))
+#elif defined(__GNUC__)
+#define STRING_INTERN_LOAD_LOCK() ((LOCK_HANDLE)__atomic_load_n(&stringInternLock, __ATOMIC_ACQUIRE))
+#define STRING_INTERN_SET_LOCK_IF_NULL(newLock) ((LOCK_HANDLE)__sync_val_compare_and_swap(&stringInternLock, NULL, (newLock)))
+#elif defined(REFCOUNT_ATOMIC_DONTCARE)
+/* single threaded platforms */
+static LOCK_HANDLE setLockIfNull(LOCK_HANDLE volatile* target, LOCK_HANDLE newLock)
+{
+    LOCK_HANDLE result = *target;
+    if (result == NULL)
+    {
+        *target = newLock;
+    }
+    return result;
+}
+#define STRING_INTERN_LOAD_LOCK() (stringInternLock)
+#define STRING_INTERN_SET_LOCK_IF_NULL(newLock) setLockIfNull(&stringInternLock, (newLock))
+#else
+#error do not know how to atomically compare and swap a pointer. Platform support needs to be extended to your platform.
+#endif
+
+/* the characters live right after the header, in the same allocation, string_intern_release finds its way back with offsetof */
+/* refCount is atomic because the strings left over by string_intern_deinit are released without the lock */
+typedef struct INTERNED_STRING_TAG
+{
+    struct INTERNED_STRING_TAG* next;
+    size_t hash;
+    COUNT_TYPE refCount;
+    int isInTable;
+    char value[1];
+} INTERNED_STRING;
+
+#define INTERNED_STRING_HEADER_SIZE offsetof(INTERNED_STRING, value)
+#define INTERNED_STRING_FROM_VALUE(interned) ((INTERNED_STRING*)((char*)(interned) - INTERNED_STRING_HEADER_SIZE))
+
+/* the table starts in static storage, so init does not allocate. It doubles when there are more strings than buckets */
+#define STRING_INTERN_INITIAL_BUCKET_COUNT 32
+
+static INTERNED_STRING* initialBuckets[STRING_INTERN_INITIAL_BUCKET_COUNT];
+static INTERNED_STRING** buckets = initialBuckets;
+static size_t bucketCount = STRING_INTERN_INITIAL_BUCKET_COUNT;
+static size_t stringCount = 0;
+static LOCK_HANDLE volatile stringInternLock = NULL;
+
+static INTERNED_STRING* createInternedString(const char* source, size_t length, size_t hash)
+{
+    INTERNED_STRING* result;
+    if (length > ((size_t)~(size_t)0) - INTERNED_STRING_HEADER_SIZE - 1)
+    {
+        LogError("string too long to intern");
+        result = NULL;
+    }
+    else if ((result = (INTERNED_STRING*)malloc(INTERNED_STRING_HEADER_SIZE + length + 1)) == NULL)
+    {
+        LogError("unable to malloc");
+    }
+    else
+    {
+        result->next = NULL;
+        result->hash = hash;
+        result->refCount = 1;
+        result->isInTable = 0;
+        (void)memcpy(result->value, source, length + 1);
+    }
+    return result;
+}
+
+/* a table that cannot grow is only slower, so failing to allocate the bigger one is not an error */
+static void growBuckets(void)
+{
+    size_t newBucketCount = bucketCount * 2;
+    INTERNED_STRING** newBuckets;
+    if ((newBucketCount < bucketCount) ||
+        (newBucketCount > ((size_t)~(size_t)0) / sizeof(INTERNED_STRING*)) ||
+        ((newBuckets = (INTERNED_STRING**)malloc(newBucketCount * sizeof(INTERNED_STRING*))) == NULL))
+    {
+        LogError("unable to grow the string intern table, staying at %lu buckets", (unsigned long)bucketCount);
+    }
+    else
+    {
+        size_t i;
+        (void)memset(newBuckets, 0, newBucketCount * sizeof(INTERNED_STRING*));
+        for (i = 0; i < bucketCount; i++)
+        {
+            INTERNED_STRING* current = buckets[i];
+            while (current != NULL)
+            {
+                INTERNED_STRING* next = current->next;
+                size_t index = current->hash & (newBucketCount - 1);
+                current->next = newBuckets[index];
+                newBuckets[index] = current;
+                current = next;
+            }
+        }
+        if (buckets != initialBuckets)
+        {
+            free(buckets);
+        }
+        else
+        {
+            /*string_intern_deinit goes back to the static buckets, they must not point to the moved strings*/
+            (void)memset(initialBuckets, 0, sizeof(initialBuckets));
+        }
+        buckets = newBuckets;
+        bucketCount = newBucketCount;
+    }
+}
+
+/*returns the lock of the table, creating it the first time, NULL if it cannot be created*/
+static LOCK_HANDLE getStringInternLock(void)
+{
+    LOCK_HANDLE result = STRING_INTERN_LOAD_LOCK();
+    if (result == NULL)
+    {
+        LOCK_HANDLE newLock = Lock_Init();
+        if (newLock == NULL)
+        {
+            LogError("unable to Lock_Init");
+        }
+        else if ((result = STRING_INTERN_SET_LOCK_IF_NULL(newLock)) != NULL)
+        {
+            /*another thread created the lock first, that one is used*/
+            (void)Lock_Deinit(newLock);
+        }
+        else
+        {
+            result = newLock;
+        }
+    }
+    return result;
+}
+
+int string_intern_init(void)
+{
+    int result;
+    /*Codes_SRS_STRING_INTERN_07_001: [string_intern_init shall create the lock that makes the table thread safe and return 0.]*/
+    /*Codes_SRS_STRING_INTERN_07_002: [If the module is already initialized, string_intern_init shall return 0 without changing anything.]*/
+    if (getStringInternLock() == NULL)
+    {
+        /*Codes_SRS_STRING_INTERN_07_003: [If creating the lock fails, string_intern_init shall fail and return a non-zero value.]*/
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+void string_intern_deinit(void)
+{
+    /*Codes_SRS_STRING_INTERN_07_005: [If the module is not initialized, string_intern_deinit shall do nothing.]*/
+    if (stringInternLock != NULL)
+    {
+        size_t i;
+        /*Codes_SRS_STRING_INTERN_07_004: [string_intern_deinit shall empty the table and destroy the lock. The strings that are still acquired stay valid until they are released.]*/
+        for (i = 0; i < bucketCount; i++)
+        {
+            INTERNED_STRING* current = buckets[i];
+            while (current != NULL)
+            {
+                INTERNED_STRING* next = current->next;
+                current->next = NULL;
+                current->isInTable = 0;
+                current = next;
+            }
+            buckets[i] = NULL;
+        }
+        if (buckets != initialBuckets)
+        {
+            free(buckets);
+            buckets = initialBuckets;
+            bucketCount = STRING_INTERN_INITIAL_BUCKET_COUNT;
+        }
+        stringCount = 0;
+
+        (void)Lock_Deinit(stringInternLock);
+        stringInternLock = NULL;
+    }
+}
+
+const char* string_intern_acquire(const char* source)
+{
+    const char* result;
+    if (source == NULL)
+    {
+        /*Codes_SRS_STRING_INTERN_07_006: [If source is NULL, string_intern_acquire shall fail and return NULL.]*/
+        LogError("invalid arg: source is NULL");
+        result = NULL;
+    }
+    else
+    {
+        size_t length;
+        size_t hash = string_hash(source, &length);
+        /*Codes_SRS_STRING_INTERN_07_007: [If the module is not initialized, string_intern_acquire shall initialize it first.]*/
+        LOCK_HANDLE lock = getStringInternLock();
+        /*Codes_SRS_STRING_INTERN_07_008: [string_intern_acquire shall look for and add to the table under the lock.]*/
+        if ((lock == NULL) || (Lock(lock) != LOCK_OK))
+        {
+            /*Codes_SRS_STRING_INTERN_07_011: [If the lock or any allocation fails, string_intern_acquire shall fail and return NULL.]*/
+            LogError("unable to Lock");
+            result = NULL;
+        }
+        else
+        {
+            size_t index = hash & (bucketCount - 1);
+            INTERNED_STRING* current = buckets[index];
+            while ((current != NULL) &&
+                ((current->hash != hash) || (strcmp(current->value, source) != 0)))
+            {
+                current = current->next;
+            }
+
+            if (current != NULL)
+            {
+                /*Codes_SRS_STRING_INTERN_07_009: [If the table already has the same characters, string_intern_acquire shall increment their reference count and return the same pointer as before.]*/
+                (void)INC_REF_VAR(current->refCount);
+                result = current->value;
+            }
+            else if ((current = createInternedString(source, length, hash)) == NULL)
+            {
+                /*Codes_SRS_STRING_INTERN_07_011: [If the lock or any allocation fails, string_intern_acquire shall fail and return NULL.]*/
+                result = NULL;
+            }
+            else
+            {
+                /*Codes_SRS_STRING_INTERN_07_010: [Otherwise string_intern_acquire shall add a copy of source to the table with a reference count of 1 and return it.]*/
+                current->isInTable = 1;
+                current->next = buckets[index];
+                buckets[index] = current;
+                stringCount++;
+                if (stringCount > bucketCount)
+                {
+                    growBuckets();
+                }
+                result = current->value;
+            }
+            (void)Unlock(lock);
+        }
+    }
+    return result;
+}
+
+void string_intern_release(const char* interned)
+{
+    /*Codes_SRS_STRING_INTERN_07_012: [If interned is NULL, string_intern_release shall do nothing.]*/
+    if (interned != NULL)
+    {
+        INTERNED_STRING* internedString = INTERNED_STRING_FROM_VALUE(interned);
+        if (!internedString->isInTable)
+        {
+            /*left over by string_intern_deinit, nothing but the reference count is shared anymore*/
+            if (DEC_REF_VAR(internedString->refCount) == DEC_RETURN_ZERO)
+            {
+                free(internedString);
+            }
+        }
+        /*Codes_SRS_STRING_INTERN_07_014: [string_intern_release shall update the table under the lock. If the lock fails the string is not released.]*/
+        else if (Lock(stringInternLock) != LOCK_OK)
+        {
+            LogError("unable to Lock, the string is not released");
+        }
+        else
+        {
+            /*Codes_SRS_STRING_INTERN_07_013: [string_intern_release shall decrement the reference count of interned, when it reaches 0 the string shall be removed from the table and freed.]*/
+            if (DEC_REF_VAR(internedString->refCount) == DEC_RETURN_ZERO)
+            {
+                INTERNED_STRING** link = &buckets[internedString->hash & (bucketCount - 1)];
+                while (*link != internedString)
+                {
+                    link = &(*link)->next;
+                }
+                *link = internedString->next;
+                stringCount--;
+                free(internedString);
+            }
+            (void)Unlock(stringInternLock);
+        }
+    }
+}
+
+size_t string_intern_get_count(void)
+{
+    size_t result;
+    if (stringInternLock == NULL)
+    {
+        /*Codes_SRS_STRING_INTERN_07_016: [If the module is not initialized, string_intern_get_count shall return 0.]*/
+        result = 0;
+    }
+    else if (Lock(stringInternLock) != LOCK_OK)
+    {
+        LogError("unable to Lock");
+        result = 0;
+    }
+    else
+    {
+        /*Codes_SRS_STRING_INTERN_07_015: [string_intern_get_count shall return how many different strings are in the table.]*/
+        result = stringCount;
+        (void)Unlock(stringInternLock);
+    }
+    return result;
+}
@@ -23,6 +23,7 @@ typedef struct STRING_TOKEN_TAG
     const char* inputString;
     const char* currentPos;
     size_t sizeOfinputString;
+    bool ownsInputString; /*false when the tokenizer was created over a view*/
 } STRING_TOKEN;
 
 STRING_TOKENIZER_HANDLE STRING_TOKENIZER_create(STRING_HANDLE handle)
@@ -71,10 +72,106 @@ extern STRING_TOKENIZER_HANDLE STRING_TOKENIZER_create_from_char(const char* inp
         result->inputString = inputStringToMalloc;
         result->currentPos = result->inputString; //Current Pos will point to the initial position of Token.
         result->sizeOfinputString = strlen(result->inputString); //Calculate Size of Current String
+        result->ownsInputString = true;
     }
     return (STRING_TOKENIZER_HANDLE)result;
 }
 
+STRING_TOKENIZER_HANDLE STRING_TOKENIZER_create_from_view(STRING_VIEW input)
+{
+    STRING_TOKEN *result;
+
+    /* Codes_SRS_STRING_TOKENIZER_07_004: [STRING_TOKENIZER_create_from_view shall return NULL if the data of input is NULL.] */
+    if (input.data == NULL)
+    {
+        LogError("Invalid Argument. input cannot be NULL.");
+        result = NULL;
+    }
+    else if ((result = (STRING_TOKEN*)malloc(sizeof(STRING_TOKEN))) == NULL)
+    {
+        /* Codes_SRS_STRING_TOKENIZER_07_006: [STRING_TOKENIZER_create_from_view shall return NULL on any error that is encountered.] */
+        LogError("Memory Allocation failed. Cannot allocate STRING_TOKENIZER.");
+    }
+    else
+    {
+        /* Codes_SRS_STRING_TOKENIZER_07_005: [STRING_TOKENIZER_create_from_view shall allocate a new STRING_TOKENIZER_HANDLE that refers to the characters of input without copying them, with the current position pointing at the beginning of input.] */
+        result->inputString = input.data;
+        result->currentPos = result->inputString;
+        result->sizeOfinputString = input.length;
+        result->ownsInputString = false;
+    }
+    return (STRING_TOKENIZER_HANDLE)result;
+}
+
+static bool isDelimiter(char c, const char* delimiters, size_t delimitterSize)
+{
+    size_t j;
+    bool result = false;
+    for (j = 0; j < delimitterSize; j++)
+    {
+        if (c == delimiters[j])
+        {
+            result = true;
+            break;
+        }
+    }
+    return result;
+}
+
+/*moves the current position over the delimiters that precede the next token and measures that token. The input is never read past sizeOfinputString,
+so it does not need to be '\0' terminated. Returns 0 if there is a token*/
+static int findNextToken(STRING_TOKEN* token, const char* delimiters, size_t* tokenLength, bool* foundDelimitter)
+{
+    int result;
+    /* Codes_SRS_STRING_04_011: [Each subsequent call to STRING_TOKENIZER_get_next_token starts searching from the saved position on t and behaves as described above.] */
+    size_t remainingInputStringSize = token->sizeOfinputString - (token->currentPos - token->inputString);
+    size_t delimitterSize = strlen(delimiters);
+
+    /* First Check if we reached the end of the string*/
+    /* Codes_SRS_STRING_TOKENIZER_04_014: [STRING_TOKENIZER_get_next_token shall return nonzero value if t contains an empty string.] */
+    if (remainingInputStringSize == 0)
+    {
+        result = __LINE__;
+    }
+    else if (delimitterSize == 0)
+    {
+        LogError("Empty delimiters parameter.");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t i;
+        /* Codes_SRS_STRING_04_005: [STRING_TOKENIZER_get_next_token searches the string inside STRING_TOKENIZER_HANDLE for the first character that is NOT contained in the current delimiter] */
+        /* Codes_SRS_STRING_04_007: [If such a character is found, STRING_TOKENIZER_get_next_token consider it as the start of a token.] */
+        for (i = 0; (i < remainingInputStringSize) && isDelimiter(token->currentPos[i], delimiters, delimitterSize); i++)
+        {
+        }
+
+        //At this point update Current Pos to the character of the last token found or end of String.
+        token->currentPos += i;
+        remainingInputStringSize -= i;
+
+        /* Codes_SRS_STRING_04_006: [If no such character is found, then STRING_TOKENIZER_get_next_token shall return a nonzero Value (You've reach the end of the string or the string consists with only delimiters).] */
+        if (remainingInputStringSize == 0)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            /*Codes_SRS_STRING_04_008: [STRING_TOKENIZER_get_next_token than searches from the start of a token for a character that is contained in the delimiters string.] */
+            /* Codes_SRS_STRING_04_009: [If no such character is found, STRING_TOKENIZER_get_next_token extends the current token to the end of the string inside t, copies the token to output and returns 0.] */
+            for (i = 0; (i < remainingInputStringSize) && !isDelimiter(token->currentPos[i], delimiters, delimitterSize); i++)
+            {
+            }
+
+            *tokenLength = i;
+            *foundDelimitter = (i < remainingInputStringSize);
+            result = 0;
+        }
+    }
+    return result;
+}
+
 int STRING_TOKENIZER_get_next_token(STRING_TOKENIZER_HANDLE tokenizer, STRING_HANDLE output, const char* delimiters)
 {
     int result;
@@ -83,112 +180,59 @@ int STRING_TOKENIZER_get_next_token(STRING_TOKENIZER_HANDLE tokenizer, STRING_HA
     {
         result = __LINE__;
     }
-    else 
+    else
     {
         STRING_TOKEN* token = (STRING_TOKEN*)tokenizer;
-        /* Codes_SRS_STRING_04_011: [Each subsequent call to STRING_TOKENIZER_get_next_token starts searching from the saved position on t and behaves as described above.] */
-        size_t remainingInputStringSize = token->sizeOfinputString - (token->currentPos - token->inputString);
-        size_t delimitterSize = strlen(delimiters);
+        size_t amountOfCharactersToCopy;
+        bool foundDelimitter;
 
-        /* First Check if we reached the end of the string*/
-        /* Codes_SRS_STRING_TOKENIZER_04_014: [STRING_TOKENIZER_get_next_token shall return nonzero value if t contains an empty string.] */
-        if (remainingInputStringSize == 0)
+        if (findNextToken(token, delimiters, &amountOfCharactersToCopy, &foundDelimitter) != 0)
         {
             result = __LINE__;
         }
-        else if (delimitterSize == 0)
+        /* Codes_SRS_STRING_04_010: [If such a character is found, STRING_TOKENIZER_get_next_token consider it the end of the token and copy it's content to output, updates the current position inside t to the next character and returns 0.] */
+        else if (STRING_copy_n(output, token->currentPos, amountOfCharactersToCopy) != 0)
         {
-            LogError("Empty delimiters parameter.");
+            LogError("Problem copying token to output String.");
             result = __LINE__;
         }
         else
         {
-            size_t i;
-            /* Codes_SRS_STRING_04_005: [STRING_TOKENIZER_get_next_token searches the string inside STRING_TOKENIZER_HANDLE for the first character that is NOT contained in the current delimiter] */
-            for (i = 0; i < remainingInputStringSize; i++)
-            {
-                size_t j;
-
-                bool foundDelimitter = false;
-                for (j = 0; j < delimitterSize; j++)
-                {
-                    if (token->currentPos[i] == delimiters[j])
-                    {
-                        foundDelimitter = true;
-                        break;
-                    }
-                }
-
-                /* Codes_SRS_STRING_04_007: [If such a character is found, STRING_TOKENIZER_get_next_token consider it as the start of a token.] */
-                if (!foundDelimitter)
-                {
-                    break;
-                }
-            }
+            //Update the Current position, past the delimiter if there was one.
+            token->currentPos += amountOfCharactersToCopy + (foundDelimitter ? 1 : 0);
+            result = 0; //Result will be on the output.
+        }
+    }
 
-            /* Codes_SRS_STRING_04_006: [If no such character is found, then STRING_TOKENIZER_get_next_token shall return a nonzero Value (You've reach the end of the string or the string consists with only delimiters).] */
-            //At this point update Current Pos to the character of the last token found or end of String.
-            token->currentPos += i; 
-            
-            //Update the remainingInputStringSize
-            remainingInputStringSize -= i;
-            
-            /* Codes_SRS_STRING_04_006: [If no such character is found, then STRING_TOKENIZER_get_next_token shall return a nonzero Value (You've reach the end of the string or the string consists with only delimiters).] */
-            if (remainingInputStringSize == 0)
-            {
-                result = __LINE__;
-            }
-            else
-            {
-                bool foundDelimitter = false;
-                char* endOfTokenPosition=NULL;
-                size_t amountOfCharactersToCopy;
-                size_t j;
-                //At this point the Current Pos is pointing to a character that is point to a nonDelimiter. So, now search for a Delimiter, till the end of the String. 
-                /*Codes_SRS_STRING_04_008: [STRING_TOKENIZER_get_next_token than searches from the start of a token for a character that is contained in the delimiters string.] */
-                /* Codes_SRS_STRING_04_009: [If no such character is found, STRING_TOKENIZER_get_next_token extends the current token to the end of the string inside t, copies the token to output and returns 0.] */
-                /* Codes_SRS_STRING_04_010: [If such a character is found, STRING_TOKENIZER_get_next_token consider it the end of the token and copy it's content to output, updates the current position inside t to the next character and returns 0.] */
-                for (j = 0; j < delimitterSize; j++)
-                {
-                    if ((endOfTokenPosition = strchr(token->currentPos, delimiters[j])) != NULL)
-                    {
-                        foundDelimitter = true;
-                        break;
-                    }
-                }
-
-                //If token not found, than update the EndOfToken to the end of the inputString;
-                if (endOfTokenPosition == NULL)
-                {
-                    amountOfCharactersToCopy = remainingInputStringSize;
-                }
-                else
-                {
-                    amountOfCharactersToCopy = endOfTokenPosition - token->currentPos;
-                }
-                
-                //copy here the string to output. 
-                if (STRING_copy_n(output, token->currentPos, amountOfCharactersToCopy) != 0)
-                {
-                    LogError("Problem copying token to output String.");
-                    result = __LINE__;
-                }
-                else
-                {
-                    //Update the Current position.
-                    //Check if end of String reached so, currentPos points to the end of String.
-                    if (foundDelimitter)
-                    {
-                        token->currentPos += amountOfCharactersToCopy + 1;
-                    }
-                    else
-                    {
-                        token->currentPos += amountOfCharactersToCopy;
-                    }
-                    
-                    result = 0; //Result will be on the output. 
-                }
-            }
+    return result;
+}
+
+int STRING_TOKENIZER_get_next_token_view(STRING_TOKENIZER_HANDLE tokenizer, STRING_VIEW* output, const char* delimiters)
+{
+    int result;
+    /* Codes_SRS_STRING_TOKENIZER_07_007: [STRING_TOKENIZER_get_next_token_view shall return a nonzero value if any of the 3 parameters is NULL.] */
+    if (tokenizer == NULL || output == NULL || delimiters == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        STRING_TOKEN* token = (STRING_TOKEN*)tokenizer;
+        size_t tokenLength;
+        bool foundDelimitter;
+
+        /* Codes_SRS_STRING_TOKENIZER_07_008: [STRING_TOKENIZER_get_next_token_view shall find the next token exactly like STRING_TOKENIZER_get_next_token and return a nonzero value when there is none.] */
+        if (findNextToken(token, delimiters, &tokenLength, &foundDelimitter) != 0)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_TOKENIZER_07_009: [On success STRING_TOKENIZER_get_next_token_view shall set output to a view over the token inside the tokenized characters, without allocating memory, and return 0.] */
+            output->data = token->currentPos;
+            output->length = tokenLength;
+            token->currentPos += tokenLength + (foundDelimitter ? 1 : 0);
+            result = 0;
         }
     }
 
@@ -203,7 +247,11 @@ void STRING_TOKENIZER_destroy(STRING_TOKENIZER_HANDLE t)
     if (t != NULL)
     {
         STRING_TOKEN* value = (STRING_TOKEN*)t;
-        free((char*)value->inputString);
+        /* Codes_SRS_STRING_TOKENIZER_07_010: [STRING_TOKENIZER_destroy shall not free the characters of a tokenizer created by STRING_TOKENIZER_create_from_view.] */
+        if (value->ownsInputString)
+        {
+            free((char*)value->inputString);
+        }
         value->inputString = NULL;
         free(value);
     }
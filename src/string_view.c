@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+//
+// PUT NO INCLUDES BEFORE HERE
+//
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+#include "azure_c_shared_utility/gballoc.h"
+
+//
+// PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE
+//
+
+#include <string.h>
+#include <limits.h>
+#include "azure_c_shared_utility/string_view.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+static STRING_VIEW STRING_VIEW_make(const char* data, size_t length)
+{
+    STRING_VIEW result;
+    result.data = data;
+    result.length = length;
+    return result;
+}
+
+static bool STRING_VIEW_is_delimiter(char c, const char* delimiters)
+{
+    return (c != '\0') && (strchr(delimiters, c) != NULL);
+}
+
+static bool STRING_VIEW_is_space(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+STRING_VIEW STRING_VIEW_from_chars(const char* source)
+{
+    STRING_VIEW result;
+    if (source == NULL)
+    {
+        /* Codes_SRS_STRING_VIEW_07_001: [If source is NULL, STRING_VIEW_from_chars shall return an empty view (data NULL and length 0).] */
+        result = STRING_VIEW_make(NULL, 0);
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_002: [Otherwise STRING_VIEW_from_chars shall return a view over source having the length strlen(source).] */
+        result = STRING_VIEW_make(source, strlen(source));
+    }
+    return result;
+}
+
+STRING_VIEW STRING_VIEW_from_n(const char* source, size_t length)
+{
+    STRING_VIEW result;
+    if (source == NULL)
+    {
+        /* Codes_SRS_STRING_VIEW_07_003: [If source is NULL, STRING_VIEW_from_n shall return an empty view.] */
+        result = STRING_VIEW_make(NULL, 0);
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_004: [Otherwise STRING_VIEW_from_n shall return a view over the first length characters of source, without looking at them.] */
+        result = STRING_VIEW_make(source, length);
+    }
+    return result;
+}
+
+STRING_VIEW STRING_VIEW_from_STRING(STRING_HANDLE handle)
+{
+    STRING_VIEW result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_STRING_VIEW_07_005: [If handle is NULL, STRING_VIEW_from_STRING shall return an empty view.] */
+        result = STRING_VIEW_make(NULL, 0);
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_006: [Otherwise STRING_VIEW_from_STRING shall return a view over the content of handle, as given by STRING_c_str and STRING_length.] */
+        result = STRING_VIEW_make(STRING_c_str(handle), STRING_length(handle));
+    }
+    return result;
+}
+
+int STRING_VIEW_compare(STRING_VIEW left, STRING_VIEW right)
+{
+    int result;
+    size_t common = (left.length < right.length) ? left.length : right.length;
+
+    /* Codes_SRS_STRING_VIEW_07_007: [STRING_VIEW_compare shall compare the characters that left and right have in common as unsigned char and return the result if they differ.] */
+    result = (common == 0) ? 0 : memcmp(left.data, right.data, common);
+    if (result == 0)
+    {
+        /* Codes_SRS_STRING_VIEW_07_008: [If the common characters are the same, STRING_VIEW_compare shall return a negative value if left is shorter, a positive value if right is shorter and 0 if they have the same length.] */
+        result = (left.length < right.length) ? -1 : ((left.length > right.length) ? 1 : 0);
+    }
+    return result;
+}
+
+bool STRING_VIEW_equals(STRING_VIEW view, const char* s)
+{
+    bool result;
+    if (s == NULL)
+    {
+        /* Codes_SRS_STRING_VIEW_07_009: [If s is NULL, STRING_VIEW_equals shall return false.] */
+        result = false;
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_010: [STRING_VIEW_equals shall return true if s has exactly the characters of view, false otherwise.] */
+        /*s is walked together with view and never read past its '\0', even if view has '\0' characters in it*/
+        size_t i;
+        result = true;
+        for (i = 0; i < view.length; i++)
+        {
+            if ((s[i] == '\0') || (s[i] != view.data[i]))
+            {
+                result = false;
+                break;
+            }
+        }
+        result = result && (s[view.length] == '\0');
+    }
+    return result;
+}
+
+size_t STRING_VIEW_find_char(STRING_VIEW view, char c)
+{
+    size_t result;
+    const char* found = (view.length == 0) ? NULL : (const char*)memchr(view.data, c, view.length);
+    if (found == NULL)
+    {
+        /* Codes_SRS_STRING_VIEW_07_011: [If c is not in view, STRING_VIEW_find_char shall return STRING_VIEW_NOT_FOUND.] */
+        result = STRING_VIEW_NOT_FOUND;
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_012: [Otherwise STRING_VIEW_find_char shall return the index of the first c in view.] */
+        result = (size_t)(found - view.data);
+    }
+    return result;
+}
+
+size_t STRING_VIEW_find(STRING_VIEW view, STRING_VIEW needle)
+{
+    size_t result;
+    if (needle.length == 0)
+    {
+        /* Codes_SRS_STRING_VIEW_07_013: [If needle is empty, STRING_VIEW_find shall return 0.] */
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_014: [STRING_VIEW_find shall return the index of the first occurrence of needle in view or STRING_VIEW_NOT_FOUND if there is none.] */
+        size_t position = 0;
+        result = STRING_VIEW_NOT_FOUND;
+        while (view.length - position >= needle.length)
+        {
+            const char* candidate = (const char*)memchr(view.data + position, needle.data[0], view.length - position - needle.length + 1);
+            if (candidate == NULL)
+            {
+                break;
+            }
+            position = (size_t)(candidate - view.data);
+            if (memcmp(candidate, needle.data, needle.length) == 0)
+            {
+                result = position;
+                break;
+            }
+            position++;
+        }
+    }
+    return result;
+}
+
+STRING_VIEW STRING_VIEW_substring(STRING_VIEW view, size_t start, size_t length)
+{
+    STRING_VIEW result;
+    if (start >= view.length)
+    {
+        /* Codes_SRS_STRING_VIEW_07_015: [If start is not less than the length of view, STRING_VIEW_substring shall return an empty view positioned at the end of view.] */
+        result = STRING_VIEW_make((view.data == NULL) ? NULL : view.data + view.length, 0);
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_016: [Otherwise STRING_VIEW_substring shall return the view of at most length characters that starts at start.] */
+        size_t available = view.length - start;
+        result = STRING_VIEW_make(view.data + start, (length < available) ? length : available);
+    }
+    return result;
+}
+
+STRING_VIEW STRING_VIEW_trim(STRING_VIEW view)
+{
+    /* Codes_SRS_STRING_VIEW_07_017: [STRING_VIEW_trim shall return view without its leading and trailing spaces, tabs, carriage returns and line feeds.] */
+    while ((view.length > 0) && STRING_VIEW_is_space(view.data[0]))
+    {
+        view.data++;
+        view.length--;
+    }
+    while ((view.length > 0) && STRING_VIEW_is_space(view.data[view.length - 1]))
+    {
+        view.length--;
+    }
+    return view;
+}
+
+int STRING_VIEW_split_at(STRING_VIEW view, char separator, STRING_VIEW* left, STRING_VIEW* right)
+{
+    int result;
+    if ((left == NULL) || (right == NULL))
+    {
+        /* Codes_SRS_STRING_VIEW_07_018: [If left or right is NULL, STRING_VIEW_split_at shall fail and return a nonzero value.] */
+        LogError("invalid arg left=%p, right=%p", left, right);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t position = STRING_VIEW_find_char(view, separator);
+        if (position == STRING_VIEW_NOT_FOUND)
+        {
+            /* Codes_SRS_STRING_VIEW_07_019: [If separator is not in view, STRING_VIEW_split_at shall return a nonzero value and leave left and right unchanged.] */
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_VIEW_07_020: [Otherwise STRING_VIEW_split_at shall set left to the characters before the first separator, right to the characters after it and return 0.] */
+            *left = STRING_VIEW_make(view.data, position);
+            *right = STRING_VIEW_make(view.data + position + 1, view.length - position - 1);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int STRING_VIEW_next_token(STRING_VIEW* remaining, const char* delimiters, STRING_VIEW* token)
+{
+    int result;
+    if ((remaining == NULL) || (delimiters == NULL) || (token == NULL))
+    {
+        /* Codes_SRS_STRING_VIEW_07_021: [If remaining, delimiters or token is NULL, STRING_VIEW_next_token shall fail and return a nonzero value.] */
+        LogError("invalid arg remaining=%p, delimiters=%p, token=%p", remaining, delimiters, token);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t start = 0;
+        /* Codes_SRS_STRING_VIEW_07_022: [STRING_VIEW_next_token shall skip the characters of remaining that are in delimiters.] */
+        while ((start < remaining->length) && STRING_VIEW_is_delimiter(remaining->data[start], delimiters))
+        {
+            start++;
+        }
+
+        if (start == remaining->length)
+        {
+            /* Codes_SRS_STRING_VIEW_07_023: [If only delimiters are left, STRING_VIEW_next_token shall make remaining empty and return a nonzero value.] */
+            *remaining = STRING_VIEW_substring(*remaining, start, 0);
+            result = __LINE__;
+        }
+        else
+        {
+            size_t end = start + 1;
+            while ((end < remaining->length) && !STRING_VIEW_is_delimiter(remaining->data[end], delimiters))
+            {
+                end++;
+            }
+
+            /* Codes_SRS_STRING_VIEW_07_024: [Otherwise STRING_VIEW_next_token shall set token to the characters up to the next delimiter (or the end of remaining), set remaining to what follows that delimiter and return 0.] */
+            *token = STRING_VIEW_make(remaining->data + start, end - start);
+            *remaining = STRING_VIEW_substring(*remaining, (end < remaining->length) ? end + 1 : end, remaining->length);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int STRING_VIEW_to_size_t(STRING_VIEW view, size_t* value)
+{
+    int result;
+    if ((value == NULL) || (view.length == 0))
+    {
+        /* Codes_SRS_STRING_VIEW_07_025: [If value is NULL or view is empty, STRING_VIEW_to_size_t shall fail and return a nonzero value.] */
+        LogError("invalid arg value=%p, length=%lu", value, (unsigned long)view.length);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t accumulator = 0;
+        size_t i;
+        result = 0;
+        for (i = 0; i < view.length; i++)
+        {
+            size_t digit;
+            if ((view.data[i] < '0') || (view.data[i] > '9'))
+            {
+                /* Codes_SRS_STRING_VIEW_07_026: [If view has a character that is not a decimal digit, STRING_VIEW_to_size_t shall fail and return a nonzero value.] */
+                result = __LINE__;
+                break;
+            }
+            digit = (size_t)(view.data[i] - '0');
+            if (accumulator > (((size_t)~(size_t)0) - digit) / 10)
+            {
+                /* Codes_SRS_STRING_VIEW_07_027: [If the number does not fit in a size_t, STRING_VIEW_to_size_t shall fail and return a nonzero value.] */
+                result = __LINE__;
+                break;
+            }
+            accumulator = accumulator * 10 + digit;
+        }
+
+        if (result == 0)
+        {
+            /* Codes_SRS_STRING_VIEW_07_028: [Otherwise STRING_VIEW_to_size_t shall write the number in value and return 0.] */
+            *value = accumulator;
+        }
+    }
+    return result;
+}
+
+int STRING_VIEW_to_int(STRING_VIEW view, int* value)
+{
+    int result;
+    if ((value == NULL) || (view.length == 0))
+    {
+        /* Codes_SRS_STRING_VIEW_07_029: [If value is NULL or view is empty, STRING_VIEW_to_int shall fail and return a nonzero value.] */
+        LogError("invalid arg value=%p, length=%lu", value, (unsigned long)view.length);
+        result = __LINE__;
+    }
+    else
+    {
+        /* Codes_SRS_STRING_VIEW_07_030: [STRING_VIEW_to_int shall accept one leading '-' or '+' followed by decimal digits.] */
+        bool isNegative = (view.data[0] == '-');
+        size_t magnitude;
+        if ((isNegative) || (view.data[0] == '+'))
+        {
+            view.data++;
+            view.length--;
+        }
+
+        if (STRING_VIEW_to_size_t(view, &magnitude) != 0)
+        {
+            /* Codes_SRS_STRING_VIEW_07_031: [If view is not such a number or it does not fit in an int, STRING_VIEW_to_int shall fail and return a nonzero value.] */
+            result = __LINE__;
+        }
+        else if (magnitude > (isNegative ? (size_t)INT_MAX + 1 : (size_t)INT_MAX))
+        {
+            /* Codes_SRS_STRING_VIEW_07_031: [If view is not such a number or it does not fit in an int, STRING_VIEW_to_int shall fail and return a nonzero value.] */
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_VIEW_07_032: [Otherwise STRING_VIEW_to_int shall write the number in value and return 0.] */
+            *value = isNegative ? (int)(-(long long)magnitude) : (int)magnitude;
+            result = 0;
+        }
+    }
+    return result;
+}
@@ -15,39 +15,220 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+/*older MSVC CRTs do not have va_copy, their va_list is a plain pointer that can be assigned*/
+#ifndef va_copy
+#define va_copy(destination, source) ((destination) = (source))
+#endif
+
 //
 // PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE
 //
 
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/buffer_.h"
 #include "azure_c_shared_utility/xlogging.h"
 
+/*STRING_new_JSON looks for the characters it has to escape 16 bytes at a time with SSE2 (always there on x64)
+and, when gcc/clang can ask the CPU at runtime, 32 bytes at a time with AVX2. Define STRINGS_JSON_NO_SIMD to only
+have the portable byte by byte scan*/
+#if !defined(STRINGS_JSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define STRINGS_JSON_USE_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define STRINGS_JSON_USE_AVX2
+#define STRINGS_JSON_AVX2_FUNCTION
+#include <immintrin.h>
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define STRINGS_JSON_USE_AVX2
+#define STRINGS_JSON_AVX2_RUNTIME_CHECK
+#define STRINGS_JSON_AVX2_FUNCTION __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 static const char hexToASCII[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
 
+/*strings shorter than this are kept in the handle allocation itself, without a second malloc*/
+#define STRING_INLINE_CAPACITY 24
+
 typedef struct STRING_TAG
 {
     char* s;
+    /*length is strlen(s), capacity is the size of the memory pointed to by s (so it is always bigger than length)*/
+    size_t length;
+    size_t capacity;
+    /*s points here as long as the string fits*/
+    char inlineBuffer[STRING_INLINE_CAPACITY];
 }STRING;
 
-/*this function will allocate a new string with just '\0' in it*/
-/*return NULL if it fails*/
-/* Codes_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
-STRING_HANDLE STRING_new(void)
+static int STRING_is_inline(const STRING* str)
+{
+    return str->s == str->inlineBuffer;
+}
+
+/*allocates a STRING able to hold length characters, the characters themselves are left to the caller*/
+static STRING* STRING_allocate(size_t length)
 {
     STRING* result;
-    if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+    if (length == ((size_t)~(size_t)0))
+    {
+        LogError("size overflow");
+        result = NULL;
+    }
+    else if ((result = (STRING*)malloc(sizeof(STRING))) == NULL)
+    {
+        LogError("unable to malloc");
+    }
+    else if (length < STRING_INLINE_CAPACITY)
+    {
+        /* Codes_SRS_STRING_07_056: [The constructors shall keep a string of fewer than 24 characters in the allocation of the STRING object, without allocating separate memory for the characters.] */
+        result->s = result->inlineBuffer;
+        result->length = 0;
+        result->capacity = STRING_INLINE_CAPACITY;
+    }
+    else if ((result->s = (char*)malloc(length + 1)) == NULL)
+    {
+        LogError("unable to malloc");
+        free(result);
+        result = NULL;
+    }
+    else
     {
-        if ((result->s = (char*)malloc(1)) != NULL)
+        result->length = 0;
+        result->capacity = length + 1;
+    }
+    return result;
+}
+
+/*gives the string exactly newCapacity bytes of memory on the heap (newCapacity is bigger than the length of the string)*/
+static int STRING_reallocate(STRING* str, size_t newCapacity)
+{
+    int result;
+    char* temp;
+    if (STRING_is_inline(str))
+    {
+        /* Codes_SRS_STRING_07_057: [When a string kept in the STRING object grows past that size, its characters shall be moved to memory allocated with malloc.] */
+        if ((temp = (char*)malloc(newCapacity)) != NULL)
         {
-            result->s[0] = '\0';
+            (void)memcpy(temp, str->s, str->length + 1);
+        }
+    }
+    else
+    {
+        temp = (char*)realloc(str->s, newCapacity);
+    }
+
+    if (temp == NULL)
+    {
+        LogError("unable to allocate %lu bytes", (unsigned long)newCapacity);
+        result = __LINE__;
+    }
+    else
+    {
+        str->s = temp;
+        str->capacity = newCapacity;
+        result = 0;
+    }
+    return result;
+}
+
+/*makes room for a string of length characters (plus the '\0'), growing geometrically so that repeated appends are amortized O(1)*/
+static int STRING_grow(STRING* str, size_t length)
+{
+    int result;
+    if (length == ((size_t)~(size_t)0))
+    {
+        LogError("size overflow");
+        result = __LINE__;
+    }
+    else if (length < str->capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t required = length + 1;
+        size_t newCapacity = (str->capacity > ((size_t)~(size_t)0) / 2) ? required : str->capacity * 2;
+        if (newCapacity < required)
+        {
+            newCapacity = required;
+        }
+        result = STRING_reallocate(str, newCapacity);
+    }
+    return result;
+}
+
+/*formats directly in the spare memory at the end of the string. If the text does not fit, the string is left unchanged,
+enough memory for the text is made and *retry is set: the caller has to restart its va_list and call again, which then fits*/
+static int STRING_append_vformat(STRING* str, const char* format, va_list args, int* retry)
+{
+    int result;
+    size_t spare = str->capacity - str->length;
+    int formattedLength = vsnprintf(str->s + str->length, spare, format, args);
+    *retry = 0;
+    if (formattedLength < 0)
+    {
+        LogError("vsnprintf failed");
+        str->s[str->length] = '\0';
+        result = __LINE__;
+    }
+    else if ((size_t)formattedLength < spare)
+    {
+        str->length += (size_t)formattedLength;
+        result = 0;
+    }
+    else
+    {
+        /*the truncated text is dropped*/
+        str->s[str->length] = '\0';
+        if (((size_t)formattedLength > ((size_t)~(size_t)0) - str->length) ||
+            (STRING_grow(str, str->length + (size_t)formattedLength) != 0))
+        {
+            LogError("unable to make room for %d characters", formattedLength);
+            result = __LINE__;
         }
         else
         {
-            /* Codes_SRS_STRING_07_002: [STRING_new shall return an NULL STRING_HANDLE on any error that is encountered.] */
-            free(result);
-            result = NULL;
+            *retry = 1;
+            result = 0;
         }
     }
+    return result;
+}
+
+/*appends the formatted text, making room for it when the first attempt does not fit. args is consumed*/
+static int STRING_append_vprintf(STRING* str, const char* format, va_list args)
+{
+    int result;
+    int retry;
+    va_list first_attempt_args;
+    va_copy(first_attempt_args, args);
+    result = STRING_append_vformat(str, format, first_attempt_args, &retry);
+    va_end(first_attempt_args);
+    if ((result == 0) && retry)
+    {
+        result = STRING_append_vformat(str, format, args, &retry);
+    }
+    return result;
+}
+
+/*this function will allocate a new string with just '\0' in it*/
+/*return NULL if it fails*/
+/* Codes_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
+STRING_HANDLE STRING_new(void)
+{
+    STRING* result;
+    if ((result = STRING_allocate(0)) != NULL)
+    {
+        result->s[0] = '\0';
+    }
+    else
+    {
+        /* Codes_SRS_STRING_07_002: [STRING_new shall return an NULL STRING_HANDLE on any error that is encountered.] */
+    }
     return (STRING_HANDLE)result;
 }
 
@@ -62,25 +243,16 @@ STRING_HANDLE STRING_clone(STRING_HANDLE handle)
     }
     else
     {
+        STRING* source = (STRING*)handle;
         /*Codes_SRS_STRING_02_003: [If STRING_clone fails for any reason, it shall return NULL.] */
-        if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+        if ((result = STRING_allocate(source->length)) != NULL)
         {
-            STRING* source = (STRING*)handle;
-            /*Codes_SRS_STRING_02_003: [If STRING_clone fails for any reason, it shall return NULL.] */
-            size_t sourceLen = strlen(source->s);
-            if ((result->s = (char*)malloc(sourceLen + 1)) == NULL)
-            {
-                free(result);
-                result = NULL;
-            }
-            else
-            {
-                memcpy(result->s, source->s, sourceLen + 1);
-            }
+            memcpy(result->s, source->s, source->length + 1);
+            result->length = source->length;
         }
         else
         {
-            /*not much to do, result is NULL from malloc*/
+            /*not much to do, result is NULL from STRING_allocate*/
         }
     }
     return (STRING_HANDLE)result;
@@ -98,20 +270,12 @@ STRING_HANDLE STRING_construct(const char* psz)
     else
     {
         STRING* str;
-        if ((str = (STRING*)malloc(sizeof(STRING))) != NULL)
+        size_t nLen = strlen(psz);
+        if ((str = STRING_allocate(nLen)) != NULL)
         {
-            size_t nLen = strlen(psz) + 1;
-            if ((str->s = (char*)malloc(nLen)) != NULL)
-            {
-                memcpy(str->s, psz, nLen);
-                result = (STRING_HANDLE)str;
-            }
-            /* Codes_SRS_STRING_07_032: [STRING_construct encounters any error it shall return a NULL value.] */
-            else
-            {
-                free(str);
-                result = NULL;
-            }
+            memcpy(str->s, psz, nLen + 1);
+            str->length = nLen;
+            result = (STRING_HANDLE)str;
         }
         else
         {
@@ -125,69 +289,33 @@ STRING_HANDLE STRING_construct(const char* psz)
 STRING_HANDLE STRING_construct_sprintf(const char* format, ...)
 {
     STRING* result;
-    
-#ifdef ARDUINO_ARCH_ESP8266
-    size_t maxBufSize = 512;
-    char buf[512];
-#else
-    size_t maxBufSize = 0;
-    char* buf = NULL;
-#endif
-
     if (format != NULL)
     {
-        va_list arg_list;
-		int length;
-        va_start(arg_list, format);
-
         /* Codes_SRS_STRING_07_041: [STRING_construct_sprintf shall determine the size of the resulting string and allocate the necessary memory.] */
-        length = vsnprintf(buf, maxBufSize, format, arg_list);
-        va_end(arg_list);
-        if (length > 0)
-        {
-            result = (STRING*)malloc(sizeof(STRING));
-            if (result != NULL)
-            {
-                result->s = (char*)malloc(length+1);
-                if (result->s != NULL)
-                {
-                    va_start(arg_list, format);
-                    if (vsnprintf(result->s, length+1, format, arg_list) < 0)
-                    {
-                        /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
-                        free(result->s);
-                        free(result);
-                        result = NULL;
-                        LogError("Failure: vsnprintf formatting failed.");
-                    }
-                    va_end(arg_list);
-                }
-                else
-                {
-                    /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
-                    free(result);
-                    result = NULL;
-                    LogError("Failure: allocation failed.");
-                }
-            }
-            else
-            {
-                LogError("Failure: allocation failed.");
-            }
-        }
-        else if (length == 0)
+        result = STRING_allocate(0);
+        if (result == NULL)
         {
-            result = (STRING*)STRING_new();
+            /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
+            LogError("Failure: allocation failed.");
         }
         else
         {
-            /* Codes_SRS_STRING_07_039: [If the parameter format is NULL then STRING_construct_sprintf shall return NULL.] */
-            result = NULL;
-            LogError("Failure: vsnprintf return 0 length");
+            va_list arg_list;
+            result->s[0] = '\0';
+            va_start(arg_list, format);
+            if (STRING_append_vprintf(result, format, arg_list) != 0)
+            {
+                /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
+                STRING_delete((STRING_HANDLE)result);
+                result = NULL;
+                LogError("Failure: vsnprintf formatting failed.");
+            }
+            va_end(arg_list);
         }
     }
     else
     {
+        /* Codes_SRS_STRING_07_039: [If the parameter format is NULL then STRING_construct_sprintf shall return NULL.] */
         LogError("Failure: invalid argument.");
         result = NULL;
     }
@@ -212,6 +340,49 @@ STRING_HANDLE STRING_new_with_memory(const char* memory)
         if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
         {
             result->s = (char*)memory;
+            /*the size of the supplied memory is not known, only the part holding the string is assumed*/
+            result->length = strlen(memory);
+            result->capacity = result->length + 1;
+        }
+    }
+    return (STRING_HANDLE)result;
+}
+
+STRING_HANDLE STRING_from_BUFFER_move(BUFFER_HANDLE buffer)
+{
+    STRING* result;
+    if (buffer == NULL)
+    {
+        /* Codes_SRS_STRING_07_046: [If buffer is NULL, STRING_from_BUFFER_move shall return NULL.] */
+        LogError("invalid arg: buffer is NULL");
+        result = NULL;
+    }
+    else if ((result = (STRING*)malloc(sizeof(STRING))) == NULL)
+    {
+        /* Codes_SRS_STRING_07_049: [If any error occurs, STRING_from_BUFFER_move shall return NULL and leave buffer unchanged.] */
+        LogError("unable to malloc");
+    }
+    else
+    {
+        size_t length = BUFFER_length(buffer);
+        /* Codes_SRS_STRING_07_048: [STRING_from_BUFFER_move shall make room for the '\0' terminator with BUFFER_reserve, which does not copy the content when the buffer already has spare capacity.] */
+        if ((length == ((size_t)~(size_t)0)) ||
+            (BUFFER_reserve(buffer, length + 1) != 0))
+        {
+            /* Codes_SRS_STRING_07_049: [If any error occurs, STRING_from_BUFFER_move shall return NULL and leave buffer unchanged.] */
+            LogError("unable to BUFFER_reserve");
+            free(result);
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_07_047: [STRING_from_BUFFER_move shall return a STRING that takes the memory of buffer with BUFFER_detach, without copying it, and leave buffer empty.] */
+            size_t detachedSize;
+            result->s = (char*)BUFFER_detach(buffer, &detachedSize);
+            result->s[length] = '\0';
+            /*the content of a BUFFER can have '\0's in it, the STRING ends at the first one*/
+            result->length = strlen(result->s);
+            result->capacity = length + 1;
         }
     }
     return (STRING_HANDLE)result;
@@ -226,26 +397,305 @@ STRING_HANDLE STRING_new_quoted(const char* source)
         /* Codes_SRS_STRING_07_009: [STRING_new_quoted shall return a NULL STRING_HANDLE if the supplied const char* is NULL.] */
         result = NULL;
     }
-    else if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+    else
     {
         size_t sourceLength = strlen(source);
-        if ((result->s = (char*)malloc(sourceLength + 3)) != NULL)
+        if ((result = STRING_allocate(sourceLength + 2)) != NULL)
         {
             result->s[0] = '"';
             memcpy(result->s + 1, source, sourceLength);
             result->s[sourceLength + 1] = '"';
             result->s[sourceLength + 2] = '\0';
+            result->length = sourceLength + 2;
         }
         else
         {
             /* Codes_SRS_STRING_07_031: [STRING_new_quoted shall return a NULL STRING_HANDLE if any error is encountered.] */
-            free(result);
-            result = NULL;
         }
     }
     return (STRING_HANDLE)result;
 }
 
+/*STRING_new_JSON does two passes over source: count tells how big the result is (and stops at the first non ASCII
+character), escape writes it. Both have a byte by byte version and SIMD versions that look at 16/32 characters at
+a time and only go byte by byte around the characters that need escaping*/
+typedef struct JSON_ESCAPER_TAG
+{
+    size_t(*count)(const char* source, size_t length, size_t* nControlCharacters, size_t* nEscapeCharacters);
+    size_t(*escape)(const char* source, size_t length, char* destination);
+} JSON_ESCAPER;
+
+/*returns how many characters the escaped c takes in destination*/
+static size_t json_escape_character(char c, char* destination)
+{
+    size_t result;
+    if (c <= 0x1F)
+    {
+        /*Codes_SRS_STRING_02_019: [If the character code is less than 0x20 then it shall be represented as \u00xx, where xx is the hex representation of the character code.]*/
+        destination[0] = '\\';
+        destination[1] = 'u';
+        destination[2] = '0';
+        destination[3] = '0';
+        destination[4] = hexToASCII[(c & 0xF0) >> 4]; /*high nibble*/
+        destination[5] = hexToASCII[c & 0x0F]; /*low nibble*/
+        result = 6;
+    }
+    else if ((c == '"') || (c == '\\') || (c == '/'))
+    {
+        /*Codes_SRS_STRING_02_016: [If the character is " (quote) then it shall be repsented as \".] */
+        /*Codes_SRS_STRING_02_017: [If the character is \ (backslash) then it shall represented as \\.] */
+        /*Codes_SRS_STRING_02_018: [If the character is / (slash) then it shall be represented as \/.] */
+        destination[0] = '\\';
+        destination[1] = c;
+        result = 2;
+    }
+    else
+    {
+        /*Codes_SRS_STRING_02_013: [The string shall copy the characters of source "as they are" (until the '\0' character) with the following exceptions:] */
+        destination[0] = c;
+        result = 1;
+    }
+    return result;
+}
+
+/*returns the index of the first non ASCII character, or length if there is none*/
+static size_t json_count_scalar(const char* source, size_t length, size_t* nControlCharacters, size_t* nEscapeCharacters)
+{
+    size_t i;
+    for (i = 0; i < length; i++)
+    {
+        /*Codes_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
+        if ((unsigned char)source[i] >= 128) /*this be a UNICODE character begin*/
+        {
+            break;
+        }
+        else if (source[i] <= 0x1F)
+        {
+            (*nControlCharacters)++;
+        }
+        else if (
+            (source[i] == '"') ||
+            (source[i] == '\\') ||
+            (source[i] == '/')
+            )
+        {
+            (*nEscapeCharacters)++;
+        }
+    }
+    return i;
+}
+
+/*returns how many characters were written to destination*/
+static size_t json_escape_scalar(const char* source, size_t length, char* destination)
+{
+    size_t i;
+    size_t pos = 0;
+    for (i = 0; i < length; i++)
+    {
+        pos += json_escape_character(source[i], destination + pos);
+    }
+    return pos;
+}
+
+static const JSON_ESCAPER json_escaper_scalar = { json_count_scalar, json_escape_scalar };
+
+#ifdef STRINGS_JSON_USE_SSE2
+static size_t json_first_set_bit(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    (void)_BitScanForward(&index, mask);
+    return index;
+#else
+    return (size_t)__builtin_ctz(mask);
+#endif
+}
+
+static size_t json_count_set_bits(unsigned int mask)
+{
+    size_t result = 0;
+    while (mask != 0)
+    {
+        mask &= mask - 1;
+        result++;
+    }
+    return result;
+}
+
+/*copies the chunkSize characters of chunk to destination, escaping the ones that have their bit set in mask*/
+static size_t json_escape_chunk(const char* chunk, size_t chunkSize, unsigned int mask, char* destination)
+{
+    size_t pos = 0;
+    size_t start = 0;
+    while (mask != 0)
+    {
+        size_t index = json_first_set_bit(mask);
+        (void)memcpy(destination + pos, chunk + start, index - start);
+        pos += index - start;
+        pos += json_escape_character(chunk[index], destination + pos);
+        start = index + 1;
+        mask &= mask - 1;
+    }
+    (void)memcpy(destination + pos, chunk + start, chunkSize - start);
+    return pos + chunkSize - start;
+}
+
+/*compared as signed bytes everything >= 0x80 is negative, so "less than 0x20" has the non ASCII characters too.
+count stops before those, so by the time a mask is used for escaping they are not there anymore*/
+static unsigned int json_control_mask_sse2(__m128i chunk)
+{
+    return (unsigned int)_mm_movemask_epi8(_mm_cmplt_epi8(chunk, _mm_set1_epi8(0x20)));
+}
+
+static unsigned int json_escape_mask_sse2(__m128i chunk)
+{
+    return (unsigned int)_mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/')))));
+}
+
+static size_t json_count_sse2(const char* source, size_t length, size_t* nControlCharacters, size_t* nEscapeCharacters)
+{
+    size_t i = 0;
+    while (length - i >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(source + i));
+        /*the top bit of every byte is set for the non ASCII characters*/
+        unsigned int nonASCII = (unsigned int)_mm_movemask_epi8(chunk);
+        if (nonASCII != 0)
+        {
+            return i + json_first_set_bit(nonASCII);
+        }
+        *nControlCharacters += json_count_set_bits(json_control_mask_sse2(chunk));
+        *nEscapeCharacters += json_count_set_bits(json_escape_mask_sse2(chunk));
+        i += 16;
+    }
+    return i + json_count_scalar(source + i, length - i, nControlCharacters, nEscapeCharacters);
+}
+
+static size_t json_escape_sse2(const char* source, size_t length, char* destination)
+{
+    size_t i = 0;
+    size_t pos = 0;
+    while (length - i >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(source + i));
+        unsigned int mask = json_control_mask_sse2(chunk) | json_escape_mask_sse2(chunk);
+        if (mask == 0)
+        {
+            _mm_storeu_si128((__m128i*)(destination + pos), chunk);
+            pos += 16;
+        }
+        else
+        {
+            pos += json_escape_chunk(source + i, 16, mask, destination + pos);
+        }
+        i += 16;
+    }
+    return pos + json_escape_scalar(source + i, length - i, destination + pos);
+}
+
+static const JSON_ESCAPER json_escaper_sse2 = { json_count_sse2, json_escape_sse2 };
+#endif
+
+#ifdef STRINGS_JSON_USE_AVX2
+STRINGS_JSON_AVX2_FUNCTION static unsigned int json_control_mask_avx2(__m256i chunk)
+{
+    /*there is no "less than" for bytes, 0x20 > chunk is the same thing*/
+    return (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), chunk));
+}
+
+STRINGS_JSON_AVX2_FUNCTION static unsigned int json_escape_mask_avx2(__m256i chunk)
+{
+    return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('/')))));
+}
+
+STRINGS_JSON_AVX2_FUNCTION static size_t json_count_avx2(const char* source, size_t length, size_t* nControlCharacters, size_t* nEscapeCharacters)
+{
+    size_t i = 0;
+    while (length - i >= 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(source + i));
+        unsigned int nonASCII = (unsigned int)_mm256_movemask_epi8(chunk);
+        if (nonASCII != 0)
+        {
+            return i + json_first_set_bit(nonASCII);
+        }
+        *nControlCharacters += json_count_set_bits(json_control_mask_avx2(chunk));
+        *nEscapeCharacters += json_count_set_bits(json_escape_mask_avx2(chunk));
+        i += 32;
+    }
+    /*going back to SSE2 code with the upper halves of the registers dirty is very slow on some CPUs*/
+    _mm256_zeroupper();
+    return i + json_count_sse2(source + i, length - i, nControlCharacters, nEscapeCharacters);
+}
+
+STRINGS_JSON_AVX2_FUNCTION static size_t json_escape_avx2(const char* source, size_t length, char* destination)
+{
+    size_t i = 0;
+    size_t pos = 0;
+    while (length - i >= 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(source + i));
+        unsigned int mask = json_control_mask_avx2(chunk) | json_escape_mask_avx2(chunk);
+        if (mask == 0)
+        {
+            _mm256_storeu_si256((__m256i*)(destination + pos), chunk);
+            pos += 32;
+        }
+        else
+        {
+            /*json_escape_chunk calls memcpy, which can be SSE2 code*/
+            _mm256_zeroupper();
+            pos += json_escape_chunk(source + i, 32, mask, destination + pos);
+        }
+        i += 32;
+    }
+    _mm256_zeroupper();
+    return pos + json_escape_sse2(source + i, length - i, destination + pos);
+}
+
+static const JSON_ESCAPER json_escaper_avx2 = { json_count_avx2, json_escape_avx2 };
+#endif
+
+/*picks the widest scan this CPU can do. Strings shorter than one SSE2 chunk (most keys) are faster byte by byte*/
+static const JSON_ESCAPER* json_escaper_select(size_t length)
+{
+    const JSON_ESCAPER* result;
+    if (length < 16)
+    {
+        result = &json_escaper_scalar;
+    }
+#if defined(STRINGS_JSON_AVX2_RUNTIME_CHECK)
+    else if (__builtin_cpu_supports("avx2"))
+    {
+        result = &json_escaper_avx2;
+    }
+    else
+    {
+        result = &json_escaper_sse2;
+    }
+#elif defined(STRINGS_JSON_USE_AVX2)
+    else
+    {
+        result = &json_escaper_avx2;
+    }
+#elif defined(STRINGS_JSON_USE_SSE2)
+    else
+    {
+        result = &json_escaper_sse2;
+    }
+#else
+    else
+    {
+        result = &json_escaper_scalar;
+    }
+#endif
+    return result;
+}
+
 /*this function takes a regular const char* and turns in into "this is a\"JSON\" strings\u0008" (starting and ending quote included)*/
 /*the newly created handle needs to be disposed of with STRING_delete*/
 /*returns NULL if there are errors*/
@@ -260,99 +710,44 @@ STRING_HANDLE STRING_new_JSON(const char* source)
     }
     else
     {
-        size_t i;
         size_t nControlCharacters = 0; /*counts how many characters are to be expanded from 1 character to \uxxxx (6 characters)*/
         size_t nEscapeCharacters = 0;
         size_t vlen = strlen(source);
+        const JSON_ESCAPER* escaper = json_escaper_select(vlen);
 
-        for (i = 0; i < vlen; i++)
-        {
-            /*Codes_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
-            if ((unsigned char)source[i] >= 128) /*this be a UNICODE character begin*/
-            {
-                break;
-            }
-            else
-            {
-                if (source[i] <= 0x1F)
-                {
-                    nControlCharacters++;
-                }
-                else if (
-                    (source[i] == '"') ||
-                    (source[i] == '\\') ||
-                    (source[i] == '/')
-                    )
-                {
-                    nEscapeCharacters++;
-                }
-            }
-        }
-
-        if (i < vlen)
+        /*Codes_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
+        if (escaper->count(source, vlen, &nControlCharacters, &nEscapeCharacters) < vlen)
         {
             result = NULL;
             LogError("invalid character in input string");
         }
         else
         {
-            if ((result = (STRING*)malloc(sizeof(STRING))) == NULL)
+            if ((result = STRING_allocate(vlen + 5 * nControlCharacters + nEscapeCharacters + 2)) == NULL)
             {
                 /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
                 LogError("malloc failure");
             }
-            else if ((result->s = (char*)malloc(vlen + 5 * nControlCharacters + nEscapeCharacters + 3)) == NULL)
-            {
-                /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
-                free(result);
-                result = NULL;
-                LogError("malloc failed");
-            }
             else
             {
                 size_t pos = 0;
                 /*Codes_SRS_STRING_02_012: [The string shall begin with the quote character.] */
                 result->s[pos++] = '"';
-                for (i = 0; i < vlen; i++)
+                if ((nControlCharacters == 0) && (nEscapeCharacters == 0))
+                {
+                    /*nothing to escape, no reason to look at the characters again*/
+                    (void)memcpy(result->s + pos, source, vlen);
+                    pos += vlen;
+                }
+                else
                 {
-                    if (source[i] <= 0x1F)
-                    {
-                        /*Codes_SRS_STRING_02_019: [If the character code is less than 0x20 then it shall be represented as \u00xx, where xx is the hex representation of the character code.]*/
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = 'u';
-                        result->s[pos++] = '0';
-                        result->s[pos++] = '0';
-                        result->s[pos++] = hexToASCII[(source[i] & 0xF0) >> 4]; /*high nibble*/
-                        result->s[pos++] = hexToASCII[source[i] & 0x0F]; /*low nibble*/
-                    }
-                    else if (source[i] == '"')
-                    {
-                        /*Codes_SRS_STRING_02_016: [If the character is " (quote) then it shall be repsented as \".] */
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = '"';
-                    }
-                    else if (source[i] == '\\')
-                    {
-                        /*Codes_SRS_STRING_02_017: [If the character is \ (backslash) then it shall represented as \\.] */
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = '\\';
-                    }
-                    else if (source[i] == '/')
-                    {
-                        /*Codes_SRS_STRING_02_018: [If the character is / (slash) then it shall be represented as \/.] */
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = '/';
-                    }
-                    else
-                    {
-                        /*Codes_SRS_STRING_02_013: [The string shall copy the characters of source "as they are" (until the '\0' character) with the following exceptions:] */
-                        result->s[pos++] = source[i];
-                    }
+                    pos += escaper->escape(source, vlen, result->s + pos);
                 }
                 /*Codes_SRS_STRING_02_020: [The string shall end with " (quote).] */
                 result->s[pos++] = '"';
                 /*zero terminating it*/
                 result->s[pos] = '\0';
+                result->length = pos;
             }
         }
 
@@ -375,18 +770,18 @@ int STRING_concat(STRING_HANDLE handle, const char* s2)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s1Length = strlen(s1->s);
+        size_t s1Length = s1->length;
         size_t s2Length = strlen(s2);
-        char* temp = (char*)realloc(s1->s, s1Length + s2Length + 1);
-        if (temp == NULL)
+        if ((s2Length > ((size_t)~(size_t)0) - s1Length) ||
+            (STRING_grow(s1, s1Length + s2Length) != 0))
         {
             /* Codes_SRS_STRING_07_013: [STRING_concat shall return a nonzero number if an error is encountered.] */
             result = __LINE__;
         }
         else
         {
-            s1->s = temp;
             memcpy(s1->s + s1Length, s2, s2Length + 1);
+            s1->length = s1Length + s2Length;
             result = 0;
         }
     }
@@ -410,19 +805,21 @@ int STRING_concat_with_STRING(STRING_HANDLE s1, STRING_HANDLE s2)
         STRING* dest = (STRING*)s1;
         STRING* src = (STRING*)s2;
 
-        size_t s1Length = strlen(dest->s);
-        size_t s2Length = strlen(src->s);
-        char* temp = (char*)realloc(dest->s, s1Length + s2Length + 1);
-        if (temp == NULL)
+        size_t s1Length = dest->length;
+        size_t s2Length = src->length;
+        if ((s2Length > ((size_t)~(size_t)0) - s1Length) ||
+            (STRING_grow(dest, s1Length + s2Length) != 0))
         {
             /* Codes_SRS_STRING_07_035: [String_Concat_with_STRING shall return a nonzero number if an error is encountered.] */
             result = __LINE__;
         }
         else
         {
-            dest->s = temp;
             /* Codes_SRS_STRING_07_034: [String_Concat_with_STRING shall concatenate a given STRING_HANDLE variable with a source STRING_HANDLE.] */
-            memcpy(dest->s + s1Length, src->s, s2Length + 1);
+            /*src->s is read after growing, it moves with dest->s when s1 and s2 are the same handle*/
+            memcpy(dest->s + s1Length, src->s, s2Length);
+            dest->s[s1Length + s2Length] = '\0';
+            dest->length = s1Length + s2Length;
             result = 0;
         }
     }
@@ -448,16 +845,15 @@ int STRING_copy(STRING_HANDLE handle, const char* s2)
         if (s1->s != s2)
         {
             size_t s2Length = strlen(s2);
-            char* temp = (char*)realloc(s1->s, s2Length + 1);
-            if (temp == NULL)
+            if (STRING_grow(s1, s2Length) != 0)
             {
                 /* Codes_SRS_STRING_07_027: [STRING_copy shall return a nonzero value if any error is encountered.] */
                 result = __LINE__;
             }
             else
             {
-                s1->s = temp;
                 memmove(s1->s, s2, s2Length + 1);
+                s1->length = s2Length;
                 result = 0;
             }
         }
@@ -486,23 +882,21 @@ int STRING_copy_n(STRING_HANDLE handle, const char* s2, size_t n)
     {
         STRING* s1 = (STRING*)handle;
         size_t s2Length = strlen(s2);
-        char* temp;
         if (s2Length > n)
         {
             s2Length = n;
         }
 
-        temp = (char*)realloc(s1->s, s2Length + 1);
-        if (temp == NULL)
+        if (STRING_grow(s1, s2Length) != 0)
         {
             /* Codes_SRS_STRING_07_028: [STRING_copy_n shall return a nonzero value if any error is encountered.] */
             result = __LINE__;
         }
         else
         {
-            s1->s = temp;
-            memcpy(s1->s, s2, s2Length);
+            memmove(s1->s, s2, s2Length);
             s1->s[s2Length] = 0;
+            s1->length = s2Length;
             result = 0;
         }
 
@@ -513,15 +907,6 @@ int STRING_copy_n(STRING_HANDLE handle, const char* s2, size_t n)
 int STRING_sprintf(STRING_HANDLE handle, const char* format, ...)
 {
     int result;
-    
-#ifdef ARDUINO_ARCH_ESP8266
-    size_t maxBufSize = 512;
-    char buf[512];
-#else
-    size_t maxBufSize = 0;
-    char* buf = NULL;
-#endif
-    
     if (handle == NULL || format == NULL)
     {
         /* Codes_SRS_STRING_07_042: [if the parameters s1 or format are NULL then STRING_sprintf shall return non zero value.] */
@@ -531,52 +916,47 @@ int STRING_sprintf(STRING_HANDLE handle, const char* format, ...)
     else
     {
         va_list arg_list;
-		int s2Length;
         va_start(arg_list, format);
-
-        s2Length = vsnprintf(buf, maxBufSize, format, arg_list);
+        result = STRING_append_vprintf((STRING*)handle, format, arg_list);
         va_end(arg_list);
-        if (s2Length < 0)
+
+        if (result != 0)
         {
             /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
+            LogError("Failure formatting the string");
             result = __LINE__;
-            LogError("Failure vsnprintf return < 0");
         }
-        else if (s2Length == 0)
+        else
         {
-            // Don't need to reallocate and nothing should be added
-            result = 0;
+            /* Codes_SRS_STRING_07_044: [On success STRING_sprintf shall return 0.]*/
         }
-        else
+    }
+    return result;
+}
+
+int STRING_append_format(STRING_HANDLE handle, const char* format, ...)
+{
+    int result;
+    if (handle == NULL || format == NULL)
+    {
+        /* Codes_SRS_STRING_07_058: [If handle or format is NULL then STRING_append_format shall return a nonzero value.] */
+        result = __LINE__;
+        LogError("Invalid arg (NULL)");
+    }
+    else
+    {
+        va_list arg_list;
+        /* Codes_SRS_STRING_07_059: [STRING_append_format shall append the printf style formatted text at the end of the string, formatting it directly in the memory of the string, and return 0.] */
+        /* STRING_append_format is the same as STRING_sprintf, which also appends */
+        va_start(arg_list, format);
+        result = STRING_append_vprintf((STRING*)handle, format, arg_list);
+        va_end(arg_list);
+
+        if (result != 0)
         {
-            STRING* s1 = (STRING*)handle;
-			char* temp;
-            size_t s1Length = strlen(s1->s);
-            temp = (char*)realloc(s1->s, s1Length + s2Length + 1);
-            if (temp != NULL)
-            {
-                s1->s = temp;
-                va_start(arg_list, format);
-                if (vsnprintf(s1->s + s1Length, s1Length + s2Length + 1, format, arg_list) < 0)
-                {
-                    /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
-                    LogError("Failure vsnprintf formatting error");
-                    s1->s[s1Length] = '\0';
-                    result = __LINE__;
-                }
-                else
-                {
-                    /* Codes_SRS_STRING_07_044: [On success STRING_sprintf shall return 0.]*/
-                    result = 0;
-                }
-                va_end(arg_list);
-            }
-            else
-            {
-                /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
-                LogError("Failure unable to reallocate memory");
-                result = __LINE__;
-            }
+            /* Codes_SRS_STRING_07_060: [If any error is encountered STRING_append_format shall return a nonzero value and leave the string unchanged.] */
+            LogError("Failure formatting the string");
+            result = __LINE__;
         }
     }
     return result;
@@ -597,20 +977,20 @@ int STRING_quote(STRING_HANDLE handle)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s1Length = strlen(s1->s);
-        char* temp = (char*)realloc(s1->s, s1Length + 2 + 1);/*2 because 2 quotes, 1 because '\0'*/
-        if (temp == NULL)
+        size_t s1Length = s1->length;
+        if ((s1Length > ((size_t)~(size_t)0) - 2) ||
+            (STRING_grow(s1, s1Length + 2) != 0)) /*2 because 2 quotes*/
         {
             /* Codes_SRS_STRING_07_029: [STRING_quote shall return a nonzero value if any error is encountered.] */
             result = __LINE__;
         }
         else
         {
-            s1->s = temp;
             memmove(s1->s + 1, s1->s, s1Length);
             s1->s[0] = '"';
             s1->s[s1Length + 1] = '"';
             s1->s[s1Length + 2] = '\0';
+            s1->length = s1Length + 2;
             result = 0;
         }
     }
@@ -629,19 +1009,11 @@ int STRING_empty(STRING_HANDLE handle)
     }
     else
     {
+        /* Codes_SRS_STRING_07_050: [STRING_empty shall keep the memory of the string, so that refilling it does not reallocate.] */
         STRING* s1 = (STRING*)handle;
-        char* temp = (char*)realloc(s1->s, 1);
-        if (temp == NULL)
-        {
-            /* Codes_SRS_STRING_07_030: [STRING_empty shall return a nonzero value if the STRING_HANDLE is NULL.] */
-            result = __LINE__;
-        }
-        else
-        {
-            s1->s = temp;
-            s1->s[0] = '\0';
-            result = 0;
-        }
+        s1->s[0] = '\0';
+        s1->length = 0;
+        result = 0;
     }
     return result;
 }
@@ -654,7 +1026,10 @@ void STRING_delete(STRING_HANDLE handle)
     if (handle != NULL)
     {
         STRING* value = (STRING*)handle;
-        free(value->s);
+        if (!STRING_is_inline(value))
+        {
+            free(value->s);
+        }
         value->s = NULL;
         free(value);
     }
@@ -682,9 +1057,51 @@ size_t STRING_length(STRING_HANDLE handle)
     size_t result = 0;
     /* Codes_SRS_STRING_07_025: [STRING_length shall return zero if the given handle is NULL.] */
     if (handle != NULL)
+    {
+        /* Codes_SRS_STRING_07_051: [STRING_length shall return the length kept by the STRING, without walking the characters.] */
+        STRING* value = (STRING*)handle;
+        result = value->length;
+    }
+    return result;
+}
+
+int STRING_reserve(STRING_HANDLE handle, size_t length)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_STRING_07_052: [If handle is NULL, STRING_reserve shall return a nonzero value.] */
+        LogError("invalid arg: handle is NULL");
+        result = __LINE__;
+    }
+    else
     {
         STRING* value = (STRING*)handle;
-        result = strlen(value->s);
+        if (length < value->capacity)
+        {
+            /* Codes_SRS_STRING_07_053: [If the string can already hold length characters, STRING_reserve shall do nothing and return zero.] */
+            result = 0;
+        }
+        else if (length == ((size_t)~(size_t)0))
+        {
+            /* Codes_SRS_STRING_07_055: [If reallocating fails, STRING_reserve shall return a nonzero value and the string shall be unchanged.] */
+            LogError("size overflow");
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_07_054: [Otherwise STRING_reserve shall reallocate the memory of the string to hold exactly length characters and the '\0' terminator, keeping the content, and return zero.] */
+            if (STRING_reallocate(value, length + 1) != 0)
+            {
+                /* Codes_SRS_STRING_07_055: [If reallocating fails, STRING_reserve shall return a nonzero value and the string shall be unchanged.] */
+                LogError("unable to reallocate the string");
+                result = __LINE__;
+            }
+            else
+            {
+                result = 0;
+            }
+        }
     }
     return result;
 }
@@ -711,20 +1128,12 @@ STRING_HANDLE STRING_construct_n(const char* psz, size_t n)
         else
         {
             STRING* str;
-            if ((str = (STRING*)malloc(sizeof(STRING))) != NULL)
+            if ((str = STRING_allocate(n)) != NULL)
             {
-                if ((str->s = (char*)malloc(len + 1)) != NULL)
-                {
-                    memcpy(str->s, psz, n);
-                    str->s[n] = '\0';
-                    result = (STRING_HANDLE)str;
-                }
-                /* Codes_SRS_STRING_02_010: [In all other error cases, STRING_construct_n shall return NULL.]  */
-                else
-                {
-                    free(str);
-                    result = NULL;
-                }
+                memcpy(str->s, psz, n);
+                str->s[n] = '\0';
+                str->length = n;
+                result = (STRING_HANDLE)str;
             }
             else
             {
@@ -777,7 +1186,7 @@ STRING_HANDLE STRING_from_byte_array(const unsigned char* source, size_t size)
     else
     {
         /*Codes_SRS_STRING_02_023: [ Otherwise, STRING_from_BUFFER shall build a string that has the same content (byte-by-byte) as source and return a non-NULL handle. ]*/
-        result = (STRING*)malloc(sizeof(STRING));
+        result = STRING_allocate(size);
         if (result == NULL)
         {
             /*Codes_SRS_STRING_02_024: [ If building the string fails, then STRING_from_BUFFER shall fail and return NULL. ]*/
@@ -787,19 +1196,14 @@ STRING_HANDLE STRING_from_byte_array(const unsigned char* source, size_t size)
         else
         {
             /*Codes_SRS_STRING_02_023: [ Otherwise, STRING_from_BUFFER shall build a string that has the same content (byte-by-byte) as source and return a non-NULL handle. ]*/
-            result->s = (char*)malloc(size + 1);
-            if (result->s == NULL)
-            {
-                /*Codes_SRS_STRING_02_024: [ If building the string fails, then STRING_from_BUFFER shall fail and return NULL. ]*/
-                LogError("oom - unable to malloc");
-                free(result);
-                result = NULL;
-            }
-            else
+            const unsigned char* firstZero = (size == 0) ? NULL : (const unsigned char*)memchr(source, '\0', size);
+            if (size > 0)
             {
                 memcpy(result->s, source, size);
-                result->s[size] = '\0'; /*all is fine*/
             }
+            result->s[size] = '\0'; /*all is fine*/
+            /*the string ends at the first '\0' of source, if any*/
+            result->length = (firstZero == NULL) ? size : (size_t)(firstZero - source);
         }
     }
     return (STRING_HANDLE)result;
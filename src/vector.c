@@ -14,6 +14,7 @@ typedef struct VECTOR_TAG
 {
     void* storage;
     size_t count;
+    size_t capacity; /*in elements, storage only grows (doubling) until VECTOR_shrink_to_fit or VECTOR_clear*/
     size_t elementSize;
 } VECTOR;
 
@@ -30,6 +31,7 @@ VECTOR_HANDLE VECTOR_create(size_t elementSize)
     {
         vec->storage = NULL;
         vec->count = 0;
+        vec->capacity = 0;
         vec->elementSize = elementSize;
         result = (VECTOR_HANDLE)vec;
     }
@@ -44,6 +46,32 @@ static void internal_VECTOR_clear(VECTOR* vec)
         vec->storage = NULL;
     }
     vec->count = 0;
+    vec->capacity = 0;
+}
+
+/*makes room for exactly capacity elements, the caller makes sure that capacity is not less than count*/
+static int internal_VECTOR_set_capacity(VECTOR* vec, size_t capacity)
+{
+    int result;
+    if ((vec->elementSize != 0) && (capacity > ((size_t)~(size_t)0) / vec->elementSize))
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        void* temp = realloc(vec->storage, vec->elementSize * capacity);
+        if (temp == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            vec->storage = temp;
+            vec->capacity = capacity;
+            result = 0;
+        }
+    }
+    return result;
 }
 
 void VECTOR_destroy(VECTOR_HANDLE handle)
@@ -56,6 +84,56 @@ void VECTOR_destroy(VECTOR_HANDLE handle)
     }
 }
 
+/*makes sure numElements more elements fit in the storage, count is not changed*/
+static int internal_VECTOR_make_room(VECTOR* vec, size_t numElements)
+{
+    int result;
+    if (numElements > ((size_t)~(size_t)0) - vec->count)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        const size_t newCount = vec->count + numElements;
+        if (newCount > vec->capacity)
+        {
+            /*doubling keeps filling a vector one element at a time linear in copies*/
+            size_t newCapacity = (vec->capacity > ((size_t)~(size_t)0) / 2) ? newCount : vec->capacity * 2;
+            if (newCapacity < newCount)
+            {
+                newCapacity = newCount;
+            }
+            result = internal_VECTOR_set_capacity(vec, newCapacity);
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*index of the first element for which compare(key, element) is < 0 (upperBound) or <= 0 (!upperBound), count if there is none*/
+static size_t internal_VECTOR_bound(const VECTOR* vec, const void* key, VECTOR_COMPARE_FUNCTION compare, bool upperBound)
+{
+    size_t low = 0;
+    size_t high = vec->count;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        int comparison = compare(key, (const unsigned char*)vec->storage + (vec->elementSize * middle));
+        if ((comparison > 0) || (upperBound && (comparison == 0)))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
 /* insertion */
 int VECTOR_push_back(VECTOR_HANDLE handle, const void* elements, size_t numElements)
 {
@@ -67,18 +145,13 @@ int VECTOR_push_back(VECTOR_HANDLE handle, const void* elements, size_t numEleme
     else
     {
         VECTOR* vec = (VECTOR*)handle;
-        const size_t curSize = vec->elementSize * vec->count;
-        const size_t appendSize = vec->elementSize * numElements;
-
-        void* temp = realloc(vec->storage, curSize + appendSize);
-        if (temp == NULL)
+        if (internal_VECTOR_make_room(vec, numElements) != 0)
         {
             result = __LINE__;
         }
         else
         {
-            memcpy((unsigned char*)temp + curSize, elements, appendSize);
-            vec->storage = temp;
+            memcpy((unsigned char*)vec->storage + (vec->elementSize * vec->count), elements, vec->elementSize * numElements);
             vec->count += numElements;
             result = 0;
         }
@@ -86,6 +159,34 @@ int VECTOR_push_back(VECTOR_HANDLE handle, const void* elements, size_t numEleme
     return result;
 }
 
+int VECTOR_insert_sorted(VECTOR_HANDLE handle, const void* element, VECTOR_COMPARE_FUNCTION compare)
+{
+    int result;
+    if (handle == NULL || element == NULL || compare == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        VECTOR* vec = (VECTOR*)handle;
+        /*after the elements that compare equal, so that they stay in the order they were inserted*/
+        size_t index = internal_VECTOR_bound(vec, element, compare, true);
+        if (internal_VECTOR_make_room(vec, 1) != 0)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            unsigned char* where = (unsigned char*)vec->storage + (vec->elementSize * index);
+            (void)memmove(where + vec->elementSize, where, vec->elementSize * (vec->count - index));
+            (void)memcpy(where, element, vec->elementSize);
+            vec->count++;
+            result = 0;
+        }
+    }
+    return result;
+}
+
 /* removal */
 void VECTOR_erase(VECTOR_HANDLE handle, void* elements, size_t numElements)
 {
@@ -95,15 +196,19 @@ void VECTOR_erase(VECTOR_HANDLE handle, void* elements, size_t numElements)
         unsigned char* src = (unsigned char*)elements + (vec->elementSize * numElements);
         unsigned char* srcEnd = (unsigned char*)vec->storage + (vec->elementSize * vec->count);
         (void)memmove(elements, src, srcEnd - src);
+        /*the storage is kept for the elements that come next, VECTOR_shrink_to_fit gives it back*/
         vec->count -= numElements;
-        if (vec->count == 0)
-        {
-            free(vec->storage);
-            vec->storage = NULL;
-        }
-        else
+    }
+}
+
+void VECTOR_pop_back(VECTOR_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        VECTOR* vec = (VECTOR*)handle;
+        if (vec->count > 0)
         {
-            vec->storage = realloc(vec->storage, (vec->elementSize * vec->count));
+            vec->count--;
         }
     }
 }
@@ -139,7 +244,10 @@ void* VECTOR_front(const VECTOR_HANDLE handle)
     if (handle != NULL)
     {
         const VECTOR* vec = (const VECTOR*)handle;
-        result = vec->storage;
+        if (vec->count > 0)
+        {
+            result = vec->storage;
+        }
     }
     return result;
 }
@@ -150,7 +258,10 @@ void* VECTOR_back(const VECTOR_HANDLE handle)
     if (handle != NULL)
     {
         const VECTOR* vec = (const VECTOR*)handle;
-        result = (unsigned char*)vec->storage + (vec->elementSize * (vec->count - 1));
+        if (vec->count > 0)
+        {
+            result = (unsigned char*)vec->storage + (vec->elementSize * (vec->count - 1));
+        }
     }
     return result;
 }
@@ -175,6 +286,48 @@ void* VECTOR_find_if(const VECTOR_HANDLE handle, PREDICATE_FUNCTION pred, const
     return result;
 }
 
+void VECTOR_sort(VECTOR_HANDLE handle, VECTOR_COMPARE_FUNCTION compare)
+{
+    if (handle != NULL && compare != NULL)
+    {
+        VECTOR* vec = (VECTOR*)handle;
+        if (vec->count > 1)
+        {
+            qsort(vec->storage, vec->count, vec->elementSize, compare);
+        }
+    }
+}
+
+void* VECTOR_bsearch(const VECTOR_HANDLE handle, const void* key, VECTOR_COMPARE_FUNCTION compare)
+{
+    void* result = NULL;
+    if (handle != NULL && key != NULL && compare != NULL)
+    {
+        const VECTOR* vec = (const VECTOR*)handle;
+        size_t index = internal_VECTOR_bound(vec, key, compare, false);
+        if (index < vec->count)
+        {
+            void* elem = (unsigned char*)vec->storage + (vec->elementSize * index);
+            if (compare(key, elem) == 0)
+            {
+                result = elem;
+            }
+        }
+    }
+    return result;
+}
+
+size_t VECTOR_lower_bound(const VECTOR_HANDLE handle, const void* key, VECTOR_COMPARE_FUNCTION compare)
+{
+    size_t result = 0;
+    if (handle != NULL && key != NULL && compare != NULL)
+    {
+        const VECTOR* vec = (const VECTOR*)handle;
+        result = internal_VECTOR_bound(vec, key, compare, false);
+    }
+    return result;
+}
+
 /* capacity */
 
 size_t VECTOR_size(const VECTOR_HANDLE handle)
@@ -187,3 +340,53 @@ size_t VECTOR_size(const VECTOR_HANDLE handle)
     }
     return result;
 }
+
+size_t VECTOR_capacity(const VECTOR_HANDLE handle)
+{
+    size_t result = 0;
+    if (handle != NULL)
+    {
+        const VECTOR* vec = (const VECTOR*)handle;
+        result = vec->capacity;
+    }
+    return result;
+}
+
+int VECTOR_reserve(VECTOR_HANDLE handle, size_t capacity)
+{
+    int result;
+    if (handle == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        VECTOR* vec = (VECTOR*)handle;
+        if (capacity <= vec->capacity)
+        {
+            result = 0;
+        }
+        else
+        {
+            result = internal_VECTOR_set_capacity(vec, capacity);
+        }
+    }
+    return result;
+}
+
+void VECTOR_shrink_to_fit(VECTOR_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        VECTOR* vec = (VECTOR*)handle;
+        if (vec->count == 0)
+        {
+            internal_VECTOR_clear(vec);
+        }
+        else if (vec->count < vec->capacity)
+        {
+            /*a vector that cannot shrink only keeps more memory than it needs*/
+            (void)internal_VECTOR_set_capacity(vec, vec->count);
+        }
+    }
+}
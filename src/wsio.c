@@ -19,6 +19,9 @@
 #include "azure_c_shared_utility/shared_util_options.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 
+/* removed pending IO nodes are kept for the next sends, so that a busy socket does not allocate a list node per send */
+#define PENDING_IO_POOL_SIZE 8
+
 typedef enum IO_STATE_TAG
 {
     IO_STATE_NOT_OPEN,
@@ -132,13 +135,14 @@ static int add_pending_io(WSIO_INSTANCE* ws_io_instance, const unsigned char* bu
     return result;
 }
 
-static int remove_pending_io(WSIO_INSTANCE* wsio_instance, LIST_ITEM_HANDLE item_handle, PENDING_SOCKET_IO* pending_socket_io)
+/* the pending IO being removed is always the head of the list */
+static int remove_pending_io(WSIO_INSTANCE* wsio_instance, PENDING_SOCKET_IO* pending_socket_io)
 {
     int result;
 
     free(pending_socket_io->bytes);
     free(pending_socket_io);
-    if (singlylinkedlist_remove(wsio_instance->pending_io_list, item_handle) != 0)
+    if (singlylinkedlist_remove_head(wsio_instance->pending_io_list) != 0)
     {
         result = __LINE__;
     }
@@ -264,7 +268,7 @@ static int on_ws_callback(struct lws *wsi, enum lws_callback_reasons reason, voi
                             }
                         }
 
-                        if ((remove_pending_io(wsio_instance, first_pending_io, pending_socket_io) != 0) && !is_partially_sent)
+                        if ((remove_pending_io(wsio_instance, pending_socket_io) != 0) && !is_partially_sent)
                         {
                             /* Codes_SRS_WSIO_01_117: [on_io_error should not be triggered twice when removing a pending IO that failed and a partial send for it has already been done.] */
                             indicate_error(wsio_instance);
@@ -305,7 +309,7 @@ static int on_ws_callback(struct lws *wsi, enum lws_callback_reasons reason, voi
                                 }
                             }
 
-                            if ((remove_pending_io(wsio_instance, first_pending_io, pending_socket_io) != 0) && !is_partially_sent)
+                            if ((remove_pending_io(wsio_instance, pending_socket_io) != 0) && !is_partially_sent)
                             {
                                 /* Codes_SRS_WSIO_01_117: [on_io_error should not be triggered twice when removing a pending IO that failed and a partial send for it has already been done.] */
                                 indicate_error(wsio_instance);
@@ -335,7 +339,7 @@ static int on_ws_callback(struct lws *wsi, enum lws_callback_reasons reason, voi
                                 }
 
                                 /* Codes_SRS_WSIO_01_077: [If lws_write succeeds and the complete payload has been sent, the queued pending IO shall be removed from the pending list.] */
-                                if (remove_pending_io(wsio_instance, first_pending_io, pending_socket_io) != 0)
+                                if (remove_pending_io(wsio_instance, pending_socket_io) != 0)
                                 {
                                     /* Codes_SRS_WSIO_01_079: [If the send was successful and any error occurs during removing the pending IO from the list then the on_io_error callback shall be triggered.]  */
                                     indicate_error(wsio_instance);
@@ -546,11 +550,11 @@ CONCRETE_IO_HANDLE wsio_create(void* io_create_parameters)
             result->wsio_http_proxy_option.password = NULL;
             result->wsio_http_proxy_option.username = NULL;
 
-            /* Codes_SRS_WSIO_01_098: [wsio_create shall create a pending IO list that is to be used when sending buffers over the libwebsockets IO by calling singlylinkedlist_create.] */
-            result->pending_io_list = singlylinkedlist_create();
+            /* Codes_SRS_WSIO_01_098: [wsio_create shall create a pending IO list that is to be used when sending buffers over the libwebsockets IO by calling singlylinkedlist_create_pooled.] */
+            result->pending_io_list = singlylinkedlist_create_pooled(PENDING_IO_POOL_SIZE);
             if (result->pending_io_list == NULL)
             {
-                /* Codes_SRS_WSIO_01_099: [If singlylinkedlist_create fails then wsio_create shall fail and return NULL.] */
+                /* Codes_SRS_WSIO_01_099: [If singlylinkedlist_create_pooled fails then wsio_create shall fail and return NULL.] */
                 free(result);
                 result = NULL;
             }
@@ -865,7 +869,7 @@ int wsio_close(CONCRETE_IO_HANDLE ws_io, ON_IO_CLOSE_COMPLETE on_io_close_comple
                         }
                     }
 
-                    (void)singlylinkedlist_remove(wsio_instance->pending_io_list, first_pending_io);
+                    (void)singlylinkedlist_remove_head(wsio_instance->pending_io_list);
                 }
             }
 
@@ -0,0 +1,373 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+//
+// PUT NO INCLUDES BEFORE HERE !!!!
+//
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include <stddef.h>
+#include <string.h>
+
+//
+// PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE !!!!
+//
+#include "testrunnerswitcher.h"
+
+void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void my_gballoc_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c.h"
+#include "azure_c_shared_utility/gballoc.h"
+
+#undef ENABLE_MOCKS
+#include "azure_c_shared_utility/arena.h"
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+#define TEST_BLOCK_SIZE 64
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(arena_unittests)
+
+    TEST_SUITE_INITIALIZE(suite_init)
+    {
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+        g_testByTest = TEST_MUTEX_CREATE();
+        ASSERT_IS_NOT_NULL(g_testByTest);
+
+        umock_c_init(on_umock_c_error);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+
+        TEST_MUTEX_DESTROY(g_testByTest);
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(f)
+    {
+        if (TEST_MUTEX_ACQUIRE(g_testByTest))
+        {
+            ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+        }
+
+        umock_c_reset_all_calls();
+    }
+
+    TEST_FUNCTION_CLEANUP(cleans)
+    {
+        TEST_MUTEX_RELEASE(g_testByTest);
+    }
+
+    /*Tests_SRS_ARENA_07_001: [If blockSize is 0, ARENA_create shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_create_with_0_blockSize_fails)
+    {
+        ///arrange
+
+        ///act
+        ARENA_HANDLE handle = ARENA_create(0);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_ARENA_07_002: [ARENA_create shall allocate the arena and return a non-NULL handle to it.]*/
+    /*Tests_SRS_ARENA_07_004: [The memory for the allocations is obtained in blocks of blockSize bytes, the first block shall be allocated by the first ARENA_alloc call.]*/
+    TEST_FUNCTION(ARENA_create_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_003: [If any allocation fails, ARENA_create shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_create_fails_when_malloc_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1)
+            .SetReturn(NULL);
+
+        ///act
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_ARENA_07_005: [If handle is NULL, ARENA_destroy shall do nothing.]*/
+    TEST_FUNCTION(ARENA_destroy_with_NULL_handle_does_nothing)
+    {
+        ///arrange
+
+        ///act
+        ARENA_destroy(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_ARENA_07_006: [ARENA_destroy shall free all the blocks of the arena and the arena itself.]*/
+    TEST_FUNCTION(ARENA_destroy_frees_all_the_blocks)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        (void)ARENA_alloc(handle, TEST_BLOCK_SIZE);
+        (void)ARENA_alloc(handle, TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
+
+        ///act
+        ARENA_destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_ARENA_07_007: [If handle is NULL or size is 0, ARENA_alloc shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_alloc_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        void* result = ARENA_alloc(NULL, 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_ARENA_07_007: [If handle is NULL or size is 0, ARENA_alloc shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_alloc_with_0_size_fails)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = ARENA_alloc(handle, 0);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_008: [ARENA_alloc shall return a pointer to size bytes of memory, aligned for any basic type, that stays valid until the next ARENA_reset or ARENA_destroy.]*/
+    /*Tests_SRS_ARENA_07_010: [If the remaining blocks cannot hold size bytes, ARENA_alloc shall allocate a new block of blockSize bytes, or of size bytes if size is bigger than blockSize.]*/
+    TEST_FUNCTION(ARENA_alloc_allocates_one_block_for_several_allocations)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        unsigned char* result1 = (unsigned char*)ARENA_alloc(handle, 1);
+        unsigned char* result2 = (unsigned char*)ARENA_alloc(handle, 3);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result1);
+        ASSERT_IS_NOT_NULL(result2);
+        ASSERT_IS_TRUE(result2 > result1);
+        ASSERT_ARE_EQUAL(size_t, 0, ((size_t)(result2 - result1)) % sizeof(void*));
+        (void)memset(result1, 1, 1);
+        (void)memset(result2, 2, 3);
+        ASSERT_ARE_EQUAL(int, 1, result1[0]);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_010: [If the remaining blocks cannot hold size bytes, ARENA_alloc shall allocate a new block of blockSize bytes, or of size bytes if size is bigger than blockSize.]*/
+    TEST_FUNCTION(ARENA_alloc_bigger_than_blockSize_succeeds)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        unsigned char* result = (unsigned char*)ARENA_alloc(handle, TEST_BLOCK_SIZE * 4);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        (void)memset(result, 0, TEST_BLOCK_SIZE * 4);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_011: [If allocating the new block fails, ARENA_alloc shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_alloc_fails_when_malloc_fails)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1)
+            .SetReturn(NULL);
+
+        ///act
+        void* result = ARENA_alloc(handle, 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_009: [ARENA_alloc shall reuse the blocks kept by ARENA_reset before allocating new ones.]*/
+    /*Tests_SRS_ARENA_07_016: [ARENA_reset shall release all the allocations made since the arena was created or last reset, without freeing the blocks that hold them.]*/
+    TEST_FUNCTION(ARENA_alloc_after_ARENA_reset_reuses_the_blocks)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        void* first1 = ARENA_alloc(handle, TEST_BLOCK_SIZE);
+        void* first2 = ARENA_alloc(handle, TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        ARENA_reset(handle);
+        void* second1 = ARENA_alloc(handle, TEST_BLOCK_SIZE);
+        void* second2 = ARENA_alloc(handle, TEST_BLOCK_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, first1, second1);
+        ASSERT_ARE_EQUAL(void_ptr, first2, second2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_015: [If handle is NULL, ARENA_reset shall do nothing.]*/
+    TEST_FUNCTION(ARENA_reset_with_NULL_handle_does_nothing)
+    {
+        ///arrange
+
+        ///act
+        ARENA_reset(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_ARENA_07_012: [If handle or source is NULL, ARENA_strdup shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_strdup_with_NULL_source_fails)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        char* result = ARENA_strdup(handle, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_013: [ARENA_strdup shall copy source (including the terminating '\0') in memory obtained with ARENA_alloc and return the copy.]*/
+    TEST_FUNCTION(ARENA_strdup_succeeds)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        const char* source = "some string";
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        char* result = ARENA_strdup(handle, source);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, source, result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, source, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+    /*Tests_SRS_ARENA_07_014: [If ARENA_alloc fails, ARENA_strdup shall fail and return NULL.]*/
+    TEST_FUNCTION(ARENA_strdup_fails_when_malloc_fails)
+    {
+        ///arrange
+        ARENA_HANDLE handle = ARENA_create(TEST_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1)
+            .SetReturn(NULL);
+
+        ///act
+        char* result = ARENA_strdup(handle, "some string");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(handle);
+    }
+
+END_TEST_SUITE(arena_unittests)
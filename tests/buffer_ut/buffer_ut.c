@@ -1196,4 +1196,566 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
         BUFFER_delete(res);
     }
 
+    /* Tests_SRS_BUFFER_07_030: [When BUFFER_enlarge or BUFFER_append need more memory than the current capacity, the capacity shall grow to the bigger of twice the current capacity and the needed size.] */
+    TEST_FUNCTION(BUFFER_enlarge_within_capacity_does_not_realloc)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer;
+        g_hBuffer = BUFFER_new();
+        int nResult = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        nResult = BUFFER_enlarge(g_hBuffer, 1);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_enlarge(g_hBuffer, ALLOCATION_SIZE - 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, nResult, 0);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_030: [When BUFFER_enlarge or BUFFER_append need more memory than the current capacity, the capacity shall grow to the bigger of twice the current capacity and the needed size.] */
+    TEST_FUNCTION(BUFFER_append_grows_capacity_geometrically)
+    {
+        ///arrange
+        BUFFER_HANDLE handle1 = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        BUFFER_HANDLE handle2 = BUFFER_create(BUFFER_Test2, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * BUFFER_TEST1_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int nResult1 = BUFFER_append(handle1, handle2);
+        int nResult2 = BUFFER_append(handle1, handle2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult1);
+        ASSERT_ARE_EQUAL(int, 0, nResult2);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + 2, BUFFER_length(handle1));
+        ASSERT_ARE_EQUAL(size_t, 2 * BUFFER_TEST1_SIZE, BUFFER_capacity(handle1));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(handle1), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(handle1);
+        BUFFER_delete(handle2);
+    }
+
+    /* Tests_SRS_BUFFER_07_031: [If handle is NULL, BUFFER_reserve shall return a nonzero value.] */
+    TEST_FUNCTION(BUFFER_reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int nResult = BUFFER_reserve(NULL, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_033: [Otherwise BUFFER_reserve shall reallocate the underlying memory to hold exactly capacity bytes, keeping the content and the size of the buffer, and return zero.] */
+    TEST_FUNCTION(BUFFER_reserve_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, TOTAL_ALLOCATION_SIZE + 1))
+            .IgnoreArgument(1);
+
+        ///act
+        int nResult = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE + 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE + 1, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_033: [Otherwise BUFFER_reserve shall reallocate the underlying memory to hold exactly capacity bytes, keeping the content and the size of the buffer, and return zero.] */
+    TEST_FUNCTION(BUFFER_append_after_BUFFER_reserve_does_not_realloc)
+    {
+        ///arrange
+        BUFFER_HANDLE handle1 = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        BUFFER_HANDLE handle2 = BUFFER_create(ADDITIONAL_BUFFER, ALLOCATION_SIZE);
+        int nResult = BUFFER_reserve(handle1, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        nResult = BUFFER_append(handle1, handle2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(handle1), TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(handle1);
+        BUFFER_delete(handle2);
+    }
+
+    /* Tests_SRS_BUFFER_07_032: [If capacity is not bigger than the current capacity, BUFFER_reserve shall do nothing and return zero.] */
+    TEST_FUNCTION(BUFFER_reserve_with_smaller_capacity_does_nothing)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int nResult = BUFFER_reserve(g_hBuffer, ALLOCATION_SIZE - 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_034: [If reallocating fails, BUFFER_reserve shall return a nonzero value and the buffer shall be unchanged.] */
+    TEST_FUNCTION(BUFFER_reserve_fails_when_realloc_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        whenShallrealloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, TOTAL_ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int nResult = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_035: [If handle is NULL, BUFFER_shrink_to_fit shall return a nonzero value.] */
+    TEST_FUNCTION(BUFFER_shrink_to_fit_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int nResult = BUFFER_shrink_to_fit(NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_037: [Otherwise BUFFER_shrink_to_fit shall reallocate the underlying memory to the size of the buffer and return zero.] */
+    TEST_FUNCTION(BUFFER_shrink_to_fit_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        int nResult = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        nResult = BUFFER_shrink_to_fit(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_036: [If the capacity does not exceed the size of the buffer, BUFFER_shrink_to_fit shall do nothing and return zero.] */
+    TEST_FUNCTION(BUFFER_shrink_to_fit_when_already_fit_does_nothing)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int nResult = BUFFER_shrink_to_fit(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_038: [If reallocating fails, BUFFER_shrink_to_fit shall return a nonzero value and the buffer shall be unchanged.] */
+    TEST_FUNCTION(BUFFER_shrink_to_fit_fails_when_realloc_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        int nResult = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        currentrealloc_call = 0;
+        whenShallrealloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        nResult = BUFFER_shrink_to_fit(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_capacity(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_040: [If handle is NULL, BUFFER_capacity shall return 0.] */
+    TEST_FUNCTION(BUFFER_capacity_with_NULL_handle_returns_0)
+    {
+        ///arrange
+
+        ///act
+        size_t capacity = BUFFER_capacity(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, capacity);
+    }
+
+    /* Tests_SRS_BUFFER_07_047: [If source is NULL and size is not 0, BUFFER_create_with_headroom shall return NULL.] */
+    TEST_FUNCTION(BUFFER_create_with_headroom_with_NULL_source_fails)
+    {
+        ///arrange
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_headroom(NULL, 1, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(res);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_048: [BUFFER_create_with_headroom shall allocate one block for headroom bytes followed by size bytes and shall copy size bytes from source after the headroom.] */
+    TEST_FUNCTION(BUFFER_create_with_headroom_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(ALLOCATION_SIZE + BUFFER_TEST1_SIZE));
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_headroom(BUFFER_Test1, BUFFER_TEST1_SIZE, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(res);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE, BUFFER_length(res));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_headroom(res));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(res), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(res);
+    }
+
+    /* Tests_SRS_BUFFER_07_050: [If allocating memory fails, BUFFER_create_with_headroom shall return NULL.] */
+    TEST_FUNCTION(BUFFER_create_with_headroom_fails_when_gballoc_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(ALLOCATION_SIZE + BUFFER_TEST1_SIZE));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        whenShallmalloc_fail = 2;
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_headroom(BUFFER_Test1, BUFFER_TEST1_SIZE, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(res);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_041: [If the headroom of the buffer can hold the new bytes, BUFFER_prepend and BUFFER_push_front shall copy them in the headroom, without copying the content of the buffer.] */
+    /* Tests_SRS_BUFFER_07_049: [Prepending up to headroom bytes to the new buffer shall not allocate memory nor copy its content.] */
+    TEST_FUNCTION(BUFFER_prepend_uses_the_headroom)
+    {
+        ///arrange
+        BUFFER_HANDLE handle1 = BUFFER_create_with_headroom(BUFFER_Test2, BUFFER_TEST2_SIZE, ALLOCATION_SIZE);
+        BUFFER_HANDLE handle2 = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        unsigned char* payload = BUFFER_u_char(handle1);
+        umock_c_reset_all_calls();
+
+        ///act
+        int nResult = BUFFER_prepend(handle1, handle2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE, BUFFER_length(handle1));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE - BUFFER_TEST1_SIZE, BUFFER_headroom(handle1));
+        ASSERT_ARE_EQUAL(void_ptr, payload - BUFFER_TEST1_SIZE, BUFFER_u_char(handle1));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(handle1), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(handle1) + BUFFER_TEST1_SIZE, BUFFER_Test2, BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(handle1);
+        BUFFER_delete(handle2);
+    }
+
+    /* Tests_SRS_BUFFER_07_043: [If handle is NULL, or source is NULL and size is not 0, BUFFER_push_front shall return a nonzero value.] */
+    TEST_FUNCTION(BUFFER_push_front_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int nResult = BUFFER_push_front(NULL, BUFFER_Test1, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_044: [If size is 0, BUFFER_push_front shall do nothing and return zero.] */
+    TEST_FUNCTION(BUFFER_push_front_with_size_0_does_nothing)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_Test2, BUFFER_TEST2_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int nResult = BUFFER_push_front(g_hBuffer, NULL, 0);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_041: [If the headroom of the buffer can hold the new bytes, BUFFER_prepend and BUFFER_push_front shall copy them in the headroom, without copying the content of the buffer.] */
+    /* Tests_SRS_BUFFER_07_045: [Otherwise BUFFER_push_front shall put the size bytes at source in front of the content of the buffer and return zero.] */
+    TEST_FUNCTION(BUFFER_push_front_uses_the_headroom)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create_with_headroom(BUFFER_Test2, BUFFER_TEST2_SIZE, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int nResult = BUFFER_push_front(g_hBuffer, BUFFER_Test1, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_headroom(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + BUFFER_TEST1_SIZE, BUFFER_Test2, BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_042: [Otherwise BUFFER_prepend and BUFFER_push_front shall allocate a new block for the new bytes followed by the content of the buffer.] */
+    TEST_FUNCTION(BUFFER_push_front_without_enough_headroom_reallocates)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create_with_headroom(BUFFER_Test2, BUFFER_TEST2_SIZE, BUFFER_TEST1_SIZE - 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        int nResult = BUFFER_push_front(g_hBuffer, BUFFER_Test1, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + BUFFER_TEST1_SIZE, BUFFER_Test2, BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_046: [If any error occurs, BUFFER_push_front shall return a nonzero value and the buffer shall be unchanged.] */
+    TEST_FUNCTION(BUFFER_push_front_fails_when_gballoc_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_Test2, BUFFER_TEST2_SIZE);
+        umock_c_reset_all_calls();
+
+        currentmalloc_call = 0;
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE));
+
+        ///act
+        int nResult = BUFFER_push_front(g_hBuffer, BUFFER_Test1, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test2, BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_052: [If handle is NULL, BUFFER_headroom shall return 0.] */
+    TEST_FUNCTION(BUFFER_headroom_with_NULL_handle_returns_0)
+    {
+        ///arrange
+
+        ///act
+        size_t headroom = BUFFER_headroom(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, headroom);
+    }
+
+    /* Tests_SRS_BUFFER_07_053: [If memory is NULL and size is not 0, BUFFER_create_with_moved_memory shall return NULL.] */
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_with_NULL_memory_fails)
+    {
+        ///arrange
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(NULL, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(res);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_054: [Otherwise BUFFER_create_with_moved_memory shall return a BUFFER that takes the ownership of memory (which shall have been allocated with malloc) without copying it.] */
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_succeeds)
+    {
+        ///arrange
+        unsigned char* memory = (unsigned char*)malloc(ALLOCATION_SIZE);
+        (void)memcpy(memory, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(memory, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(res);
+        ASSERT_ARE_EQUAL(void_ptr, memory, BUFFER_u_char(res));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(res));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(res);
+    }
+
+    /* Tests_SRS_BUFFER_07_055: [If allocating the BUFFER fails, BUFFER_create_with_moved_memory shall return NULL and the caller shall keep the ownership of memory.] */
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_fails_when_gballoc_fails)
+    {
+        ///arrange
+        unsigned char* memory = (unsigned char*)malloc(ALLOCATION_SIZE);
+
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(memory, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(res);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+    }
+
+    /* Tests_SRS_BUFFER_07_056: [If handle or size is NULL, BUFFER_detach shall return NULL.] */
+    TEST_FUNCTION(BUFFER_detach_with_NULL_handle_fails)
+    {
+        ///arrange
+        size_t size;
+
+        ///act
+        unsigned char* memory = BUFFER_detach(NULL, &size);
+
+        ///assert
+        ASSERT_IS_NULL(memory);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_07_057: [BUFFER_detach shall return the memory holding the content of the buffer (to be freed by the caller with free), set *size to the size of the content and leave the buffer empty, as if created by BUFFER_new.] */
+    TEST_FUNCTION(BUFFER_detach_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        unsigned char* content = BUFFER_u_char(g_hBuffer);
+        size_t size;
+        umock_c_reset_all_calls();
+
+        ///act
+        unsigned char* memory = BUFFER_detach(g_hBuffer, &size);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, content, memory);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, size);
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(g_hBuffer));
+        ASSERT_IS_NULL(BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_07_057: [BUFFER_detach shall return the memory holding the content of the buffer (to be freed by the caller with free), set *size to the size of the content and leave the buffer empty, as if created by BUFFER_new.] */
+    TEST_FUNCTION(BUFFER_detach_with_headroom_returns_the_start_of_the_block)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create_with_headroom(BUFFER_Test1, BUFFER_TEST1_SIZE, ALLOCATION_SIZE);
+        size_t size;
+        umock_c_reset_all_calls();
+
+        ///act
+        unsigned char* memory = BUFFER_detach(g_hBuffer, &size);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE, size);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(memory, BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_headroom(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+        BUFFER_delete(g_hBuffer);
+    }
+
 END_TEST_SUITE(Buffer_UnitTests)
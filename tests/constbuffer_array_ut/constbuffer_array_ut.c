@@ -0,0 +1,538 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+//
+// PUT NO INCLUDES BEFORE HERE !!!!
+//
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include <stddef.h>
+
+//
+// PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE !!!!
+//
+#include "testrunnerswitcher.h"
+
+static size_t currentmalloc_call = 0;
+static size_t whenShallmalloc_fail = 0;
+
+void* my_gballoc_malloc(size_t size)
+{
+    void* result;
+    currentmalloc_call++;
+    if (whenShallmalloc_fail > 0)
+    {
+        if (currentmalloc_call == whenShallmalloc_fail)
+        {
+            result = NULL;
+        }
+        else
+        {
+            result = malloc(size);
+        }
+    }
+    else
+    {
+        result = malloc(size);
+    }
+    return result;
+}
+
+void my_gballoc_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c.h"
+#include "azure_c_shared_utility/constbuffer.h"
+#include "azure_c_shared_utility/gballoc.h"
+
+#undef ENABLE_MOCKS
+#include "azure_c_shared_utility/constbuffer_array.h"
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+static const unsigned char header[] = { 'h', 'd', 'r' };
+static const unsigned char body[] = { 'b', 'o', 'd', 'y', '!' };
+
+static const CONSTBUFFER headerContent = { header, sizeof(header) };
+static const CONSTBUFFER bodyContent = { body, sizeof(body) };
+
+#define HEADER_HANDLE ((CONSTBUFFER_HANDLE)0x4242)
+#define BODY_HANDLE ((CONSTBUFFER_HANDLE)0x4243)
+
+static CONSTBUFFER_HANDLE my_CONSTBUFFER_Clone(CONSTBUFFER_HANDLE constbufferHandle)
+{
+    return constbufferHandle;
+}
+
+static const CONSTBUFFER* my_CONSTBUFFER_GetContent(CONSTBUFFER_HANDLE constbufferHandle)
+{
+    const CONSTBUFFER* result;
+    if (constbufferHandle == HEADER_HANDLE)
+    {
+        result = &headerContent;
+    }
+    else if (constbufferHandle == BODY_HANDLE)
+    {
+        result = &bodyContent;
+    }
+    else
+    {
+        result = NULL;
+        ASSERT_FAIL("who am I?");
+    }
+    return result;
+}
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(constbuffer_array_unittests)
+
+    TEST_SUITE_INITIALIZE(setsBufferTempSize)
+    {
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+        g_testByTest = TEST_MUTEX_CREATE();
+        ASSERT_IS_NOT_NULL(g_testByTest);
+
+        umock_c_init(on_umock_c_error);
+
+        REGISTER_UMOCK_ALIAS_TYPE(CONSTBUFFER_HANDLE, void*);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+        REGISTER_GLOBAL_MOCK_HOOK(CONSTBUFFER_Clone, my_CONSTBUFFER_Clone);
+        REGISTER_GLOBAL_MOCK_HOOK(CONSTBUFFER_GetContent, my_CONSTBUFFER_GetContent);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+
+        TEST_MUTEX_DESTROY(g_testByTest);
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(f)
+    {
+        if (TEST_MUTEX_ACQUIRE(g_testByTest))
+        {
+            ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+        }
+
+        umock_c_reset_all_calls();
+
+        currentmalloc_call = 0;
+        whenShallmalloc_fail = 0;
+    }
+
+    TEST_FUNCTION_CLEANUP(cleans)
+    {
+        TEST_MUTEX_RELEASE(g_testByTest);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_001: [CONSTBUFFER_ARRAY_Create shall allocate an empty array and return a non-NULL handle to it, with the ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_Create_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+
+        ///assert
+        ASSERT_IS_NOT_NULL(array);
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_ARRAY_GetTotalLength(array));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_002: [If any error occurs, CONSTBUFFER_ARRAY_Create shall return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_Create_fails_when_malloc_fails)
+    {
+        ///arrange
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+
+        ///assert
+        ASSERT_IS_NULL(array);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_003: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_Clone shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_Clone_with_NULL_returns_NULL)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_ARRAY_HANDLE clone = CONSTBUFFER_ARRAY_Clone(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(clone);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_004: [Otherwise, CONSTBUFFER_ARRAY_Clone shall increment the reference count and return constbufferArrayHandle.]*/
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_006: [Otherwise, CONSTBUFFER_ARRAY_Destroy shall decrement the reference count.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_Clone_increments_ref_count)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_ARRAY_HANDLE clone = CONSTBUFFER_ARRAY_Clone(array);
+        CONSTBUFFER_ARRAY_Destroy(array); /*only a dec_ref*/
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, array, clone);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(clone);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_005: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_Destroy shall do nothing.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_Destroy_with_NULL_does_nothing)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_ARRAY_Destroy(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_007: [If the reference count reaches zero, CONSTBUFFER_ARRAY_Destroy shall release the reference it holds on every buffer (with CONSTBUFFER_Destroy) and free the array.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_Destroy_releases_the_buffers)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        (void)CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+        (void)CONSTBUFFER_ARRAY_AddFront(array, HEADER_HANDLE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(CONSTBUFFER_Destroy(HEADER_HANDLE));
+        STRICT_EXPECTED_CALL(CONSTBUFFER_Destroy(BODY_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_ARRAY_Destroy(array);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_008: [If constbufferArrayHandle or constbufferHandle is NULL then CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_AddFront_and_AddBack_with_NULL_fail)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        umock_c_reset_all_calls();
+
+        ///act
+        int result1 = CONSTBUFFER_ARRAY_AddFront(NULL, HEADER_HANDLE);
+        int result2 = CONSTBUFFER_ARRAY_AddFront(array, NULL);
+        int result3 = CONSTBUFFER_ARRAY_AddBack(NULL, HEADER_HANDLE);
+        int result4 = CONSTBUFFER_ARRAY_AddBack(array, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result1);
+        ASSERT_ARE_NOT_EQUAL(int, 0, result2);
+        ASSERT_ARE_NOT_EQUAL(int, 0, result3);
+        ASSERT_ARE_NOT_EQUAL(int, 0, result4);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_010: [CONSTBUFFER_ARRAY_AddBack shall insert constbufferHandle after the last buffer of the array, taking a reference on it with CONSTBUFFER_Clone, and return 0.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_AddBack_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(BODY_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(CONSTBUFFER_Clone(BODY_HANDLE));
+
+        ///act
+        int result = CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(size_t, sizeof(body), CONSTBUFFER_ARRAY_GetTotalLength(array));
+        ASSERT_ARE_EQUAL(void_ptr, BODY_HANDLE, CONSTBUFFER_ARRAY_GetBuffer(array, 0));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_009: [CONSTBUFFER_ARRAY_AddFront shall insert constbufferHandle before the first buffer of the array, taking a reference on it with CONSTBUFFER_Clone, and return 0.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_AddFront_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        (void)CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+        umock_c_reset_all_calls();
+
+        /*no reallocation, the storage has room*/
+        STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(HEADER_HANDLE));
+        STRICT_EXPECTED_CALL(CONSTBUFFER_Clone(HEADER_HANDLE));
+
+        ///act
+        int result = CONSTBUFFER_ARRAY_AddFront(array, HEADER_HANDLE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 2, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(size_t, sizeof(header) + sizeof(body), CONSTBUFFER_ARRAY_GetTotalLength(array));
+        ASSERT_ARE_EQUAL(void_ptr, HEADER_HANDLE, CONSTBUFFER_ARRAY_GetBuffer(array, 0));
+        ASSERT_ARE_EQUAL(void_ptr, BODY_HANDLE, CONSTBUFFER_ARRAY_GetBuffer(array, 1));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_009: [CONSTBUFFER_ARRAY_AddFront shall insert constbufferHandle before the first buffer of the array, taking a reference on it with CONSTBUFFER_Clone, and return 0.]*/
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_010: [CONSTBUFFER_ARRAY_AddBack shall insert constbufferHandle after the last buffer of the array, taking a reference on it with CONSTBUFFER_Clone, and return 0.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_keeps_the_order_when_growing)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        size_t i;
+        umock_c_reset_all_calls();
+
+        ///act
+        for (i = 0; i < 5; i++)
+        {
+            ASSERT_ARE_EQUAL(int, 0, CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE));
+            ASSERT_ARE_EQUAL(int, 0, CONSTBUFFER_ARRAY_AddFront(array, HEADER_HANDLE));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 10, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(size_t, 5 * (sizeof(header) + sizeof(body)), CONSTBUFFER_ARRAY_GetTotalLength(array));
+        for (i = 0; i < 10; i++)
+        {
+            ASSERT_ARE_EQUAL(void_ptr, (i < 5) ? HEADER_HANDLE : BODY_HANDLE, CONSTBUFFER_ARRAY_GetBuffer(array, i));
+        }
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_011: [If any error occurs, CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail, leave the array unchanged and return a non-zero value.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_AddBack_fails_when_malloc_fails)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        umock_c_reset_all_calls();
+
+        currentmalloc_call = 0;
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(BODY_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        int result = CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_011: [If any error occurs, CONSTBUFFER_ARRAY_AddFront and CONSTBUFFER_ARRAY_AddBack shall fail, leave the array unchanged and return a non-zero value.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_AddFront_fails_when_CONSTBUFFER_Clone_fails)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(HEADER_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(CONSTBUFFER_Clone(HEADER_HANDLE))
+            .SetReturn(NULL);
+
+        ///act
+        int result = CONSTBUFFER_ARRAY_AddFront(array, HEADER_HANDLE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(size_t, 0, CONSTBUFFER_ARRAY_GetTotalLength(array));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_012: [If constbufferArrayHandle is NULL or the array is empty then CONSTBUFFER_ARRAY_RemoveFront and CONSTBUFFER_ARRAY_RemoveBack shall return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_RemoveFront_and_RemoveBack_on_empty_array_return_NULL)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE result1 = CONSTBUFFER_ARRAY_RemoveFront(array);
+        CONSTBUFFER_HANDLE result2 = CONSTBUFFER_ARRAY_RemoveBack(array);
+        CONSTBUFFER_HANDLE result3 = CONSTBUFFER_ARRAY_RemoveFront(NULL);
+        CONSTBUFFER_HANDLE result4 = CONSTBUFFER_ARRAY_RemoveBack(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result1);
+        ASSERT_IS_NULL(result2);
+        ASSERT_IS_NULL(result3);
+        ASSERT_IS_NULL(result4);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_013: [CONSTBUFFER_ARRAY_RemoveFront shall remove the first buffer of the array and return it; the reference the array held on it passes to the caller.]*/
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_014: [CONSTBUFFER_ARRAY_RemoveBack shall remove the last buffer of the array and return it; the reference the array held on it passes to the caller.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_RemoveFront_and_RemoveBack_succeed)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        (void)CONSTBUFFER_ARRAY_AddBack(array, HEADER_HANDLE);
+        (void)CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+        (void)CONSTBUFFER_ARRAY_AddBack(array, HEADER_HANDLE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(HEADER_HANDLE));
+        STRICT_EXPECTED_CALL(CONSTBUFFER_GetContent(HEADER_HANDLE));
+
+        ///act
+        CONSTBUFFER_HANDLE front = CONSTBUFFER_ARRAY_RemoveFront(array);
+        CONSTBUFFER_HANDLE back = CONSTBUFFER_ARRAY_RemoveBack(array);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, HEADER_HANDLE, front);
+        ASSERT_ARE_EQUAL(void_ptr, HEADER_HANDLE, back);
+        ASSERT_ARE_EQUAL(size_t, 1, CONSTBUFFER_ARRAY_GetCount(array));
+        ASSERT_ARE_EQUAL(size_t, sizeof(body), CONSTBUFFER_ARRAY_GetTotalLength(array));
+        ASSERT_ARE_EQUAL(void_ptr, BODY_HANDLE, CONSTBUFFER_ARRAY_GetBuffer(array, 0));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_015: [If constbufferArrayHandle is NULL then CONSTBUFFER_ARRAY_GetCount and CONSTBUFFER_ARRAY_GetTotalLength shall return 0.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_GetCount_and_GetTotalLength_with_NULL_return_0)
+    {
+        ///arrange
+
+        ///act
+        size_t count = CONSTBUFFER_ARRAY_GetCount(NULL);
+        size_t totalLength = CONSTBUFFER_ARRAY_GetTotalLength(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, count);
+        ASSERT_ARE_EQUAL(size_t, 0, totalLength);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_016: [CONSTBUFFER_ARRAY_GetCount shall return the number of buffers in the array.]*/
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_017: [CONSTBUFFER_ARRAY_GetTotalLength shall return the sum of the sizes of all the buffers in the array, without walking the buffers.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_GetTotalLength_does_not_walk_the_buffers)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        (void)CONSTBUFFER_ARRAY_AddBack(array, HEADER_HANDLE);
+        (void)CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+        umock_c_reset_all_calls();
+
+        ///act
+        size_t count = CONSTBUFFER_ARRAY_GetCount(array);
+        size_t totalLength = CONSTBUFFER_ARRAY_GetTotalLength(array);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 2, count);
+        ASSERT_ARE_EQUAL(size_t, sizeof(header) + sizeof(body), totalLength);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_018: [If constbufferArrayHandle is NULL or index is not smaller than the number of buffers then CONSTBUFFER_ARRAY_GetBuffer shall return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_GetBuffer_with_invalid_args_returns_NULL)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        (void)CONSTBUFFER_ARRAY_AddBack(array, HEADER_HANDLE);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE result1 = CONSTBUFFER_ARRAY_GetBuffer(NULL, 0);
+        CONSTBUFFER_HANDLE result2 = CONSTBUFFER_ARRAY_GetBuffer(array, 1);
+
+        ///assert
+        ASSERT_IS_NULL(result1);
+        ASSERT_IS_NULL(result2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_ARRAY_07_019: [Otherwise CONSTBUFFER_ARRAY_GetBuffer shall return the buffer at index (0 being the front of the array), without taking a reference on it.]*/
+    TEST_FUNCTION(CONSTBUFFER_ARRAY_GetBuffer_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_ARRAY_HANDLE array = CONSTBUFFER_ARRAY_Create();
+        (void)CONSTBUFFER_ARRAY_AddBack(array, BODY_HANDLE);
+        (void)CONSTBUFFER_ARRAY_AddFront(array, HEADER_HANDLE);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE result = CONSTBUFFER_ARRAY_GetBuffer(array, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, BODY_HANDLE, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_ARRAY_Destroy(array);
+    }
+
+END_TEST_SUITE(constbuffer_array_unittests)
@@ -103,6 +103,24 @@ size_t my_BUFFER_length(BUFFER_HANDLE handle)
     return result;
 }
 
+unsigned char* my_BUFFER_detach(BUFFER_HANDLE handle, size_t* size)
+{
+    unsigned char* result;
+    if (handle == BUFFER1_HANDLE)
+    {
+        result = (unsigned char*)malloc(BUFFER1_length);
+        (void)memcpy(result, BUFFER1_u_char, BUFFER1_length);
+        *size = BUFFER1_length;
+    }
+    else
+    {
+        result = NULL;
+        *size = 0;
+        ASSERT_FAIL("who am I?");
+    }
+    return result;
+}
+
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
 static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
@@ -128,6 +146,7 @@ BEGIN_TEST_SUITE(constbuffer_unittests)
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
         REGISTER_GLOBAL_MOCK_HOOK(BUFFER_u_char, my_BUFFER_u_char);
         REGISTER_GLOBAL_MOCK_HOOK(BUFFER_length, my_BUFFER_length);
+        REGISTER_GLOBAL_MOCK_HOOK(BUFFER_detach, my_BUFFER_detach);
     }
 
     TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -595,4 +614,230 @@ BEGIN_TEST_SUITE(constbuffer_unittests)
         ///cleanup
     }
 
+    /*Tests_SRS_CONSTBUFFER_07_001: [If source is NULL and size is different than 0 then CONSTBUFFER_CreateWithMoveMemory shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_with_invalid_args_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(NULL, 1);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_002: [Otherwise CONSTBUFFER_CreateWithMoveMemory shall take the ownership of source (which shall have been allocated with malloc) without copying it, and return a non-NULL handle.]*/
+    /*Tests_SRS_CONSTBUFFER_07_004: [The non-NULL handle returned by CONSTBUFFER_CreateWithMoveMemory shall have its ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_succeeds)
+    {
+        ///arrange
+        unsigned char* source = (unsigned char*)malloc(BUFFER1_length);
+        (void)memcpy(source, BUFFER1_u_char, BUFFER1_length);
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(source, BUFFER1_length);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(void_ptr, source, content->buffer);
+        ASSERT_ARE_EQUAL(size_t, BUFFER1_length, content->size);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_003: [If any error occurs, CONSTBUFFER_CreateWithMoveMemory shall fail, return NULL and leave the ownership of source with the caller.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_fails_when_malloc_fails)
+    {
+        ///arrange
+        unsigned char* source = (unsigned char*)malloc(BUFFER1_length);
+
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(source, BUFFER1_length);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(source);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_005: [If buffer is NULL then CONSTBUFFER_CreateFromBufferWithMove shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromBufferWithMove_with_NULL_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateFromBufferWithMove(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_006: [Otherwise CONSTBUFFER_CreateFromBufferWithMove shall take the memory of buffer with BUFFER_detach, without copying it, and return a non-NULL handle. buffer is left empty.]*/
+    /*Tests_SRS_CONSTBUFFER_07_008: [The non-NULL handle returned by CONSTBUFFER_CreateFromBufferWithMove shall have its ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromBufferWithMove_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(BUFFER_detach(BUFFER1_HANDLE, IGNORED_PTR_ARG))
+            .IgnoreArgument(2);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateFromBufferWithMove(BUFFER1_HANDLE);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, BUFFER1_length, content->size);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER1_u_char, content->buffer, BUFFER1_length));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_007: [If any error occurs, CONSTBUFFER_CreateFromBufferWithMove shall fail, return NULL and leave buffer unchanged.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromBufferWithMove_fails_when_malloc_fails)
+    {
+        ///arrange
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateFromBufferWithMove(BUFFER1_HANDLE);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_009: [If handle is NULL then CONSTBUFFER_CreateSlice shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateSlice_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateSlice(NULL, 0, 1);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_010: [If offset + length exceeds the size of handle then CONSTBUFFER_CreateSlice shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateSlice_out_of_range_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE slice1 = CONSTBUFFER_CreateSlice(handle, 1, BUFFER1_length);
+        CONSTBUFFER_HANDLE slice2 = CONSTBUFFER_CreateSlice(handle, BUFFER1_length + 1, 0);
+
+        ///assert
+        ASSERT_IS_NULL(slice1);
+        ASSERT_IS_NULL(slice2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_011: [Otherwise CONSTBUFFER_CreateSlice shall return a handle whose content is the length bytes of handle starting at offset, referencing the memory of handle without copying it.]*/
+    /*Tests_SRS_CONSTBUFFER_07_014: [The non-NULL handle returned by CONSTBUFFER_CreateSlice shall have its ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateSlice_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        const CONSTBUFFER* parentContent = CONSTBUFFER_GetContent(handle);
+        umock_c_reset_all_calls();
+
+        /*only the slice handle, the payload is not copied*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateSlice(handle, 3, 6);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(slice);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(slice);
+        ASSERT_ARE_EQUAL(void_ptr, parentContent->buffer + 3, content->buffer);
+        ASSERT_ARE_EQUAL(size_t, 6, content->size);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(slice);
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_012: [CONSTBUFFER_CreateSlice shall increment the reference count of the const buffer that owns the memory (handle itself, or the owner of handle when handle is a slice); CONSTBUFFER_Destroy of the slice shall release it.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateSlice_keeps_the_parent_alive)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateSlice(handle, 3, 6);
+        CONSTBUFFER_HANDLE sliceOfSlice = CONSTBUFFER_CreateSlice(slice, 1, 2);
+        CONSTBUFFER_Destroy(handle); /*the slices still hold it*/
+        CONSTBUFFER_Destroy(slice); /*only the slice handle goes away*/
+        umock_c_reset_all_calls();
+
+        /*this is the slice handle*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+        /*this is the content of the parent*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+        /*this is the parent handle*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        ASSERT_ARE_EQUAL(int, 0, memcmp(CONSTBUFFER_GetContent(sliceOfSlice)->buffer, BUFFER1_u_char + 4, 2));
+        CONSTBUFFER_Destroy(sliceOfSlice);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_CONSTBUFFER_07_013: [If any error occurs, CONSTBUFFER_CreateSlice shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateSlice_fails_when_malloc_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        currentmalloc_call = 0;
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateSlice(handle, 0, 1);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        whenShallmalloc_fail = 0;
+        CONSTBUFFER_Destroy(handle);
+    }
+
 END_TEST_SUITE(constbuffer_unittests)
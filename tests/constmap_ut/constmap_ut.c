@@ -420,6 +420,7 @@ BEGIN_TEST_SUITE(constmap_unittests)
 
 
     /*Tests_SRS_CONSTMAP_17_025: [Otherwise if a key exists then ConstMap_ContainsKey shall return true.]*/
+    /*Tests_SRS_CONSTMAP_07_002: [ConstMap_ContainsKey and ConstMap_GetValue shall find key through the lookups of the cloned map, which only read it.]*/
     TEST_FUNCTION(ConstMap_ContainsKey_Success)
     {
         // Arrange
@@ -637,6 +638,7 @@ BEGIN_TEST_SUITE(constmap_unittests)
     }
 
     /* Tests_SRS_CONSTMAP_17_042: [Otherwise, ConstMap_GetValue returns the key's value.]*/
+    /*Tests_SRS_CONSTMAP_07_002: [ConstMap_ContainsKey and ConstMap_GetValue shall find key through the lookups of the cloned map, which only read it.]*/
     TEST_FUNCTION(ConstMap_GetValue_Success)
     {
         // Arrange
@@ -0,0 +1,376 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#if defined(GB_MEASURE_MEMORY_FOR_THIS)
+#undef GB_MEASURE_MEMORY_FOR_THIS
+#endif
+
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/threadapi.h"
+#include "testrunnerswitcher.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+static TEST_MUTEX_HANDLE g_testByTest;
+
+#define ENABLE_MOCKS
+
+#include "umock_c.h"
+#include "umock_c_prod.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    MOCKABLE_FUNCTION(, void*, mock_malloc, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_calloc, size_t, nmemb, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_realloc, void*, ptr, size_t, size);
+    MOCKABLE_FUNCTION(, void, mock_free, void*, ptr);
+#ifdef __cplusplus
+}
+#endif
+
+#undef ENABLE_MOCKS
+
+static void* my_mock_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mock_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mock_free(void* ptr)
+{
+    free(ptr);
+}
+
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+static int allocate_and_free_one_block_thread(void* arg)
+{
+    void* block = gballoc_malloc(200);
+    (void)arg;
+    gballoc_free(block);
+    return 0;
+}
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(GBAlloc_Pool_UnitTests)
+
+TEST_SUITE_INITIALIZE(TestClassInitialize)
+{
+    int result;
+
+    TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mock_malloc, my_mock_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_realloc, my_mock_realloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_free, my_mock_free);
+}
+
+TEST_SUITE_CLEANUP(TestClassCleanup)
+{
+    umock_c_deinit();
+    TEST_MUTEX_DESTROY(g_testByTest);
+
+    TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+}
+
+TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+{
+    gballoc_deinit();
+
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+/* gballoc_malloc */
+
+/* Tests_SRS_GBALLOC_07_012: [If no block can be obtained from the pool, gballoc_malloc shall fall back to the underlying malloc.] */
+/* this is the only test using the 97..128 bytes size class, so the pool for that class is still empty when it runs */
+TEST_FUNCTION(when_allocating_a_slab_fails_gballoc_malloc_falls_back_to_malloc)
+{
+    // arrange
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1)
+        .SetReturn((void*)NULL);
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    void* result = gballoc_malloc(100);
+    gballoc_free(result);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getPoolRequestCount());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getPoolHitCount());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* Tests_SRS_GBALLOC_07_010: [When GB_POOLED_ALLOCATIONS is defined gballoc_malloc shall serve sizes up to 256 bytes from the pool of the smallest size class that can hold size bytes.] */
+/* Tests_SRS_GBALLOC_07_011: [When GB_POOLED_ALLOCATIONS is defined gballoc_free shall return pooled blocks to the pool instead of calling the underlying free.] */
+TEST_FUNCTION(gballoc_malloc_of_a_small_size_reuses_a_pooled_block_without_calling_malloc)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(20);
+    gballoc_free(block);
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = gballoc_malloc(20);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, block, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 20, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_07_011: [When GB_POOLED_ALLOCATIONS is defined gballoc_free shall return pooled blocks to the pool instead of calling the underlying free.] */
+TEST_FUNCTION(gballoc_free_of_a_pooled_block_does_not_call_free)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(1);
+    umock_c_reset_all_calls();
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getMaximumMemoryUsed());
+}
+
+/* Tests_SRS_GBALLOC_07_010: [When GB_POOLED_ALLOCATIONS is defined gballoc_malloc shall serve sizes up to 256 bytes from the pool of the smallest size class that can hold size bytes.] */
+TEST_FUNCTION(gballoc_malloc_of_a_size_bigger_than_the_biggest_size_class_calls_malloc)
+{
+    // arrange
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    void* result = gballoc_malloc(257);
+    gballoc_free(result);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getPoolRequestCount());
+}
+
+/* gballoc_realloc */
+
+/* Tests_SRS_GBALLOC_07_015: [When GB_POOLED_ALLOCATIONS is defined and ptr is a pooled block whose size class can hold size bytes, gballoc_realloc shall return ptr without calling the underlying realloc.] */
+TEST_FUNCTION(gballoc_realloc_of_a_pooled_block_within_its_size_class_returns_the_same_block)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(33);
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = gballoc_realloc(block, 48);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, block, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 48, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_07_016: [Otherwise gballoc_realloc shall allocate a new block with gballoc_malloc, copy the contents and free the pooled block.] */
+TEST_FUNCTION(gballoc_realloc_of_a_pooled_block_outside_its_size_class_copies_the_contents)
+{
+    // arrange
+    (void)gballoc_init();
+    unsigned char* block = (unsigned char*)gballoc_malloc(3);
+    block[0] = 'a';
+    block[1] = 'b';
+    block[2] = 'c';
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    unsigned char* result = (unsigned char*)gballoc_realloc(block, 1000);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, memcmp(result, "abc", 3));
+    ASSERT_ARE_EQUAL(size_t, 1000, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* gballoc_getPoolRequestCount */
+
+/* Tests_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+TEST_FUNCTION(gballoc_getPoolRequestCount_without_init_fails)
+{
+    // arrange
+
+    // act
+    size_t result = gballoc_getPoolRequestCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+}
+
+/* Tests_SRS_GBALLOC_07_017: [gballoc_getPoolRequestCount shall return the number of allocations that were requested from the pool since the module initialization.] */
+/* Tests_SRS_GBALLOC_07_013: [Every pooled allocation request shall be counted, and it shall be counted as a hit when it did not need a new slab.] */
+TEST_FUNCTION(gballoc_getPoolRequestCount_returns_the_number_of_small_allocations)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block1 = gballoc_malloc(1);
+    void* block2 = gballoc_calloc(2, 8);
+    void* block3 = gballoc_malloc(1024);
+
+    // act
+    size_t result = gballoc_getPoolRequestCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, result);
+
+    // cleanup
+    gballoc_free(block1);
+    gballoc_free(block2);
+    gballoc_free(block3);
+}
+
+/* gballoc_getPoolHitCount */
+
+/* Tests_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+TEST_FUNCTION(gballoc_getPoolHitCount_without_init_fails)
+{
+    // arrange
+
+    // act
+    size_t result = gballoc_getPoolHitCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+}
+
+/* Tests_SRS_GBALLOC_07_018: [gballoc_getPoolHitCount shall return the number of pooled allocations that were served without allocating a new slab since the module initialization.] */
+TEST_FUNCTION(gballoc_getPoolHitCount_counts_allocations_served_from_free_blocks)
+{
+    // arrange
+    void* block = gballoc_malloc(64);
+    gballoc_free(block);
+    (void)gballoc_init();
+    block = gballoc_malloc(64);
+
+    // act
+    size_t result = gballoc_getPoolHitCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, result);
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getPoolRequestCount());
+
+    // cleanup
+    gballoc_free(block);
+}
+
+/* Tests_SRS_GBALLOC_07_031: [When GB_POOLED_ALLOCATIONS is defined the blocks cached by a thread shall be given back to the pool shared by all threads when the thread exits.] */
+/* this is the only test using the 193..256 bytes size class, so its slab is allocated by the thread */
+TEST_FUNCTION(blocks_cached_by_a_thread_that_exited_are_reused_by_other_threads)
+{
+    // arrange
+    THREAD_HANDLE thread;
+    int threadResult;
+    (void)gballoc_init();
+    ASSERT_ARE_EQUAL(int, (int)THREADAPI_OK, (int)ThreadAPI_Create(&thread, allocate_and_free_one_block_thread, NULL));
+    ASSERT_ARE_EQUAL(int, (int)THREADAPI_OK, (int)ThreadAPI_Join(thread, &threadResult));
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = gballoc_malloc(200);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getPoolHitCount());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_07_032: [When GB_POOLED_ALLOCATIONS is defined gballoc_deinit shall give the blocks cached by the calling thread back to the pool shared by all threads.] */
+TEST_FUNCTION(gballoc_deinit_keeps_the_blocks_cached_by_the_calling_thread_in_the_pool)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(20);
+    gballoc_free(block);
+    gballoc_deinit();
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = gballoc_malloc(20);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getPoolHitCount());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+END_TEST_SUITE(GBAlloc_Pool_UnitTests)
@@ -0,0 +1,495 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#if defined(GB_MEASURE_MEMORY_FOR_THIS)
+#undef GB_MEASURE_MEMORY_FOR_THIS
+#endif
+
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "testrunnerswitcher.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+static TEST_MUTEX_HANDLE g_testByTest;
+
+#define ENABLE_MOCKS
+
+#include "umock_c.h"
+#include "umock_c_prod.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    MOCKABLE_FUNCTION(, void*, mock_malloc, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_calloc, size_t, nmemb, size_t, size);
+    MOCKABLE_FUNCTION(, void*, mock_realloc, void*, ptr, size_t, size);
+    MOCKABLE_FUNCTION(, void, mock_free, void*, ptr);
+#ifdef __cplusplus
+}
+#endif
+
+#undef ENABLE_MOCKS
+
+static void* my_mock_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mock_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mock_free(void* ptr)
+{
+    free(ptr);
+}
+
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(GBAlloc_Sharded_UnitTests)
+
+TEST_SUITE_INITIALIZE(TestClassInitialize)
+{
+    int result;
+
+    TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mock_malloc, my_mock_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_realloc, my_mock_realloc);
+    REGISTER_GLOBAL_MOCK_HOOK(mock_free, my_mock_free);
+}
+
+TEST_SUITE_CLEANUP(TestClassCleanup)
+{
+    umock_c_deinit();
+    TEST_MUTEX_DESTROY(g_testByTest);
+
+    TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+}
+
+TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+{
+    gballoc_deinit();
+
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+/* gballoc_init */
+
+/* Tests_SRS_GBALLOC_07_007: [When GB_SHARDED_ACCOUNTING is defined gballoc_init shall not create a lock.] */
+/* Tests_SRS_GBALLOC_01_024: [gballoc_init shall initialize the gballoc module and return 0 upon success.] */
+TEST_FUNCTION(gballoc_init_in_sharded_mode_does_not_create_a_lock)
+{
+    // arrange
+
+    // act
+    int result = gballoc_init();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getMaximumMemoryUsed());
+}
+
+/* Tests_SRS_GBALLOC_01_025: [Init after Init shall fail and return a non-zero value.] */
+TEST_FUNCTION(gballoc_init_after_gballoc_init_in_sharded_mode_fails)
+{
+    // arrange
+    (void)gballoc_init();
+
+    // act
+    int result = gballoc_init();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* gballoc_malloc */
+
+/* Tests_SRS_GBALLOC_07_002: [When GB_SHARDED_ACCOUNTING is defined gballoc_malloc shall allocate with one underlying malloc call room for a header followed by size bytes, store size in the header and return the address that follows the header.] */
+/* Tests_SRS_GBALLOC_07_003: [When GB_SHARDED_ACCOUNTING is defined gballoc_malloc, gballoc_calloc, gballoc_realloc and gballoc_free shall not acquire any lock and shall update the counters of the shard assigned to the calling thread with atomic operations.] */
+TEST_FUNCTION(gballoc_malloc_in_sharded_mode_calls_malloc_once_and_counts_the_size)
+{
+    // arrange
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    unsigned char* result = (unsigned char*)gballoc_malloc(42);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 42, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 42, gballoc_getMaximumMemoryUsed());
+    (void)memset(result, 0xAA, 42);
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_01_012: [When the underlying malloc call fails, gballoc_malloc shall return NULL and size should not be counted towards total memory used.] */
+TEST_FUNCTION(when_malloc_fails_gballoc_malloc_in_sharded_mode_fails)
+{
+    // arrange
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1)
+        .SetReturn((void*)NULL);
+
+    // act
+    void* result = gballoc_malloc(42);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* Tests_SRS_GBALLOC_07_008: [When GB_SHARDED_ACCOUNTING is defined blocks allocated while gballoc is not initialized shall carry a header but shall never be counted.] */
+TEST_FUNCTION(gballoc_free_in_sharded_mode_of_a_block_allocated_before_init_does_not_change_the_counters)
+{
+    // arrange
+    void* block = gballoc_malloc(10);
+    (void)gballoc_init();
+    void* other = gballoc_malloc(3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 3, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(other);
+}
+
+/* gballoc_calloc */
+
+/* Tests_SRS_GBALLOC_01_021: [If the underlying calloc call is successful, gballoc_calloc shall increment the total memory used with nmemb*size.] */
+TEST_FUNCTION(gballoc_calloc_in_sharded_mode_returns_zeroed_memory_and_counts_nmemb_times_size)
+{
+    // arrange
+    size_t i;
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    unsigned char* result = (unsigned char*)gballoc_calloc(3, 7);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    for (i = 0; i < 21; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, (int)result[i]);
+    }
+    ASSERT_ARE_EQUAL(size_t, 21, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* gballoc_realloc */
+
+/* Tests_SRS_GBALLOC_01_006: [If the underlying realloc call is successful, gballoc_realloc shall look up the size associated with the pointer ptr and decrease the total memory used with that size.] */
+/* Tests_SRS_GBALLOC_01_007: [If realloc is successful, gballoc_realloc shall also increment the total memory used value tracked by this module.] */
+TEST_FUNCTION(gballoc_realloc_in_sharded_mode_replaces_the_counted_size)
+{
+    // arrange
+    (void)gballoc_init();
+    unsigned char* block = (unsigned char*)gballoc_malloc(2);
+    block[0] = 'a';
+    block[1] = 'b';
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+        .IgnoreAllArguments();
+
+    // act
+    unsigned char* result = (unsigned char*)gballoc_realloc(block, 10);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, (int)'a', (int)result[0]);
+    ASSERT_ARE_EQUAL(int, (int)'b', (int)result[1]);
+    ASSERT_ARE_EQUAL(size_t, 10, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 10, gballoc_getMaximumMemoryUsed());
+
+    // cleanup
+    gballoc_free(result);
+}
+
+/* Tests_SRS_GBALLOC_01_014: [When the underlying realloc call fails, gballoc_realloc shall return NULL and no change should be made to the counted total memory usage.] */
+TEST_FUNCTION(when_realloc_fails_gballoc_realloc_in_sharded_mode_fails_and_keeps_the_counters)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+        .IgnoreAllArguments()
+        .SetReturn((void*)NULL);
+
+    // act
+    void* result = gballoc_realloc(block, 10);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 2, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(block);
+}
+
+/* Tests_SRS_GBALLOC_07_009: [When GB_SHARDED_ACCOUNTING is defined and the header in front of ptr was not written by gballoc, gballoc_realloc shall return NULL without calling the underlying realloc and gballoc_free shall not free any memory.] */
+TEST_FUNCTION(gballoc_realloc_in_sharded_mode_with_an_untracked_pointer_fails)
+{
+    // arrange
+    unsigned char notAllocatedByGballoc[128];
+    (void)memset(notAllocatedByGballoc, 0, sizeof(notAllocatedByGballoc));
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = gballoc_realloc(notAllocatedByGballoc + 64, 10);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* gballoc_free */
+
+/* Tests_SRS_GBALLOC_07_004: [When GB_SHARDED_ACCOUNTING is defined gballoc_free shall decrement the shard that accounted for the block, regardless of the thread calling gballoc_free.] */
+/* Tests_SRS_GBALLOC_01_008: [gballoc_free shall call the C99 free function.] */
+TEST_FUNCTION(gballoc_free_in_sharded_mode_frees_the_block_and_decrements_the_counters)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block1 = gballoc_malloc(5);
+    void* block2 = gballoc_malloc(6);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    gballoc_free(block1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 6, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 11, gballoc_getMaximumMemoryUsed());
+
+    // cleanup
+    gballoc_free(block2);
+}
+
+/* Tests_SRS_GBALLOC_07_009: [When GB_SHARDED_ACCOUNTING is defined and the header in front of ptr was not written by gballoc, gballoc_realloc shall return NULL without calling the underlying realloc and gballoc_free shall not free any memory.] */
+TEST_FUNCTION(gballoc_free_in_sharded_mode_with_an_untracked_pointer_does_not_free_anything)
+{
+    // arrange
+    unsigned char notAllocatedByGballoc[128];
+    (void)memset(notAllocatedByGballoc, 0, sizeof(notAllocatedByGballoc));
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    gballoc_free(notAllocatedByGballoc + 64);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_07_008: [When GB_SHARDED_ACCOUNTING is defined blocks allocated while gballoc is not initialized shall carry a header but shall never be counted.] */
+TEST_FUNCTION(gballoc_free_in_sharded_mode_of_a_block_accounted_before_a_reinit_does_not_change_the_counters)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(5);
+    gballoc_deinit();
+    (void)gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+}
+
+/* Tests_SRS_GBALLOC_07_033: [When GB_SHARDED_ACCOUNTING is defined gballoc_free and gballoc_realloc shall only change the counters for blocks that were counted since the last gballoc_init.] */
+TEST_FUNCTION(gballoc_free_in_sharded_mode_of_a_block_accounted_128_inits_ago_does_not_change_the_counters)
+{
+    // arrange
+    size_t i;
+    (void)gballoc_init();
+    void* block = gballoc_malloc(5);
+    gballoc_deinit();
+    for (i = 0; i < 127; i++)
+    {
+        (void)gballoc_init();
+        gballoc_deinit();
+    }
+    (void)gballoc_init();
+    void* otherBlock = gballoc_malloc(3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_free(IGNORED_PTR_ARG))
+        .IgnoreArgument(1);
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 3, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(otherBlock);
+}
+
+/* gballoc_getMaximumMemoryUsed */
+
+/* Tests_SRS_GBALLOC_01_038: [If gballoc was not initialized gballoc_getMaximumMemoryUsed shall return MAX_INT_SIZE.] */
+TEST_FUNCTION(gballoc_getMaximumMemoryUsed_in_sharded_mode_without_init_fails)
+{
+    // arrange
+
+    // act
+    size_t result = gballoc_getMaximumMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+}
+
+/* Tests_SRS_GBALLOC_07_006: [When GB_SHARDED_ACCOUNTING is defined gballoc_getMaximumMemoryUsed shall return the sum of the maximum values reached by each shard, which is an upper bound of the maximum total memory used.] */
+TEST_FUNCTION(gballoc_getMaximumMemoryUsed_in_sharded_mode_returns_the_peak)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block = gballoc_malloc(5);
+    gballoc_free(block);
+    block = gballoc_malloc(3);
+
+    // act
+    size_t result = gballoc_getMaximumMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 5, result);
+
+    // cleanup
+    gballoc_free(block);
+}
+
+/* gballoc_getCurrentMemoryUsed */
+
+/* Tests_SRS_GBALLOC_01_044: [If gballoc was not initialized gballoc_getCurrentMemoryUsed shall return SIZE_MAX.] */
+TEST_FUNCTION(gballoc_getCurrentMemoryUsed_in_sharded_mode_without_init_fails)
+{
+    // arrange
+
+    // act
+    size_t result = gballoc_getCurrentMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+}
+
+/* Tests_SRS_GBALLOC_07_005: [When GB_SHARDED_ACCOUNTING is defined gballoc_getCurrentMemoryUsed shall return the sum of the counters of all the shards.] */
+TEST_FUNCTION(gballoc_getCurrentMemoryUsed_in_sharded_mode_sums_all_allocations)
+{
+    // arrange
+    (void)gballoc_init();
+    void* block1 = gballoc_malloc(1);
+    void* block2 = gballoc_calloc(2, 3);
+
+    // act
+    size_t result = gballoc_getCurrentMemoryUsed();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 7, result);
+
+    // cleanup
+    gballoc_free(block1);
+    gballoc_free(block2);
+}
+
+/* gballoc_getAllocationSites */
+
+/* Tests_SRS_GBALLOC_07_019: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc.] */
+/* Tests_SRS_GBALLOC_07_028: [When GB_SHARDED_ACCOUNTING is defined allocation sites are not recorded and gballoc_getAllocationSites shall return 0.] */
+TEST_FUNCTION(gballoc_getAllocationSites_in_sharded_mode_returns_0)
+{
+    // arrange
+    GBALLOC_ALLOCATION_SITE sites[1];
+    (void)gballoc_init();
+    void* block = gballoc_malloc_at(3, "file.c", 42);
+
+    // act
+    size_t result = gballoc_getAllocationSites(sites, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(block);
+}
+
+END_TEST_SUITE(GBAlloc_Sharded_UnitTests)
@@ -974,6 +974,73 @@ TEST_FUNCTION(gballoc_malloc_free_2_times_with_1_byte_yields_1_byte_as_max)
     free(allocation);
 }
 
+/* Tests_SRS_GBALLOC_07_001: [If the underlying realloc returns a different pointer than ptr, gballoc_realloc shall track the size under the new pointer so that it can be found by subsequent gballoc_realloc and gballoc_free calls.] */
+TEST_FUNCTION(gballoc_free_after_realloc_moved_the_block_frees_the_new_block)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(1))
+        .SetReturn(TEST_ALLOC_PTR1);
+    STRICT_EXPECTED_CALL(mock_realloc(TEST_ALLOC_PTR1, 2))
+        .SetReturn(TEST_REALLOC_PTR);
+    void* block = gballoc_malloc(1);
+    block = gballoc_realloc(block, 2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(mock_free(TEST_REALLOC_PTR));
+    STRICT_EXPECTED_CALL(mock_free(allocation));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    gballoc_free(block);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_07_001: [If the underlying realloc returns a different pointer than ptr, gballoc_realloc shall track the size under the new pointer so that it can be found by subsequent gballoc_realloc and gballoc_free calls.] */
+TEST_FUNCTION(gballoc_free_of_the_old_pointer_after_realloc_moved_the_block_does_not_free_anything)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(1))
+        .SetReturn(TEST_ALLOC_PTR1);
+    STRICT_EXPECTED_CALL(mock_realloc(TEST_ALLOC_PTR1, 2))
+        .SetReturn(TEST_REALLOC_PTR);
+    void* block = gballoc_malloc(1);
+    block = gballoc_realloc(block, 2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    gballoc_free(TEST_ALLOC_PTR1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 2, gballoc_getCurrentMemoryUsed());
+
+    // cleanup
+    gballoc_free(block);
+    free(allocation);
+}
+
 /* Tests_SRS_GBALLOC_01_019:[When the ptr pointer cannot be found in the pointers tracked by gballoc, gballoc_free shall not free any memory.] */
 TEST_FUNCTION(gballoc_free_with_an_untracked_pointer_does_not_alter_total_memory_used)
 {
@@ -1511,4 +1578,368 @@ TEST_FUNCTION(when_acquiring_the_lock_fails_gballoc_getCurrentMemoryUsed_fails)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
+/* gballoc_getAllocationSites */
+
+/* Tests_SRS_GBALLOC_07_019: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall behave like gballoc_malloc, gballoc_calloc and gballoc_realloc.] */
+/* Tests_SRS_GBALLOC_07_020: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall attribute a successful allocation to the site identified by file and line by increasing the live bytes, live count, allocation count and allocated bytes of the site.] */
+TEST_FUNCTION(gballoc_malloc_at_records_the_allocation_site)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+    void* siteTable = calloc(OVERHEAD_SIZE, 16);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(3))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_calloc(0, 0))
+        .SetReturn(siteTable);
+
+    // act
+    void* result = gballoc_malloc_at(3, "file.c", 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_PTR1, result);
+    ASSERT_ARE_EQUAL(size_t, 3, gballoc_getCurrentMemoryUsed());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getAllocationSites(sites, 2));
+    ASSERT_ARE_EQUAL(char_ptr, "file.c", sites[0].file);
+    ASSERT_ARE_EQUAL(int, 42, sites[0].line);
+    ASSERT_ARE_EQUAL(size_t, 3, sites[0].liveBytes);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].liveCount);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].allocationCount);
+    ASSERT_ARE_EQUAL(size_t, 3, sites[0].allocatedBytes);
+
+    // cleanup
+    gballoc_free(result);
+    gballoc_deinit();
+    free(siteTable);
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_07_020: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall attribute a successful allocation to the site identified by file and line by increasing the live bytes, live count, allocation count and allocated bytes of the site.] */
+TEST_FUNCTION(gballoc_calloc_at_records_the_allocation_site)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+    void* siteTable = calloc(OVERHEAD_SIZE, 16);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_calloc(2, 3))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_calloc(0, 0))
+        .SetReturn(siteTable);
+
+    // act
+    void* result = gballoc_calloc_at(2, 3, "file.c", 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, TEST_ALLOC_PTR1, result);
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getAllocationSites(sites, 2));
+    ASSERT_ARE_EQUAL(int, 42, sites[0].line);
+    ASSERT_ARE_EQUAL(size_t, 6, sites[0].liveBytes);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].liveCount);
+
+    // cleanup
+    gballoc_free(result);
+    gballoc_deinit();
+    free(siteTable);
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_07_020: [gballoc_malloc_at, gballoc_calloc_at and gballoc_realloc_at shall attribute a successful allocation to the site identified by file and line by increasing the live bytes, live count, allocation count and allocated bytes of the site.] */
+TEST_FUNCTION(gballoc_malloc_does_not_record_an_allocation_site)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(3))
+        .SetReturn(TEST_ALLOC_PTR1);
+
+    // act
+    void* result = gballoc_malloc(3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, gballoc_getAllocationSites(sites, 2));
+
+    // cleanup
+    gballoc_free(result);
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_07_022: [gballoc_free shall decrease the live bytes and live count of the site the block is attributed to.] */
+TEST_FUNCTION(gballoc_free_decreases_the_live_bytes_of_the_allocation_site)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation1 = malloc(OVERHEAD_SIZE);
+    void* allocation2 = malloc(OVERHEAD_SIZE);
+    void* siteTable = calloc(OVERHEAD_SIZE, 16);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation1);
+    STRICT_EXPECTED_CALL(mock_malloc(3))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_calloc(0, 0))
+        .SetReturn(siteTable);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation2);
+    STRICT_EXPECTED_CALL(mock_malloc(5))
+        .SetReturn(TEST_ALLOC_PTR2);
+    void* block1 = gballoc_malloc_at(3, "file.c", 42);
+    void* block2 = gballoc_malloc_at(5, "file.c", 42);
+    umock_c_reset_all_calls();
+
+    // act
+    gballoc_free(block1);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getAllocationSites(sites, 2));
+    ASSERT_ARE_EQUAL(size_t, 5, sites[0].liveBytes);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].liveCount);
+    ASSERT_ARE_EQUAL(size_t, 2, sites[0].allocationCount);
+    ASSERT_ARE_EQUAL(size_t, 8, sites[0].allocatedBytes);
+
+    // cleanup
+    gballoc_free(block2);
+    gballoc_deinit();
+    free(siteTable);
+    free(allocation1);
+    free(allocation2);
+}
+
+/* Tests_SRS_GBALLOC_07_021: [gballoc_realloc_at shall attribute the block to the site of the gballoc_realloc_at call, while gballoc_realloc shall leave the block attributed to its current site.] */
+TEST_FUNCTION(gballoc_realloc_at_moves_the_block_to_its_allocation_site)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+    void* siteTable = calloc(OVERHEAD_SIZE, 16);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(3))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_calloc(0, 0))
+        .SetReturn(siteTable);
+    void* block = gballoc_malloc_at(3, "file.c", 42);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(TEST_ALLOC_PTR1, 7))
+        .SetReturn(TEST_ALLOC_PTR1);
+
+    // act
+    block = gballoc_realloc_at(block, 7, "file.c", 43);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 2, gballoc_getAllocationSites(sites, 2));
+    ASSERT_ARE_EQUAL(int, 43, sites[0].line);
+    ASSERT_ARE_EQUAL(size_t, 7, sites[0].liveBytes);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].liveCount);
+    ASSERT_ARE_EQUAL(int, 42, sites[1].line);
+    ASSERT_ARE_EQUAL(size_t, 0, sites[1].liveBytes);
+    ASSERT_ARE_EQUAL(size_t, 0, sites[1].liveCount);
+
+    // cleanup
+    gballoc_free(block);
+    gballoc_deinit();
+    free(siteTable);
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_07_021: [gballoc_realloc_at shall attribute the block to the site of the gballoc_realloc_at call, while gballoc_realloc shall leave the block attributed to its current site.] */
+TEST_FUNCTION(gballoc_realloc_keeps_the_block_on_its_allocation_site)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation = malloc(OVERHEAD_SIZE);
+    void* siteTable = calloc(OVERHEAD_SIZE, 16);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation);
+    STRICT_EXPECTED_CALL(mock_malloc(3))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_calloc(0, 0))
+        .SetReturn(siteTable);
+    void* block = gballoc_malloc_at(3, "file.c", 42);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mock_realloc(TEST_ALLOC_PTR1, 7))
+        .SetReturn(TEST_ALLOC_PTR1);
+
+    // act
+    block = gballoc_realloc(block, 7);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 1, gballoc_getAllocationSites(sites, 2));
+    ASSERT_ARE_EQUAL(int, 42, sites[0].line);
+    ASSERT_ARE_EQUAL(size_t, 7, sites[0].liveBytes);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].liveCount);
+    ASSERT_ARE_EQUAL(size_t, 1, sites[0].allocationCount);
+
+    // cleanup
+    gballoc_free(block);
+    gballoc_deinit();
+    free(siteTable);
+    free(allocation);
+}
+
+/* Tests_SRS_GBALLOC_07_023: [gballoc_getAllocationSites shall copy to sites the (up to) maxSites sites with the most live bytes, sorted by decreasing live bytes, and return the number of sites copied.] */
+TEST_FUNCTION(gballoc_getAllocationSites_returns_the_top_sites_by_live_bytes)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+    void* allocation1 = malloc(OVERHEAD_SIZE);
+    void* allocation2 = malloc(OVERHEAD_SIZE);
+    void* allocation3 = malloc(OVERHEAD_SIZE);
+    void* siteTable = calloc(OVERHEAD_SIZE, 16);
+    GBALLOC_ALLOCATION_SITE sites[2];
+
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation1);
+    STRICT_EXPECTED_CALL(mock_malloc(3))
+        .SetReturn(TEST_ALLOC_PTR1);
+    EXPECTED_CALL(mock_calloc(0, 0))
+        .SetReturn(siteTable);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation2);
+    STRICT_EXPECTED_CALL(mock_malloc(10))
+        .SetReturn(TEST_ALLOC_PTR2);
+    EXPECTED_CALL(mock_malloc(0))
+        .SetReturn(allocation3);
+    STRICT_EXPECTED_CALL(mock_malloc(5))
+        .SetReturn(TEST_REALLOC_PTR);
+    void* block1 = gballoc_malloc_at(3, "file1.c", 1);
+    void* block2 = gballoc_malloc_at(10, "file2.c", 2);
+    void* block3 = gballoc_malloc_at(5, "file3.c", 3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    size_t result = gballoc_getAllocationSites(sites, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 2, result);
+    ASSERT_ARE_EQUAL(char_ptr, "file2.c", sites[0].file);
+    ASSERT_ARE_EQUAL(size_t, 10, sites[0].liveBytes);
+    ASSERT_ARE_EQUAL(char_ptr, "file3.c", sites[1].file);
+    ASSERT_ARE_EQUAL(size_t, 5, sites[1].liveBytes);
+
+    // cleanup
+    gballoc_free(block1);
+    gballoc_free(block2);
+    gballoc_free(block3);
+    gballoc_deinit();
+    free(siteTable);
+    free(allocation1);
+    free(allocation2);
+    free(allocation3);
+}
+
+/* Tests_SRS_GBALLOC_07_025: [If sites is NULL and maxSites is not 0, gballoc_getAllocationSites shall return 0.] */
+TEST_FUNCTION(gballoc_getAllocationSites_with_NULL_sites_fails)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = gballoc_getAllocationSites(NULL, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_07_026: [If gballoc was not initialized gballoc_getAllocationSites shall return 0.] */
+TEST_FUNCTION(gballoc_getAllocationSites_after_deinit_fails)
+{
+    // arrange
+    GBALLOC_ALLOCATION_SITE sites[1];
+
+    // act
+    size_t result = gballoc_getAllocationSites(sites, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_07_027: [If the lock cannot be acquired, gballoc_getAllocationSites shall return 0.] */
+TEST_FUNCTION(when_acquiring_the_lock_fails_gballoc_getAllocationSites_fails)
+{
+    // arrange
+    GBALLOC_ALLOCATION_SITE sites[1];
+    gballoc_init();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE))
+        .SetReturn(LOCK_ERROR);
+
+    // act
+    size_t result = gballoc_getAllocationSites(sites, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* gballoc_getPoolRequestCount */
+
+/* Tests_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+TEST_FUNCTION(gballoc_getPoolRequestCount_without_pooled_allocations_fails)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = gballoc_getPoolRequestCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_GBALLOC_07_014: [If gballoc was not built with GB_POOLED_ALLOCATIONS or is not initialized, gballoc_getPoolRequestCount and gballoc_getPoolHitCount shall return SIZE_MAX.] */
+TEST_FUNCTION(gballoc_getPoolHitCount_without_pooled_allocations_fails)
+{
+    // arrange
+    gballoc_init();
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = gballoc_getPoolHitCount();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, SIZE_MAX, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
 END_TEST_SUITE(GBAlloc_UnitTests)
@@ -7,6 +7,7 @@
 #endif
 
 #include "testrunnerswitcher.h"
+#include "azure_c_shared_utility/buffer_.h"
 #define ENABLE_MOCKS
 #include "azure_c_shared_utility/strings.h"
 
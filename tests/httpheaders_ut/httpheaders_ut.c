@@ -7,6 +7,7 @@
 #endif
 
 #include <limits.h>
+#include <string.h>
 
 static size_t currentmalloc_call = 0;
 static size_t whenShallmalloc_fail = 0;
@@ -72,7 +73,7 @@ void my_gballoc_free(void* ptr)
 
 #include "azure_c_shared_utility/map.h"
 
-MAP_HANDLE my_Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
+MAP_HANDLE my_Map_CreateWithInternedKeys(MAP_FILTER_CALLBACK mapFilterFunc)
 {
     (void)mapFilterFunc;
     return (MAP_HANDLE)malloc(1);
@@ -90,6 +91,16 @@ void my_Map_Destroy(MAP_HANDLE handle)
 }
 
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/arena.h"
+
+static char arenaMemory[64];
+
+void* my_ARENA_alloc(ARENA_HANDLE handle, size_t size)
+{
+    (void)handle;
+    ASSERT_IS_TRUE(size <= sizeof(arenaMemory));
+    return arenaMemory;
+}
 
 #undef ENABLE_MOCKS
 
@@ -121,6 +132,49 @@ static const char *NAME1_TRICK3 = "name1: value1";
 #define TEMP_BUFFER_SIZE 1024
 static char tempBuffer[TEMP_BUFFER_SIZE];
 
+/*views are compared by content, they are copied shallow since they do not own their characters*/
+static char* umocktypes_stringify_STRING_VIEW(const STRING_VIEW* value)
+{
+    char* result = (char*)malloc(value->length + 3);
+    if (result != NULL)
+    {
+        result[0] = '"';
+        if (value->length > 0)
+        {
+            (void)memcpy(result + 1, value->data, value->length);
+        }
+        result[value->length + 1] = '"';
+        result[value->length + 2] = '\0';
+    }
+    return result;
+}
+
+static int umocktypes_are_equal_STRING_VIEW(const STRING_VIEW* left, const STRING_VIEW* right)
+{
+    int result;
+    if ((left == NULL) || (right == NULL))
+    {
+        result = -1;
+    }
+    else
+    {
+        result = ((left->length == right->length) &&
+            ((left->length == 0) || (memcmp(left->data, right->data, left->length) == 0))) ? 1 : 0;
+    }
+    return result;
+}
+
+static int umocktypes_copy_STRING_VIEW(STRING_VIEW* destination, const STRING_VIEW* source)
+{
+    *destination = *source;
+    return 0;
+}
+
+static void umocktypes_free_STRING_VIEW(STRING_VIEW* value)
+{
+    (void)value;
+}
+
 #define MAX_NAME_VALUE_PAIR 100
 
 static TEST_MUTEX_HANDLE g_dllByDll;
@@ -151,10 +205,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             ASSERT_ARE_EQUAL(int, 0, result);
 
             REGISTER_TYPE(MAP_RESULT, MAP_RESULT);
+            REGISTER_TYPE(STRING_VIEW, STRING_VIEW);
             REGISTER_UMOCK_ALIAS_TYPE(MAP_FILTER_CALLBACK, void*);
             REGISTER_UMOCK_ALIAS_TYPE(MAP_HANDLE, void*);
+            REGISTER_UMOCK_ALIAS_TYPE(ARENA_HANDLE, void*);
 
-            REGISTER_GLOBAL_MOCK_HOOK(Map_Create, my_Map_Create);
+            REGISTER_GLOBAL_MOCK_HOOK(Map_CreateWithInternedKeys, my_Map_CreateWithInternedKeys);
             REGISTER_GLOBAL_MOCK_HOOK(Map_Clone, my_Map_Clone);
             REGISTER_GLOBAL_MOCK_HOOK(Map_Destroy, my_Map_Destroy);
             REGISTER_GLOBAL_MOCK_RETURN(Map_AddOrUpdate, MAP_OK);
@@ -164,6 +220,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
             REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
             REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+            REGISTER_GLOBAL_MOCK_HOOK(ARENA_alloc, my_ARENA_alloc);
         }
 
         TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -197,13 +254,14 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
 
 
         /*Tests_SRS_HTTP_HEADERS_99_002:[ This API shall produce a HTTP_HANDLE that can later be used in subsequent calls to the module.]*/
+        /*Tests_SRS_HTTP_HEADERS_07_003: [The header names shall be interned, so that all the HTTP_HEADERS_HANDLEs share one copy of each name.]*/
         TEST_FUNCTION(HTTPHeaders_Alloc_happy_path_succeeds)
         {
             ///arrange
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
 
-            STRICT_EXPECTED_CALL(Map_Create(IGNORED_PTR_ARG));
+            STRICT_EXPECTED_CALL(Map_CreateWithInternedKeys(IGNORED_PTR_ARG));
 
             ///act
             HTTP_HEADERS_HANDLE handle = HTTPHeaders_Alloc();
@@ -267,12 +325,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
 
 
         /*Tests_SRS_HTTP_HEADERS_99_003:[ The function shall return NULL when the function cannot execute properly]*/
-        TEST_FUNCTION(HTTPHeaders_Alloc_fails_when_Map_Create_fails)
+        TEST_FUNCTION(HTTPHeaders_Alloc_fails_when_Map_CreateWithInternedKeys_fails)
         {
             ///arrange
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(Map_Create(IGNORED_PTR_ARG))
+            STRICT_EXPECTED_CALL(Map_CreateWithInternedKeys(IGNORED_PTR_ARG))
                 .SetReturn(NULL);
 
             STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
@@ -636,6 +694,66 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTPHeaders_Free(httpHandle);
         }
 
+        /*Tests_SRS_HTTP_HEADERS_07_004: [ The return value shall be NULL if httpHeadersHandle is NULL or if the data of name is NULL.]*/
+        TEST_FUNCTION(HTTPHeaders_FindHeaderValueView_with_NULL_handle_returns_NULL)
+        {
+            ///arrange
+            STRING_VIEW name;
+            name.data = NAME1;
+            name.length = strlen(NAME1);
+
+            ///act
+            const char* res = HTTPHeaders_FindHeaderValueView(NULL, name);
+
+            ///assert
+            ASSERT_IS_NULL(res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_07_004: [ The return value shall be NULL if httpHeadersHandle is NULL or if the data of name is NULL.]*/
+        TEST_FUNCTION(HTTPHeaders_FindHeaderValueView_with_NULL_name_returns_NULL)
+        {
+            ///arrange
+            STRING_VIEW name = { NULL, 0 };
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            umock_c_reset_all_calls();
+
+            ///act
+            const char* res = HTTPHeaders_FindHeaderValueView(httpHandle, name);
+
+            ///assert
+            ASSERT_IS_NULL(res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_07_005: [ HTTPHeaders_FindHeaderValueView shall return the value stored for the name that has exactly the characters of name, or NULL if there is no such name.]*/
+        TEST_FUNCTION(HTTPHeaders_FindHeaderValueView_looks_up_the_name_in_the_map)
+        {
+            ///arrange
+            STRING_VIEW name;
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            name.data = HEADER1; /*the name is followed by ": value1", it is not '\0' terminated*/
+            name.length = strlen(NAME1);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_GetValueFromKeyView(IGNORED_PTR_ARG, name))
+                .IgnoreArgument(1)
+                .SetReturn(VALUE1);
+
+            ///act
+            const char* res = HTTPHeaders_FindHeaderValueView(httpHandle, name);
+
+            ///assert
+            ASSERT_ARE_EQUAL(char_ptr, VALUE1, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
         /*Tests_SRS_HTTP_HEADERS_99_018:[ Calling this API shall retrieve the value for a previously stored name.]*/
         /*Tests_SRS_HTTP_HEADERS_99_021:[ In this case the return value shall point to a string that shall strcmp equal to the original stored string.]*/
         TEST_FUNCTION(HTTPHeaders_FindHeaderValue_retrieves_previously_stored_value_succeeds)
@@ -1121,6 +1239,89 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             free(headerValue);
         }
 
+        /*Tests_SRS_HTTP_HEADERS_07_001: [If arena is NULL, HTTPHeaders_GetHeaderInArena shall return HTTP_HEADERS_INVALID_ARG.]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInArena_with_NULL_arena_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            char* headerValue;
+            umock_c_reset_all_calls();
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInArena(httpHandle, 0, NULL, &headerValue);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_INVALID_ARG, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_07_002: [Otherwise HTTPHeaders_GetHeaderInArena shall behave like HTTPHeaders_GetHeader, except that the name+": "+value string shall be allocated with ARENA_alloc from arena.]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInArena_succeeds)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            char* headerValue;
+            const char* keys[1] = { "a" };
+            const char** pKeys = &keys[0];
+            const char* values[1] = { "b" };
+            const char** pValues = &values[0];
+            const size_t one = 1;
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_GetInternals(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+                .IgnoreArgument(1)
+                .CopyOutArgumentBuffer(2, &pKeys, sizeof(pKeys))
+                .CopyOutArgumentBuffer(3, &pValues, sizeof(pValues))
+                .CopyOutArgumentBuffer(4, &one, sizeof(one));
+            STRICT_EXPECTED_CALL(ARENA_alloc((ARENA_HANDLE)0x4242, 5));
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInArena(httpHandle, 0, (ARENA_HANDLE)0x4242, &headerValue);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, "a: b", headerValue);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_99_034:[ The function shall return HTTP_HEADERS_ERROR when an internal error occurs]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInArena_fails_when_ARENA_alloc_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            char* headerValue;
+            const char* keys[1] = { "a" };
+            const char** pKeys = &keys[0];
+            const char* values[1] = { "b" };
+            const char** pValues = &values[0];
+            const size_t one = 1;
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_GetInternals(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+                .IgnoreArgument(1)
+                .CopyOutArgumentBuffer(2, &pKeys, sizeof(pKeys))
+                .CopyOutArgumentBuffer(3, &pValues, sizeof(pValues))
+                .CopyOutArgumentBuffer(4, &one, sizeof(one));
+            STRICT_EXPECTED_CALL(ARENA_alloc((ARENA_HANDLE)0x4242, 5))
+                .SetReturn(NULL);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInArena(httpHandle, 0, (ARENA_HANDLE)0x4242, &headerValue);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_ERROR, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
         /*Tests_SRS_HTTP_HEADERS_99_034:[ The function shall return HTTP_HEADERS_ERROR when an internal error occurs]*/
         TEST_FUNCTION(HTTPHeaders_GetHeader_fails_when_Map_GetInternals_fails)
         {
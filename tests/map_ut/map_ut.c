@@ -91,6 +91,23 @@ STRING_HANDLE my_STRING_new_JSON(const char* source)
 }
 
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/string_intern.h"
+
+static const char* my_string_intern_acquire(const char* source)
+{
+    size_t l = strlen(source);
+    char* result = (char*)malloc(l + 1);
+    if (result != NULL)
+    {
+        (void)memcpy(result, source, l + 1);
+    }
+    return result;
+}
+
+static void my_string_intern_release(const char* interned)
+{
+    free((void*)interned);
+}
 
 #undef ENABLE_MOCKS
 
@@ -153,6 +170,19 @@ static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
     ASSERT_FAIL(temp_str);
 }
 
+static void addNumberedPairs(MAP_HANDLE handle, size_t from, size_t to)
+{
+    size_t i;
+    for (i = from; i < to; i++)
+    {
+        char key[32];
+        char value[32];
+        (void)sprintf(key, "key%lu", (unsigned long)i);
+        (void)sprintf(value, "value%lu", (unsigned long)i);
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Add(handle, key, value));
+    }
+}
+
 BEGIN_TEST_SUITE(map_unittests)
 
     TEST_SUITE_INITIALIZE(TestClassInitialize)
@@ -177,6 +207,8 @@ BEGIN_TEST_SUITE(map_unittests)
         REGISTER_GLOBAL_MOCK_HOOK(STRING_construct, my_STRING_construct);
         REGISTER_GLOBAL_MOCK_HOOK(STRING_delete, my_STRING_delete);
         REGISTER_GLOBAL_MOCK_HOOK(STRING_new_JSON, my_STRING_new_JSON);
+        REGISTER_GLOBAL_MOCK_HOOK(string_intern_acquire, my_string_intern_acquire);
+        REGISTER_GLOBAL_MOCK_HOOK(string_intern_release, my_string_intern_release);
     }
 
     TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -1609,11 +1641,7 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*freeing yellow value*/
             .ValidateArgumentBuffer(1, TEST_YELLOWVALUE, strlen(TEST_YELLOWVALUE) + 1);
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1* sizeof(const char*))) /*ungrowing values*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*ungrowing keys*/
-            .IgnoreArgument(1);
+        /*the storage keeps room for 2 pairs, it is only given back when the map is down to a quarter*/
 
         ///act
         MAP_RESULT result1 = Map_Delete(handle, TEST_YELLOWKEY);
@@ -1650,11 +1678,7 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*freeing yellow value*/
             .ValidateArgumentBuffer(1, TEST_REDVALUE, strlen(TEST_REDVALUE) + 1);
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*ungrowing values*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*ungrowing keys*/
-            .IgnoreArgument(1);
+        /*the storage keeps room for 2 pairs, it is only given back when the map is down to a quarter*/
 
         ///act
         MAP_RESULT result1 = Map_Delete(handle, TEST_REDKEY);
@@ -1901,6 +1925,79 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(handle);
     }
 
+    /*Tests_SRS_MAP_07_010: [If parameter handle or the data of key is NULL then Map_GetValueFromKeyView returns NULL.]*/
+    TEST_FUNCTION(Map_GetValueFromKeyView_returns_NULL_for_invalid_handle)
+    {
+        ///arrange
+
+        ///act
+        const char* result = Map_GetValueFromKeyView(NULL, STRING_VIEW_from_chars(TEST_REDKEY));
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_MAP_07_010: [If parameter handle or the data of key is NULL then Map_GetValueFromKeyView returns NULL.]*/
+    TEST_FUNCTION(Map_GetValueFromKeyView_returns_NULL_for_NULL_key)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+
+        ///act
+        const char* result = Map_GetValueFromKeyView(handle, STRING_VIEW_from_chars(NULL));
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_011: [If no stored key has exactly the characters of key, then Map_GetValueFromKeyView returns NULL.]*/
+    TEST_FUNCTION(Map_GetValueFromKeyView_returns_NULL_for_prefix_of_a_key)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        const char* result = Map_GetValueFromKeyView(handle, STRING_VIEW_from_n(TEST_REDKEY, strlen(TEST_REDKEY) - 1));
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_012: [Otherwise, Map_GetValueFromKeyView returns the key's value.] */
+    TEST_FUNCTION(Map_GetValueFromKeyView_returns_value_for_key_that_is_not_zero_terminated)
+    {
+        ///arrange
+        char keyInBuffer[64];
+        MAP_HANDLE handle = Map_Create(NULL);
+        Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
+        (void)sprintf(keyInBuffer, "%s: something else", TEST_REDKEY);
+        umock_c_reset_all_calls();
+
+        ///act
+        const char* result = Map_GetValueFromKeyView(handle, STRING_VIEW_from_n(keyInBuffer, strlen(TEST_REDKEY)));
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
     /*Tests_SRS_MAP_02_046: [If parameter handle, keys, values or count is NULL then Map_GetInternals shall return MAP_INVALIDARG.] */
     TEST_FUNCTION(Map_GetInternals_fails_with_NULL_arg_1)
     {
@@ -2049,6 +2146,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_039: [Map_Clone shall make a copy of the map indicated by parameter handle and return a non-NULL handle to it.]*/
+    /*Tests_SRS_MAP_07_027: [Map_Clone shall not copy the keys and values, the clone shall share them with handle.]*/
     TEST_FUNCTION(Map_Clone_with_map_with_1_element_succeeds)
     {
         ///arrange
@@ -2062,13 +2160,8 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
             .IgnoreArgument(1);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*this is creating a clone of RED value*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the shared storage*/
+            .IgnoreArgument(1);
 
         ///act
         MAP_HANDLE result = Map_Clone(handle);
@@ -2092,6 +2185,9 @@ BEGIN_TEST_SUITE(map_unittests)
     TEST_FUNCTION(Map_Clone_with_map_with_1_element_fails_when_gbaloc_fails_1)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
         umock_c_reset_all_calls();
@@ -2099,21 +2195,10 @@ BEGIN_TEST_SUITE(map_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
             .IgnoreArgument(1);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        whenShallmalloc_fail = currentmalloc_call + 5;
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*this is creating a clone of RED value*/
-
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        whenShallmalloc_fail = currentmalloc_call + 2;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the shared storage*/
             .IgnoreArgument(1);
+
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
             .IgnoreArgument(1);
 
@@ -2123,10 +2208,13 @@ BEGIN_TEST_SUITE(map_unittests)
         ///assert
         ASSERT_IS_NULL(result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(handle, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
     }
 
     /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
@@ -2137,23 +2225,10 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
         umock_c_reset_all_calls();
 
+        whenShallmalloc_fail = currentmalloc_call + 1;
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
             .IgnoreArgument(1);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        whenShallmalloc_fail = currentmalloc_call + 4;
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-
         ///act
         MAP_HANDLE result = Map_Clone(handle);
 
@@ -2163,35 +2238,40 @@ BEGIN_TEST_SUITE(map_unittests)
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_1_element_fails_when_gbaloc_fails_3)
+    /*Tests_SRS_MAP_02_039: [Map_Clone shall make a copy of the map indicated by parameter handle and return a non-NULL handle to it.]*/
+    /*Tests_SRS_MAP_07_027: [Map_Clone shall not copy the keys and values, the clone shall share them with handle.]*/
+    TEST_FUNCTION(Map_Clone_with_map_with_2_element_succeeds)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
+        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
         umock_c_reset_all_calls();
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
             .IgnoreArgument(1);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        whenShallmalloc_fail = currentmalloc_call + 3;
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the shared storage*/
             .IgnoreArgument(1);
 
         ///act
         MAP_HANDLE result = Map_Clone(handle);
 
         ///assert
-        ASSERT_IS_NULL(result);
+        ASSERT_IS_NOT_NULL(result);
+        (void)Map_GetInternals(result, &keys, &values, &count);
+        ASSERT_IS_NOT_NULL(keys);
+        ASSERT_IS_NOT_NULL(values);
+        ASSERT_ARE_EQUAL(size_t, 2, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEKEY, keys[1]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, values[1]);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
@@ -2199,59 +2279,68 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(result);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_1_element_fails_when_gbaloc_fails_4)
+    /*Tests_SRS_MAP_07_027: [Map_Clone shall not copy the keys and values, the clone shall share them with handle.]*/
+    TEST_FUNCTION(Map_Clone_shares_the_keys_and_values_of_handle)
     {
         ///arrange
+        const char*const* sourceKeys;
+        const char*const* sourceValues;
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        umock_c_reset_all_calls();
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
-            .IgnoreArgument(1);
-        whenShallmalloc_fail = currentmalloc_call + 2;
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*this is creating a clone of the storage for keys*/
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        (void)Map_GetInternals(handle, &sourceKeys, &sourceValues, &count);
 
         ///act
         MAP_HANDLE result = Map_Clone(handle);
 
         ///assert
-        ASSERT_IS_NULL(result);
-        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_IS_NOT_NULL(result);
+        (void)Map_GetInternals(result, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)sourceKeys, (void*)keys);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)sourceValues, (void*)values);
 
         ///cleanup
         Map_Destroy(handle);
         Map_Destroy(result);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_1_element_fails_when_gbaloc_fails_5)
+    /*Tests_SRS_MAP_07_027: [Map_Clone shall not copy the keys and values, the clone shall share them with handle.]*/
+    TEST_FUNCTION(Map_Clone_of_a_clone_only_allocates_the_handle)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
         umock_c_reset_all_calls();
 
-        whenShallmalloc_fail = currentmalloc_call + 1;
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
             .IgnoreArgument(1);
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        MAP_HANDLE result = Map_Clone(clone);
 
         ///assert
-        ASSERT_IS_NULL(result);
+        ASSERT_IS_NOT_NULL(result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(result, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
 
         ///cleanup
         Map_Destroy(handle);
+        Map_Destroy(clone);
         Map_Destroy(result);
     }
 
-    /*Tests_SRS_MAP_02_039: [Map_Clone shall make a copy of the map indicated by parameter handle and return a non-NULL handle to it.]*/
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_succeeds)
+    /*Tests_SRS_MAP_07_035: [Map_Clone shall only read handle, clones of the same map can be made from several threads at the same time.]*/
+    TEST_FUNCTION(Map_Clone_of_a_map_that_was_already_cloned_only_allocates_the_handle)
     {
         ///arrange
         const char*const* keys;
@@ -2259,304 +2348,337 @@ BEGIN_TEST_SUITE(map_unittests)
         size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
         umock_c_reset_all_calls();
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
             .IgnoreArgument(1);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(2*sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*this is creating a clone of BLUE key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(2*sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*this is creating a clone of RED value*/
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEVALUE) + 1)); /*this is creating a clone of RED value*/
-
         ///act
         MAP_HANDLE result = Map_Clone(handle);
 
         ///assert
         ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
         (void)Map_GetInternals(result, &keys, &values, &count);
-        ASSERT_IS_NOT_NULL(keys);
-        ASSERT_IS_NOT_NULL(values);
-        ASSERT_ARE_EQUAL(size_t, 2, count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
         ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
         ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
-        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEKEY, keys[1]);
-        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, values[1]);
-        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
-        Map_Destroy(handle);
         Map_Destroy(result);
+        Map_Destroy(clone);
+        Map_Destroy(handle);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_1)
+    /*Tests_SRS_MAP_07_028: [When the last map that shares the storage is destroyed, the storage shall be released.]*/
+    TEST_FUNCTION(Map_Destroy_of_the_source_keeps_the_clone_valid)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*this is creating a clone of BLUE key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*this is creating a clone of RED value*/
-
-        whenShallmalloc_fail = currentmalloc_call + 7;
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEVALUE) + 1)); /*this is creating a clone of BLUE value*/
-
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        Map_Destroy(handle);
 
         ///assert
-        ASSERT_IS_NULL(result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, Map_GetValueFromKey(clone, TEST_REDKEY));
 
         ///cleanup
-        Map_Destroy(handle);
-        Map_Destroy(result);
+        Map_Destroy(clone);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_2)
+    /*Tests_SRS_MAP_07_028: [When the last map that shares the storage is destroyed, the storage shall be released.]*/
+    TEST_FUNCTION(Map_Destroy_of_the_last_sharing_map_releases_the_storage)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
+        Map_Destroy(clone);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*this is creating a clone of BLUE key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        whenShallmalloc_fail = currentmalloc_call + 6;
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*this is creating a clone of RED value*/
-
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*red key*/
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*red value*/
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*keys*/
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*values*/
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*shared storage*/
             .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        Map_Destroy(handle);
 
         ///assert
-        ASSERT_IS_NULL(result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-
-        ///cleanup
-        Map_Destroy(handle);
-        Map_Destroy(result);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_3)
+    /*Tests_SRS_MAP_07_029: [The first change made to a map that shares its storage shall copy the keys and values first, the other maps shall not see the change.]*/
+    TEST_FUNCTION(Map_Add_to_a_clone_copies_the_storage_first)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the keys*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*copy of red key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the values*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*copy of red value*/
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing keys*/
             .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*copy of blue key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEVALUE) + 1)); /*copy of blue value*/
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for keys*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
-
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*this is creating a clone of BLUE key*/
-
-        whenShallmalloc_fail = currentmalloc_call + 5;
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for values*/
-
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-
-        ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        ///act
+        MAP_RESULT result = Map_Add(clone, TEST_BLUEKEY, TEST_BLUEVALUE);
 
         ///assert
-        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 2, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEKEY, keys[1]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, values[1]);
+        (void)Map_GetInternals(handle, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
+        Map_Destroy(clone);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_4)
+    /*Tests_SRS_MAP_07_034: [If the other maps that shared the storage are gone, the first change shall take the keys, values and index back without copying them.]*/
+    TEST_FUNCTION(Map_Add_to_a_clone_whose_source_is_destroyed_does_not_copy_the_storage)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
+        Map_Destroy(handle);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*the shared storage*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing values*/
             .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*copy of blue key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEVALUE) + 1)); /*copy of blue value*/
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for keys*/
+        ///act
+        MAP_RESULT result = Map_Add(clone, TEST_BLUEKEY, TEST_BLUEVALUE);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*this is creating a clone of RED key*/
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 2, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEKEY, keys[1]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, values[1]);
 
-        whenShallmalloc_fail = currentmalloc_call + 4;
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1)); /*this is creating a clone of BLUE key*/
+        ///cleanup
+        Map_Destroy(clone);
+    }
 
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+    /*Tests_SRS_MAP_07_034: [If the other maps that shared the storage are gone, the first change shall take the keys, values and index back without copying them.]*/
+    TEST_FUNCTION(Map_Delete_from_a_source_whose_clone_is_destroyed_keeps_the_index)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_HANDLE clone;
+        size_t i;
+        addNumberedPairs(handle, 0, 30);
+        clone = Map_Clone(handle);
+        Map_Destroy(clone);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*the shared storage*/
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*key7*/
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*value7*/
             .IgnoreArgument(1);
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        MAP_RESULT result = Map_Delete(handle, "key7");
 
         ///assert
-        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, "key7"));
+        for (i = 0; i < 30; i++)
+        {
+            if (i != 7)
+            {
+                char key[32];
+                char value[32];
+                (void)sprintf(key, "key%lu", (unsigned long)i);
+                (void)sprintf(value, "value%lu", (unsigned long)i);
+                ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(handle, key));
+            }
+        }
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_5)
+    /*Tests_SRS_MAP_07_029: [The first change made to a map that shares its storage shall copy the keys and values first, the other maps shall not see the change.]*/
+    TEST_FUNCTION(Map_AddOrUpdate_of_the_source_does_not_change_the_clone)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
-        umock_c_reset_all_calls();
+        MAP_HANDLE clone = Map_Clone(handle);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
-            .IgnoreArgument(1);
+        ///act
+        MAP_RESULT result = Map_AddOrUpdate(handle, TEST_REDKEY, TEST_BLUEVALUE);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for keys*/
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, Map_GetValueFromKey(handle, TEST_REDKEY));
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1))
-            .SetReturn(NULL); /*this is creating a clone of RED key*/
+        ///cleanup
+        Map_Destroy(clone);
+        Map_Destroy(handle);
+    }
 
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+    /*Tests_SRS_MAP_07_029: [The first change made to a map that shares its storage shall copy the keys and values first, the other maps shall not see the change.]*/
+    TEST_FUNCTION(Map_Delete_from_a_clone_does_not_change_the_source)
+    {
+        ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
+        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        MAP_RESULT result = Map_Delete(clone, TEST_REDKEY);
 
         ///assert
-        ASSERT_IS_NULL(result);
-        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, values[0]);
+        (void)Map_GetInternals(handle, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 2, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEKEY, keys[1]);
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
+        Map_Destroy(clone);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_6)
+    /*Tests_SRS_MAP_07_030: [If that copy fails, the change shall fail with MAP_ERROR and leave the map unchanged.]*/
+    TEST_FUNCTION(Map_Add_to_a_clone_fails_when_copying_the_keys_fails)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
-            .IgnoreArgument(1);
-
-        whenShallmalloc_fail = currentmalloc_call + 2;
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 * sizeof(char*))); /*this is creating a clone of the storage for keys*/
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        whenShallmalloc_fail = currentmalloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the keys*/
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        MAP_RESULT result = Map_Add(clone, TEST_BLUEKEY, TEST_BLUEVALUE);
 
         ///assert
-        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
+        Map_Destroy(clone);
     }
 
-    /*Tests_SRS_MAP_02_047: [If during cloning, any operation fails, then Map_Clone shall return NULL.] */
-    TEST_FUNCTION(Map_Clone_with_map_with_2_element_fails_when_gballoc_fails_7)
+    /*Tests_SRS_MAP_07_030: [If that copy fails, the change shall fail with MAP_ERROR and leave the map unchanged.]*/
+    TEST_FUNCTION(Map_Delete_from_a_clone_fails_when_copying_the_values_fails)
     {
         ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, TEST_REDKEY, TEST_REDVALUE);
-        (void)Map_AddOrUpdate(handle, TEST_BLUEKEY, TEST_BLUEVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
         umock_c_reset_all_calls();
 
-        whenShallmalloc_fail = currentmalloc_call + 1;
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)) /*this is creating the HANDLE structure*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the keys*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*copy of red key*/
+        whenShallmalloc_fail = currentmalloc_call + 3;
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the values*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*copy of red key*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)) /*copy of the keys*/
             .IgnoreArgument(1);
 
         ///act
-        MAP_HANDLE result = Map_Clone(handle);
+        MAP_RESULT result = Map_Delete(clone, TEST_REDKEY);
 
         ///assert
-        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(clone, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
 
         ///cleanup
         Map_Destroy(handle);
-        Map_Destroy(result);
+        Map_Destroy(clone);
     }
 
     /* Tests_SRS_MAP_07_009: [If the mapFilterCallback function is not NULL, then the return value will be check and if it is not zero then Map_Add shall return MAP_FILTER_REJECT.] */
@@ -3706,4 +3828,818 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     
+    /*Tests_SRS_MAP_07_013: [Once the map holds more than 8 pairs, Map_Add, Map_AddOrUpdate, Map_Delete, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall find keys through a hash index instead of comparing all the keys.]*/
+    TEST_FUNCTION(Map_GetValueFromKey_with_8_pairs_does_not_allocate_an_index)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        addNumberedPairs(handle, 0, 8);
+        umock_c_reset_all_calls();
+
+        ///act
+        const char* result = Map_GetValueFromKey(handle, "key7");
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, "value7", result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_013: [Once the map holds more than 8 pairs, Map_Add, Map_AddOrUpdate, Map_Delete, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall find keys through a hash index instead of comparing all the keys.]*/
+    /*Tests_SRS_MAP_07_033: [The index shall be built and kept up to date by the calls that change the map, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall not change the map.]*/
+    TEST_FUNCTION(Map_Add_of_the_9th_pair_allocates_the_index)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        addNumberedPairs(handle, 0, 8);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 16 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 16 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("key8") + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("value8") + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)); /*the index*/
+
+        ///act
+        MAP_RESULT result = Map_Add(handle, "key8", "value8");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_033: [The index shall be built and kept up to date by the calls that change the map, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall not change the map.]*/
+    TEST_FUNCTION(Map_GetValueFromKey_with_9_pairs_does_not_allocate)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        const char* result1;
+        const char* result2;
+        const char* result3;
+        bool keyExists;
+        addNumberedPairs(handle, 0, 9);
+        umock_c_reset_all_calls();
+
+        ///act
+        result1 = Map_GetValueFromKey(handle, "key8");
+        result2 = Map_GetValueFromKey(handle, "key0");
+        result3 = Map_GetValueFromKeyView(handle, STRING_VIEW_from_n("key4", 4));
+        (void)Map_ContainsKey(handle, "key9", &keyExists);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, "value8", result1);
+        ASSERT_ARE_EQUAL(char_ptr, "value0", result2);
+        ASSERT_ARE_EQUAL(char_ptr, "value4", result3);
+        ASSERT_IS_FALSE(keyExists);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_013: [Once the map holds more than 8 pairs, Map_Add, Map_AddOrUpdate, Map_Delete, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall find keys through a hash index instead of comparing all the keys.]*/
+    TEST_FUNCTION(Map_with_many_pairs_finds_all_the_keys)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        size_t i;
+        bool keyExists;
+        addNumberedPairs(handle, 0, 100);
+
+        ///act
+        for (i = 0; i < 100; i++)
+        {
+            char key[32];
+            char keyInBuffer[64];
+            char value[32];
+            (void)sprintf(key, "key%lu", (unsigned long)i);
+            (void)sprintf(keyInBuffer, "%s: something else", key);
+            (void)sprintf(value, "value%lu", (unsigned long)i);
+
+            ///assert
+            ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(handle, key));
+            ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKeyView(handle, STRING_VIEW_from_n(keyInBuffer, strlen(key))));
+            ASSERT_ARE_EQUAL(MAP_RESULT, MAP_KEYEXISTS, Map_Add(handle, key, "other"));
+        }
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, "key100"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_ContainsKey(handle, "key100", &keyExists));
+        ASSERT_IS_FALSE(keyExists);
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_AddOrUpdate(handle, "key42", "updated"));
+        ASSERT_ARE_EQUAL(char_ptr, "updated", Map_GetValueFromKey(handle, "key42"));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_015: [Map_GetInternals and Map_ToJSON shall produce the pairs in the order they were added, also after pairs were deleted.]*/
+    TEST_FUNCTION(Map_with_many_pairs_keeps_the_insertion_order_after_Map_Delete)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        size_t i;
+        size_t expected;
+        addNumberedPairs(handle, 0, 20);
+
+        ///act
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key0"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key5"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_Delete(handle, "key19"));
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_KEYNOTFOUND, Map_Delete(handle, "key5"));
+        addNumberedPairs(handle, 20, 21);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_GetInternals(handle, &keys, &values, &count));
+        ASSERT_ARE_EQUAL(size_t, 18, count);
+        expected = 1;
+        for (i = 0; i < count; i++)
+        {
+            char key[32];
+            if (expected == 5)
+            {
+                expected++;
+            }
+            else if (expected == 19)
+            {
+                expected++;
+            }
+            (void)sprintf(key, "key%lu", (unsigned long)expected);
+            ASSERT_ARE_EQUAL(char_ptr, key, keys[i]);
+            ASSERT_ARE_EQUAL(char_ptr, values[i], Map_GetValueFromKey(handle, key));
+            expected++;
+        }
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, "key0"));
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, "key5"));
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, "key19"));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_014: [If the index cannot be allocated, the map shall keep working by comparing all the keys.]*/
+    TEST_FUNCTION(Map_Add_succeeds_when_the_index_cannot_be_allocated)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_RESULT result;
+        size_t i;
+        addNumberedPairs(handle, 0, 8);
+        whenShallmalloc_fail = currentmalloc_call + 3; /*after the key and the value comes the index*/
+
+        ///act
+        result = Map_Add(handle, "key8", "value8");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        addNumberedPairs(handle, 9, 10); /*this one builds the index*/
+        for (i = 0; i < 10; i++)
+        {
+            char key[32];
+            char value[32];
+            (void)sprintf(key, "key%lu", (unsigned long)i);
+            (void)sprintf(value, "value%lu", (unsigned long)i);
+            ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(handle, key));
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_013: [Once the map holds more than 8 pairs, Map_Add, Map_AddOrUpdate, Map_Delete, Map_ContainsKey, Map_GetValueFromKey and Map_GetValueFromKeyView shall find keys through a hash index instead of comparing all the keys.]*/
+    TEST_FUNCTION(Map_Clone_of_a_map_with_many_pairs_finds_all_the_keys)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_HANDLE clone;
+        size_t i;
+        addNumberedPairs(handle, 0, 30);
+
+        ///act
+        clone = Map_Clone(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(clone);
+        for (i = 0; i < 30; i++)
+        {
+            char key[32];
+            char value[32];
+            (void)sprintf(key, "key%lu", (unsigned long)i);
+            (void)sprintf(value, "value%lu", (unsigned long)i);
+            ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(clone, key));
+        }
+
+        ///cleanup
+        Map_Destroy(clone);
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_029: [The first change made to a map that shares its storage shall copy the keys and values first, the other maps shall not see the change.]*/
+    TEST_FUNCTION(Map_Delete_from_a_clone_of_a_map_with_many_pairs_keeps_both_maps_consistent)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        MAP_HANDLE clone;
+        size_t i;
+        addNumberedPairs(handle, 0, 30);
+        clone = Map_Clone(handle);
+
+        ///act
+        MAP_RESULT result = Map_Delete(clone, "key7");
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_IS_NULL(Map_GetValueFromKey(clone, "key7"));
+        ASSERT_ARE_EQUAL(char_ptr, "value7", Map_GetValueFromKey(handle, "key7"));
+        for (i = 0; i < 30; i++)
+        {
+            char key[32];
+            char value[32];
+            (void)sprintf(key, "key%lu", (unsigned long)i);
+            (void)sprintf(value, "value%lu", (unsigned long)i);
+            ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(handle, key));
+            if (i != 7)
+            {
+                ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(clone, key));
+            }
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+        Map_Destroy(clone);
+    }
+
+    /*Tests_SRS_MAP_07_016: [If parameter handle is NULL then Map_Reserve shall return MAP_INVALIDARG.]*/
+    TEST_FUNCTION(Map_Reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        MAP_RESULT result = Map_Reserve(NULL, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_INVALIDARG, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_MAP_07_017: [Map_Reserve shall grow the storage of the map so that it can hold at least capacity pairs and return MAP_OK.]*/
+    TEST_FUNCTION(Map_Reserve_grows_the_storage)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 10 * sizeof(const char*))); /*growing keys*/
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 10 * sizeof(const char*))); /*growing values*/
+
+        ///act
+        MAP_RESULT result = Map_Reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_017: [Map_Reserve shall grow the storage of the map so that it can hold at least capacity pairs and return MAP_OK.]*/
+    TEST_FUNCTION(Map_Add_after_Map_Reserve_does_not_grow_the_storage)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Reserve(handle, 10);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDKEY) + 1)); /*copy of red key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*copy of red value*/
+
+        ///act
+        MAP_RESULT result = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, Map_GetValueFromKey(handle, TEST_REDKEY));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_018: [If capacity is not bigger than the storage the map already has, Map_Reserve shall return MAP_OK without changing anything.]*/
+    TEST_FUNCTION(Map_Reserve_with_smaller_capacity_does_nothing)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        (void)Map_Add(handle, TEST_YELLOWKEY, TEST_YELLOWVALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_Reserve(handle, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_019: [If growing the storage fails, Map_Reserve shall return MAP_ERROR and leave the map unchanged.]*/
+    TEST_FUNCTION(Map_Reserve_fails_when_growing_values_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+        whenShallrealloc_fail = currentrealloc_call + 2;
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1 * sizeof(const char*))) /*undo growing keys*/
+            .IgnoreArgument(1);
+
+        ///act
+        MAP_RESULT result = Map_Reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, Map_GetValueFromKey(handle, TEST_REDKEY));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_020: [If parameter handle, keys or values is NULL then Map_AddMany shall return MAP_INVALIDARG.]*/
+    TEST_FUNCTION(Map_AddMany_with_NULL_handle_fails)
+    {
+        ///arrange
+        const char* keys[] = { TEST_REDKEY };
+        const char* values[] = { TEST_REDVALUE };
+
+        ///act
+        MAP_RESULT result = Map_AddMany(NULL, keys, values, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_INVALIDARG, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_MAP_07_020: [If parameter handle, keys or values is NULL then Map_AddMany shall return MAP_INVALIDARG.]*/
+    TEST_FUNCTION(Map_AddMany_with_NULL_keys_fails)
+    {
+        ///arrange
+        const char* values[] = { TEST_REDVALUE };
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, NULL, values, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_INVALIDARG, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_020: [If parameter handle, keys or values is NULL then Map_AddMany shall return MAP_INVALIDARG.]*/
+    TEST_FUNCTION(Map_AddMany_with_NULL_values_fails)
+    {
+        ///arrange
+        const char* keys[] = { TEST_REDKEY };
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, NULL, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_INVALIDARG, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_021: [If any of the keys or values is NULL then Map_AddMany shall return MAP_INVALIDARG.]*/
+    TEST_FUNCTION(Map_AddMany_with_a_NULL_value_fails_and_adds_nothing)
+    {
+        ///arrange
+        const char* keys[] = { TEST_REDKEY, TEST_YELLOWKEY };
+        const char* values[] = { TEST_REDVALUE, NULL };
+        bool keyExists;
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_INVALIDARG, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_ContainsKey(handle, TEST_REDKEY, &keyExists);
+        ASSERT_IS_FALSE(keyExists);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_024: [Otherwise, Map_AddMany shall grow the storage of the map once for all the pairs, add them in the order they are given and return MAP_OK.]*/
+    TEST_FUNCTION(Map_AddMany_succeeds)
+    {
+        ///arrange
+        const char* keys[] = { TEST_YELLOWKEY, TEST_BLUEKEY, TEST_GREENKEY };
+        const char* values[] = { TEST_YELLOWVALUE, TEST_BLUEVALUE, TEST_GREENVALUE };
+        const char*const* storedKeys;
+        const char*const* storedValues;
+        size_t count;
+        size_t i;
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_YELLOWKEY) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_YELLOWVALUE) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEKEY) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEVALUE) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_GREENKEY) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_GREENVALUE) + 1));
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 3);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(handle, &storedKeys, &storedValues, &count);
+        ASSERT_ARE_EQUAL(size_t, 4, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, storedKeys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, storedValues[0]);
+        for (i = 0; i < 3; i++)
+        {
+            ASSERT_ARE_EQUAL(char_ptr, keys[i], storedKeys[i + 1]);
+            ASSERT_ARE_EQUAL(char_ptr, values[i], storedValues[i + 1]);
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_024: [Otherwise, Map_AddMany shall grow the storage of the map once for all the pairs, add them in the order they are given and return MAP_OK.]*/
+    TEST_FUNCTION(Map_AddMany_with_0_pairs_succeeds)
+    {
+        ///arrange
+        const char* keys[] = { TEST_REDKEY };
+        const char* values[] = { TEST_REDVALUE };
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 0);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_022: [If any of the keys already exists in the map, or appears more than once in keys, then Map_AddMany shall return MAP_KEYEXISTS.]*/
+    TEST_FUNCTION(Map_AddMany_with_existing_key_fails_and_adds_nothing)
+    {
+        ///arrange
+        const char* keys[] = { TEST_YELLOWKEY, TEST_REDKEY };
+        const char* values[] = { TEST_YELLOWVALUE, TEST_REDVALUE };
+        bool keyExists;
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_KEYEXISTS, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_ContainsKey(handle, TEST_YELLOWKEY, &keyExists);
+        ASSERT_IS_FALSE(keyExists);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_022: [If any of the keys already exists in the map, or appears more than once in keys, then Map_AddMany shall return MAP_KEYEXISTS.]*/
+    /*Tests_SRS_MAP_07_025: [If Map_AddMany does not return MAP_OK, none of the pairs shall be added to the map.]*/
+    TEST_FUNCTION(Map_AddMany_with_repeated_key_fails_and_adds_nothing)
+    {
+        ///arrange
+        const char* keys[] = { TEST_YELLOWKEY, TEST_BLUEKEY, TEST_YELLOWKEY };
+        const char* values[] = { TEST_YELLOWVALUE, TEST_BLUEVALUE, TEST_REDVALUE };
+        const char*const* storedKeys;
+        const char*const* storedValues;
+        size_t count;
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 3);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_KEYEXISTS, result);
+        (void)Map_GetInternals(handle, &storedKeys, &storedValues, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, storedKeys[0]);
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, TEST_YELLOWKEY));
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, TEST_BLUEKEY));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_023: [If the mapFilterCallback function is not NULL and it rejects any of the pairs, then Map_AddMany shall return MAP_FILTER_REJECT.]*/
+    TEST_FUNCTION(Map_AddMany_with_filter_rejecting_a_pair_fails_and_adds_nothing)
+    {
+        ///arrange
+        const char* keys[] = { "redkey", "YELLOWKEY" };
+        const char* values[] = { "reddoor", "YELLOWDOOR" };
+        bool keyExists;
+        MAP_HANDLE handle = Map_Create(DontAllowCapitalsFilters);
+        umock_c_reset_all_calls();
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_FILTER_REJECT, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_ContainsKey(handle, "redkey", &keyExists);
+        ASSERT_IS_FALSE(keyExists);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_026: [If any allocation fails, Map_AddMany shall return MAP_ERROR.]*/
+    /*Tests_SRS_MAP_07_025: [If Map_AddMany does not return MAP_OK, none of the pairs shall be added to the map.]*/
+    TEST_FUNCTION(Map_AddMany_fails_when_copying_a_value_fails_and_adds_nothing)
+    {
+        ///arrange
+        const char* keys[] = { TEST_YELLOWKEY, TEST_BLUEKEY };
+        const char* values[] = { TEST_YELLOWVALUE, TEST_BLUEVALUE };
+        const char*const* storedKeys;
+        const char*const* storedValues;
+        size_t count;
+        MAP_HANDLE handle = Map_Create(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        whenShallmalloc_fail = currentmalloc_call + 4; /*the copy of the blue value*/
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
+        (void)Map_GetInternals(handle, &storedKeys, &storedValues, &count);
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, storedKeys[0]);
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, TEST_YELLOWKEY));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_026: [If any allocation fails, Map_AddMany shall return MAP_ERROR.]*/
+    TEST_FUNCTION(Map_AddMany_fails_when_growing_the_storage_fails)
+    {
+        ///arrange
+        const char* keys[] = { TEST_YELLOWKEY, TEST_BLUEKEY };
+        const char* values[] = { TEST_YELLOWVALUE, TEST_BLUEVALUE };
+        MAP_HANDLE handle = Map_Create(NULL);
+        umock_c_reset_all_calls();
+        whenShallrealloc_fail = currentrealloc_call + 1;
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 2 * sizeof(const char*))); /*growing keys*/
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_024: [Otherwise, Map_AddMany shall grow the storage of the map once for all the pairs, add them in the order they are given and return MAP_OK.]*/
+    TEST_FUNCTION(Map_AddMany_with_many_pairs_finds_all_the_keys)
+    {
+        ///arrange
+        char keyStorage[50][32];
+        char valueStorage[50][32];
+        const char* keys[50];
+        const char* values[50];
+        size_t i;
+        MAP_HANDLE handle = Map_Create(NULL);
+        addNumberedPairs(handle, 0, 10);
+        for (i = 0; i < 50; i++)
+        {
+            (void)sprintf(keyStorage[i], "key%lu", (unsigned long)(i + 10));
+            (void)sprintf(valueStorage[i], "value%lu", (unsigned long)(i + 10));
+            keys[i] = keyStorage[i];
+            values[i] = valueStorage[i];
+        }
+
+        ///act
+        MAP_RESULT result = Map_AddMany(handle, keys, values, 50);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        for (i = 0; i < 60; i++)
+        {
+            char key[32];
+            char value[32];
+            (void)sprintf(key, "key%lu", (unsigned long)i);
+            (void)sprintf(value, "value%lu", (unsigned long)i);
+            ASSERT_ARE_EQUAL(char_ptr, value, Map_GetValueFromKey(handle, key));
+        }
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_031: [Map_CreateWithInternedKeys shall create a new, empty map the same way Map_Create does.]*/
+    TEST_FUNCTION(Map_CreateWithInternedKeys_succeeds)
+    {
+        ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        MAP_HANDLE handle = Map_CreateWithInternedKeys(NULL);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)Map_GetInternals(handle, &keys, &values, &count);
+        ASSERT_ARE_EQUAL(size_t, 0, count);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_032: [The keys of that map shall be obtained from string_intern_acquire instead of being copied, and given back with string_intern_release.]*/
+    TEST_FUNCTION(Map_Add_to_a_map_with_interned_keys_interns_the_key)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithInternedKeys(NULL);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(const char*))); /*growing keys*/
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(const char*))); /*growing values*/
+        STRICT_EXPECTED_CALL(string_intern_acquire(TEST_REDKEY));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*copy of red value*/
+
+        ///act
+        MAP_RESULT result = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, Map_GetValueFromKey(handle, TEST_REDKEY));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_032: [The keys of that map shall be obtained from string_intern_acquire instead of being copied, and given back with string_intern_release.]*/
+    TEST_FUNCTION(Map_Add_to_a_map_with_interned_keys_fails_when_string_intern_acquire_fails)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithInternedKeys(NULL);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(const char*))); /*growing keys*/
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(const char*))); /*growing values*/
+        STRICT_EXPECTED_CALL(string_intern_acquire(TEST_REDKEY))
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*values*/
+
+        ///act
+        MAP_RESULT result = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, TEST_REDKEY));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_032: [The keys of that map shall be obtained from string_intern_acquire instead of being copied, and given back with string_intern_release.]*/
+    TEST_FUNCTION(Map_Destroy_of_a_map_with_interned_keys_releases_the_keys)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithInternedKeys(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(string_intern_release(IGNORED_PTR_ARG)); /*red key*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*red value*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*values*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*handle*/
+
+        ///act
+        Map_Destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_MAP_07_032: [The keys of that map shall be obtained from string_intern_acquire instead of being copied, and given back with string_intern_release.]*/
+    TEST_FUNCTION(Map_Delete_from_a_map_with_interned_keys_releases_the_key)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithInternedKeys(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(string_intern_release(IGNORED_PTR_ARG)); /*red key*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*red value*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)); /*values*/
+
+        ///act
+        MAP_RESULT result = Map_Delete(handle, TEST_REDKEY);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_07_029: [The first change made to a map that shares its storage shall copy the keys and values first, the other maps shall not see the change.]*/
+    /*Tests_SRS_MAP_07_032: [The keys of that map shall be obtained from string_intern_acquire instead of being copied, and given back with string_intern_release.]*/
+    TEST_FUNCTION(Map_Add_to_a_clone_of_a_map_with_interned_keys_interns_the_copied_keys)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateWithInternedKeys(NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        MAP_HANDLE clone = Map_Clone(handle);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the keys*/
+        STRICT_EXPECTED_CALL(string_intern_acquire(TEST_REDKEY)); /*copy of red key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(char*))); /*copy of the values*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_REDVALUE) + 1)); /*copy of red value*/
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing keys*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(const char*))) /*growing values*/
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(string_intern_acquire(TEST_BLUEKEY));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_BLUEVALUE) + 1)); /*copy of blue value*/
+
+        ///act
+        MAP_RESULT result = Map_Add(clone, TEST_BLUEKEY, TEST_BLUEVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(char_ptr, TEST_BLUEVALUE, Map_GetValueFromKey(clone, TEST_BLUEKEY));
+        ASSERT_IS_NULL(Map_GetValueFromKey(handle, TEST_BLUEKEY));
+
+        ///cleanup
+        Map_Destroy(handle);
+        Map_Destroy(clone);
+    }
+
 END_TEST_SUITE(map_unittests)
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include "azure_c_shared_utility/mpsc_queue.h"
+#include "azure_c_shared_utility/doublylinkedlist.h"
+#include "testrunnerswitcher.h"
+
+typedef struct simpleItem_tag
+{
+    unsigned char index;
+    MPSC_QUEUE_ENTRY link;
+} simpleItem;
+
+static simpleItem simp1 = { 1 };
+static simpleItem simp2 = { 2 };
+static simpleItem simp3 = { 3 };
+
+static TEST_MUTEX_HANDLE g_dllByDll;
+static TEST_MUTEX_HANDLE g_testByTest;
+
+BEGIN_TEST_SUITE(mpsc_queue_unittests)
+
+TEST_SUITE_INITIALIZE(TestClassInitialize)
+{
+    TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+}
+
+TEST_SUITE_CLEANUP(TestClassCleanup)
+{
+    TEST_MUTEX_DESTROY(g_testByTest);
+    TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+}
+
+TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+}
+
+TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+{
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+    /* Tests_SRS_MPSC_QUEUE_07_001: [mpsc_queue_init shall initialize queue as an empty queue.] */
+    /* Tests_SRS_MPSC_QUEUE_07_007: [mpsc_queue_is_empty shall return a non-zero value if nothing was pushed that was not popped yet, and 0 otherwise.] */
+    TEST_FUNCTION(mpsc_queue_init_makes_an_empty_queue)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        int result;
+
+        // act
+        mpsc_queue_init(&queue);
+        result = mpsc_queue_is_empty(&queue);
+
+        // assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_005: [If the queue is empty, mpsc_queue_pop shall return NULL.] */
+    TEST_FUNCTION(mpsc_queue_pop_on_an_empty_queue_returns_NULL)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result;
+        mpsc_queue_init(&queue);
+
+        // act
+        result = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_NOT_EQUAL(int, 0, mpsc_queue_is_empty(&queue));
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_002: [mpsc_queue_push shall add entry at the end of the queue.] */
+    /* Tests_SRS_MPSC_QUEUE_07_007: [mpsc_queue_is_empty shall return a non-zero value if nothing was pushed that was not popped yet, and 0 otherwise.] */
+    TEST_FUNCTION(mpsc_queue_push_makes_the_queue_not_empty)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        int result;
+        mpsc_queue_init(&queue);
+
+        // act
+        mpsc_queue_push(&queue, &simp1.link);
+        result = mpsc_queue_is_empty(&queue);
+
+        // assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_004: [mpsc_queue_pop shall remove the oldest entry from the queue and return it.] */
+    TEST_FUNCTION(mpsc_queue_pop_returns_the_only_entry)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result;
+        mpsc_queue_init(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+
+        // act
+        result = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_ARE_EQUAL(void_ptr, &simp1.link, result);
+        ASSERT_ARE_EQUAL(int, 1, (int)containingRecord(result, simpleItem, link)->index);
+        ASSERT_IS_NULL(mpsc_queue_pop(&queue));
+        ASSERT_ARE_NOT_EQUAL(int, 0, mpsc_queue_is_empty(&queue));
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_002: [mpsc_queue_push shall add entry at the end of the queue.] */
+    /* Tests_SRS_MPSC_QUEUE_07_004: [mpsc_queue_pop shall remove the oldest entry from the queue and return it.] */
+    TEST_FUNCTION(mpsc_queue_pop_returns_the_entries_in_the_order_they_were_pushed)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result1;
+        MPSC_QUEUE_ENTRY* result2;
+        MPSC_QUEUE_ENTRY* result3;
+        mpsc_queue_init(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+        mpsc_queue_push(&queue, &simp2.link);
+        mpsc_queue_push(&queue, &simp3.link);
+
+        // act
+        result1 = mpsc_queue_pop(&queue);
+        result2 = mpsc_queue_pop(&queue);
+        result3 = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_ARE_EQUAL(void_ptr, &simp1.link, result1);
+        ASSERT_ARE_EQUAL(void_ptr, &simp2.link, result2);
+        ASSERT_ARE_EQUAL(void_ptr, &simp3.link, result3);
+        ASSERT_IS_NULL(mpsc_queue_pop(&queue));
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_004: [mpsc_queue_pop shall remove the oldest entry from the queue and return it.] */
+    TEST_FUNCTION(mpsc_queue_push_between_pops_keeps_the_order)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result1;
+        MPSC_QUEUE_ENTRY* result2;
+        MPSC_QUEUE_ENTRY* result3;
+        mpsc_queue_init(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+        mpsc_queue_push(&queue, &simp2.link);
+
+        // act
+        result1 = mpsc_queue_pop(&queue);
+        result2 = mpsc_queue_pop(&queue);
+        mpsc_queue_push(&queue, &simp3.link);
+        result3 = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_ARE_EQUAL(void_ptr, &simp1.link, result1);
+        ASSERT_ARE_EQUAL(void_ptr, &simp2.link, result2);
+        ASSERT_ARE_EQUAL(void_ptr, &simp3.link, result3);
+        ASSERT_ARE_NOT_EQUAL(int, 0, mpsc_queue_is_empty(&queue));
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_004: [mpsc_queue_pop shall remove the oldest entry from the queue and return it.] */
+    TEST_FUNCTION(mpsc_queue_entry_can_be_pushed_again_after_it_was_popped)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result;
+        mpsc_queue_init(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+        (void)mpsc_queue_pop(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+
+        // act
+        result = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_ARE_EQUAL(void_ptr, &simp1.link, result);
+        ASSERT_IS_NULL(mpsc_queue_pop(&queue));
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_006: [If a producer has not finished linking its entry, mpsc_queue_pop shall return NULL, the entries are returned by a later call.] */
+    TEST_FUNCTION(mpsc_queue_pop_while_a_push_is_not_linked_yet_returns_NULL)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result;
+        mpsc_queue_init(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+
+        /*a producer that swapped itself in as the head but did not link simp1 to itself yet*/
+        simp2.link.next = NULL;
+        queue.head = &simp2.link;
+
+        // act
+        result = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(int, 0, mpsc_queue_is_empty(&queue));
+    }
+
+    /* Tests_SRS_MPSC_QUEUE_07_006: [If a producer has not finished linking its entry, mpsc_queue_pop shall return NULL, the entries are returned by a later call.] */
+    TEST_FUNCTION(mpsc_queue_pop_after_the_push_is_linked_returns_the_entries)
+    {
+        // arrange
+        MPSC_QUEUE queue;
+        MPSC_QUEUE_ENTRY* result1;
+        MPSC_QUEUE_ENTRY* result2;
+        mpsc_queue_init(&queue);
+        mpsc_queue_push(&queue, &simp1.link);
+        simp2.link.next = NULL;
+        queue.head = &simp2.link;
+        (void)mpsc_queue_pop(&queue);
+
+        /*the producer finishes its push*/
+        simp1.link.next = &simp2.link;
+
+        // act
+        result1 = mpsc_queue_pop(&queue);
+        result2 = mpsc_queue_pop(&queue);
+
+        // assert
+        ASSERT_ARE_EQUAL(void_ptr, &simp1.link, result1);
+        ASSERT_ARE_EQUAL(void_ptr, &simp2.link, result2);
+        ASSERT_IS_NULL(mpsc_queue_pop(&queue));
+        ASSERT_ARE_NOT_EQUAL(int, 0, mpsc_queue_is_empty(&queue));
+    }
+
+END_TEST_SUITE(mpsc_queue_unittests)
@@ -57,6 +57,7 @@ static void my_gballoc_free(void* s)
 #include "azure_c_shared_utility/umock_c_prod.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "azure_c_shared_utility/vector.h"
+#include "azure_c_shared_utility/string_intern.h"
 
 MOCKABLE_FUNCTION(, void*, aCloneOption, const char*, name, const void*, value);
 MOCKABLE_FUNCTION(, void, aDestroyOption, const char*, name, const void*, value);
@@ -86,6 +87,19 @@ static int my_mallocAndStrcpy_s(char** destination, const char* source)
     return 0;
 }
 
+static const char* my_string_intern_acquire(const char* source)
+{
+    size_t l = strlen(source);
+    char* temp = (char*)my_gballoc_malloc(l + 1);
+    memcpy(temp, source, l + 1);
+    return temp;
+}
+
+static void my_string_intern_release(const char* interned)
+{
+    my_gballoc_free((void*)interned);
+}
+
 static void* my_aCloneOption(const char* name, const void* value)
 {
     (void)(name, value);
@@ -132,6 +146,10 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
         REGISTER_GLOBAL_MOCK_HOOK(mallocAndStrcpy_s, my_mallocAndStrcpy_s);
         REGISTER_GLOBAL_MOCK_FAIL_RETURN(mallocAndStrcpy_s, __LINE__);
 
+        REGISTER_GLOBAL_MOCK_HOOK(string_intern_acquire, my_string_intern_acquire);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(string_intern_acquire, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(string_intern_release, my_string_intern_release);
+
         REGISTER_GLOBAL_MOCK_HOOK(aCloneOption, my_aCloneOption);
         REGISTER_GLOBAL_MOCK_FAIL_RETURN(aCloneOption, NULL);
 
@@ -310,8 +328,7 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
 
     void OptionHandler_AddOption_inert_path(void* value)
     {
-        STRICT_EXPECTED_CALL(mallocAndStrcpy_s(IGNORED_PTR_ARG, "name"))
-            .IgnoreArgument_destination();
+        STRICT_EXPECTED_CALL(string_intern_acquire("name"));
         STRICT_EXPECTED_CALL(aCloneOption("name", value))
             .IgnoreAllArguments();
         STRICT_EXPECTED_CALL(VECTOR_push_back(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
@@ -319,6 +336,7 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
             .IgnoreArgument_elements();
     }
 
+    /*Tests_SRS_OPTIONHANDLER_07_001: [ OptionHandler_AddOption shall save name by calling string_intern_acquire, so that all the option handlers share one copy of it. ]*/
     /*Tests_SRS_OPTIONHANDLER_02_006: [ OptionHandler_AddOption shall call pfCloneOption passing name and value. ]*/
     /*Tests_SRS_OPTIONHANDLER_02_007: [ OptionHandler_AddOption shall use VECTOR APIs to save the name and the newly created clone of value. ]*/
     /*Tests_SRS_OPTIONHANDLER_02_008: [ If all the operations succed then OptionHandler_AddOption shall succeed and return OPTIONHANDLER_OK. ]*/
@@ -648,15 +666,15 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
             .IgnoreArgument_handle();
         STRICT_EXPECTED_CALL(aDestroyOption("a", IGNORED_PTR_ARG))
             .IgnoreArgument_value();
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument_ptr();
+        STRICT_EXPECTED_CALL(string_intern_release(IGNORED_PTR_ARG))
+            .IgnoreArgument_interned();
 
         STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 1))
             .IgnoreArgument_handle();
         STRICT_EXPECTED_CALL(aDestroyOption("c", IGNORED_PTR_ARG))
             .IgnoreArgument_value();
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument_ptr();
+        STRICT_EXPECTED_CALL(string_intern_release(IGNORED_PTR_ARG))
+            .IgnoreArgument_interned();
 
         STRICT_EXPECTED_CALL(VECTOR_destroy(IGNORED_PTR_ARG))
             .IgnoreArgument_handle();
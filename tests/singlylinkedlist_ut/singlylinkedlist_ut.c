@@ -787,4 +787,324 @@ TEST_FUNCTION(singlylinkedlist_remove_second_of_2_items_succeeds)
 	singlylinkedlist_destroy(list);
 }
 
+/* singlylinkedlist_create_pooled */
+
+/* Tests_SRS_LIST_07_001: [singlylinkedlist_create_pooled shall create a new list that keeps up to max_pooled_items removed nodes to reuse them for the items added next, and return a non-NULL handle on success.] */
+TEST_FUNCTION(when_underlying_calls_succeed_singlylinkedlist_create_pooled_succeeds)
+{
+    // arrange
+    EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    SINGLYLINKEDLIST_HANDLE result = singlylinkedlist_create_pooled(2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(result);
+}
+
+/* Tests_SRS_LIST_07_002: [If any error occurs during the list creation, singlylinkedlist_create_pooled shall return NULL.] */
+TEST_FUNCTION(when_underlying_malloc_fails_singlylinkedlist_create_pooled_fails)
+{
+    // arrange
+    EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn((void*)NULL);
+
+    // act
+    SINGLYLINKEDLIST_HANDLE result = singlylinkedlist_create_pooled(2);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LIST_07_001: [singlylinkedlist_create_pooled shall create a new list that keeps up to max_pooled_items removed nodes to reuse them for the items added next, and return a non-NULL handle on success.] */
+TEST_FUNCTION(singlylinkedlist_remove_on_a_pooled_list_keeps_the_node_for_the_next_add)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_pooled(1);
+    LIST_ITEM_HANDLE item1 = singlylinkedlist_add(list, &x1);
+    umock_c_reset_all_calls();
+
+    // act
+    int result1 = singlylinkedlist_remove(list, item1);
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x2);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result1);
+    ASSERT_ARE_EQUAL(void_ptr, item1, item2);
+    ASSERT_ARE_EQUAL(void_ptr, &x2, singlylinkedlist_item_get_value(singlylinkedlist_get_head_item(list)));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_07_001: [singlylinkedlist_create_pooled shall create a new list that keeps up to max_pooled_items removed nodes to reuse them for the items added next, and return a non-NULL handle on success.] */
+TEST_FUNCTION(singlylinkedlist_remove_on_a_pooled_list_frees_the_nodes_that_do_not_fit_in_the_pool)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_pooled(1);
+    (void)singlylinkedlist_add(list, &x1);
+    (void)singlylinkedlist_add(list, &x2);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    int result1 = singlylinkedlist_remove_head(list);
+    int result2 = singlylinkedlist_remove_head(list);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result1);
+    ASSERT_ARE_EQUAL(int, 0, result2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_01_003: [singlylinkedlist_destroy shall free all resources associated with the list identified by the handle argument.] */
+TEST_FUNCTION(singlylinkedlist_destroy_frees_the_pooled_nodes)
+{
+    // arrange
+    int x1 = 0x42;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create_pooled(1);
+    (void)singlylinkedlist_add(list, &x1);
+    (void)singlylinkedlist_remove_head(list);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    singlylinkedlist_destroy(list);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LIST_07_003: [singlylinkedlist_add shall not walk the list to find its tail.] */
+TEST_FUNCTION(singlylinkedlist_add_after_removing_the_last_item_adds_to_the_tail)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    int x3 = 0x44;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    (void)singlylinkedlist_add(list, &x1);
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x2);
+    (void)singlylinkedlist_remove(list, item2);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    LIST_ITEM_HANDLE result = singlylinkedlist_add(list, &x3);
+
+    // assert
+    LIST_ITEM_HANDLE head = singlylinkedlist_get_head_item(list);
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(void_ptr, &x1, singlylinkedlist_item_get_value(head));
+    ASSERT_ARE_EQUAL(void_ptr, result, singlylinkedlist_get_next_item(head));
+    ASSERT_IS_NULL(singlylinkedlist_get_next_item(result));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* singlylinkedlist_add_head */
+
+/* Tests_SRS_LIST_07_004: [singlylinkedlist_add_head shall add one item to the head of the list and on success it shall return a handle to the added item.] */
+TEST_FUNCTION(singlylinkedlist_add_head_adds_the_item_before_the_others)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    int x3 = 0x44;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    (void)singlylinkedlist_add(list, &x1);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    LIST_ITEM_HANDLE result = singlylinkedlist_add_head(list, &x2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(void_ptr, result, singlylinkedlist_get_head_item(list));
+    ASSERT_ARE_EQUAL(void_ptr, &x1, singlylinkedlist_item_get_value(singlylinkedlist_get_next_item(result)));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    (void)singlylinkedlist_add(list, &x3);
+    ASSERT_ARE_EQUAL(void_ptr, &x3, singlylinkedlist_item_get_value(singlylinkedlist_get_next_item(singlylinkedlist_get_next_item(result))));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_07_004: [singlylinkedlist_add_head shall add one item to the head of the list and on success it shall return a handle to the added item.] */
+TEST_FUNCTION(singlylinkedlist_add_head_on_an_empty_list_is_also_the_tail)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+
+    // act
+    LIST_ITEM_HANDLE item1 = singlylinkedlist_add_head(list, &x1);
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x2);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, item1, singlylinkedlist_get_head_item(list));
+    ASSERT_ARE_EQUAL(void_ptr, item2, singlylinkedlist_get_next_item(item1));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_07_005: [If any of the arguments is NULL, singlylinkedlist_add_head shall not add the item to the list and return NULL.] */
+TEST_FUNCTION(singlylinkedlist_add_head_with_NULL_list_fails)
+{
+    // arrange
+    int x1 = 0x42;
+
+    // act
+    LIST_ITEM_HANDLE result = singlylinkedlist_add_head(NULL, &x1);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LIST_07_005: [If any of the arguments is NULL, singlylinkedlist_add_head shall not add the item to the list and return NULL.] */
+TEST_FUNCTION(singlylinkedlist_add_head_with_NULL_item_fails)
+{
+    // arrange
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    umock_c_reset_all_calls();
+
+    // act
+    LIST_ITEM_HANDLE result = singlylinkedlist_add_head(list, NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_07_006: [If allocating the new list node fails, singlylinkedlist_add_head shall return NULL.] */
+TEST_FUNCTION(when_allocating_the_node_fails_singlylinkedlist_add_head_fails)
+{
+    // arrange
+    int x1 = 0x42;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn((void*)NULL);
+
+    // act
+    LIST_ITEM_HANDLE result = singlylinkedlist_add_head(list, &x1);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_IS_NULL(singlylinkedlist_get_head_item(list));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* singlylinkedlist_remove_head */
+
+/* Tests_SRS_LIST_07_007: [singlylinkedlist_remove_head shall remove the head item of the list and on success it shall return 0.] */
+TEST_FUNCTION(singlylinkedlist_remove_head_removes_the_first_item)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    (void)singlylinkedlist_add(list, &x1);
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x2);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    int result = singlylinkedlist_remove_head(list);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, item2, singlylinkedlist_get_head_item(list));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_07_007: [singlylinkedlist_remove_head shall remove the head item of the list and on success it shall return 0.] */
+TEST_FUNCTION(singlylinkedlist_remove_head_of_the_only_item_empties_the_list)
+{
+    // arrange
+    int x1 = 0x42;
+    int x2 = 0x43;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    (void)singlylinkedlist_add(list, &x1);
+
+    // act
+    int result = singlylinkedlist_remove_head(list);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(singlylinkedlist_get_head_item(list));
+    LIST_ITEM_HANDLE item2 = singlylinkedlist_add(list, &x2);
+    ASSERT_ARE_EQUAL(void_ptr, item2, singlylinkedlist_get_head_item(list));
+    ASSERT_IS_NULL(singlylinkedlist_get_next_item(item2));
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
+/* Tests_SRS_LIST_07_008: [If list is NULL, singlylinkedlist_remove_head shall fail and return a non-zero value.] */
+TEST_FUNCTION(singlylinkedlist_remove_head_with_NULL_list_fails)
+{
+    // arrange
+
+    // act
+    int result = singlylinkedlist_remove_head(NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_LIST_07_009: [If the list is empty, singlylinkedlist_remove_head shall fail and return a non-zero value.] */
+TEST_FUNCTION(singlylinkedlist_remove_head_on_an_empty_list_fails)
+{
+    // arrange
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = singlylinkedlist_remove_head(list);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    singlylinkedlist_destroy(list);
+}
+
 END_TEST_SUITE(singlylinkedlist_unittests)
@@ -242,7 +242,7 @@ TEST_FUNCTION(socketio_create_list_create_fails)
     socketio_mocks mocks;
 
     EXPECTED_CALL(mocks, gballoc_malloc(IGNORED_NUM_ARG));
-    EXPECTED_CALL(mocks, singlylinkedlist_create()).SetReturn((SINGLYLINKEDLIST_HANDLE)NULL);
+    EXPECTED_CALL(mocks, singlylinkedlist_create_pooled(IGNORED_NUM_ARG)).SetReturn((SINGLYLINKEDLIST_HANDLE)NULL);
     EXPECTED_CALL(mocks, gballoc_free(IGNORED_PTR_ARG));
 
     SOCKETIO_CONFIG socketConfig = { HOSTNAME_ARG, PORT_NUM, NULL };
@@ -260,7 +260,7 @@ TEST_FUNCTION(socketio_create_succeeds)
     socketio_mocks mocks;
 
     EXPECTED_CALL(mocks, gballoc_malloc(IGNORED_NUM_ARG));
-    EXPECTED_CALL(mocks, singlylinkedlist_create());
+    EXPECTED_CALL(mocks, singlylinkedlist_create_pooled(IGNORED_NUM_ARG));
     EXPECTED_CALL(mocks, gballoc_malloc(IGNORED_NUM_ARG));
 
     SOCKETIO_CONFIG socketConfig = { HOSTNAME_ARG, PORT_NUM, NULL };
@@ -301,7 +301,7 @@ TEST_FUNCTION(socketio_destroy_socket_succeeds)
     EXPECTED_CALL(mocks, singlylinkedlist_get_head_item(IGNORED_PTR_ARG))
         .ExpectedAtLeastTimes(2);
     EXPECTED_CALL(mocks, singlylinkedlist_item_get_value(IGNORED_PTR_ARG));
-    EXPECTED_CALL(mocks, singlylinkedlist_remove(IGNORED_PTR_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(mocks, singlylinkedlist_remove_head(IGNORED_PTR_ARG));
     EXPECTED_CALL(mocks, singlylinkedlist_destroy(IGNORED_PTR_ARG));
     EXPECTED_CALL(mocks, gballoc_free(IGNORED_PTR_ARG));
     EXPECTED_CALL(mocks, gballoc_free(IGNORED_PTR_ARG));
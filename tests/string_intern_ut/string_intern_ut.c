@@ -0,0 +1,493 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+//
+// PUT NO INCLUDES BEFORE HERE !!!!
+//
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+//
+// PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE !!!!
+//
+#include "testrunnerswitcher.h"
+
+void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void my_gballoc_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c.h"
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
+
+#undef ENABLE_MOCKS
+#include "azure_c_shared_utility/string_intern.h"
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+static const LOCK_HANDLE TEST_LOCK_HANDLE = (LOCK_HANDLE)0x4244;
+
+TEST_DEFINE_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(string_intern_unittests)
+
+    TEST_SUITE_INITIALIZE(suite_init)
+    {
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+        g_testByTest = TEST_MUTEX_CREATE();
+        ASSERT_IS_NOT_NULL(g_testByTest);
+
+        umock_c_init(on_umock_c_error);
+
+        REGISTER_UMOCK_ALIAS_TYPE(LOCK_HANDLE, void*);
+        REGISTER_TYPE(LOCK_RESULT, LOCK_RESULT);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+        REGISTER_GLOBAL_MOCK_RETURN(Lock_Init, TEST_LOCK_HANDLE);
+        REGISTER_GLOBAL_MOCK_RETURN(Lock_Deinit, LOCK_OK);
+        REGISTER_GLOBAL_MOCK_RETURN(Lock, LOCK_OK);
+        REGISTER_GLOBAL_MOCK_RETURN(Unlock, LOCK_OK);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+
+        TEST_MUTEX_DESTROY(g_testByTest);
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(f)
+    {
+        if (TEST_MUTEX_ACQUIRE(g_testByTest))
+        {
+            ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+        }
+
+        umock_c_reset_all_calls();
+    }
+
+    TEST_FUNCTION_CLEANUP(cleans)
+    {
+        string_intern_deinit();
+
+        TEST_MUTEX_RELEASE(g_testByTest);
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_001: [string_intern_init shall create the lock that makes the table thread safe and return 0.]*/
+    TEST_FUNCTION(string_intern_init_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(Lock_Init());
+
+        ///act
+        int result = string_intern_init();
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_002: [If the module is already initialized, string_intern_init shall return 0 without changing anything.]*/
+    TEST_FUNCTION(string_intern_init_after_init_succeeds)
+    {
+        ///arrange
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = string_intern_init();
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_003: [If creating the lock fails, string_intern_init shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(string_intern_init_fails_when_Lock_Init_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(Lock_Init())
+            .SetReturn(NULL);
+
+        ///act
+        int result = string_intern_init();
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_004: [string_intern_deinit shall empty the table and destroy the lock. The strings that are still acquired stay valid until they are released.]*/
+    TEST_FUNCTION(string_intern_deinit_destroys_the_lock)
+    {
+        ///arrange
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
+
+        ///act
+        string_intern_deinit();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(size_t, 0, string_intern_get_count());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_004: [string_intern_deinit shall empty the table and destroy the lock. The strings that are still acquired stay valid until they are released.]*/
+    TEST_FUNCTION(string_intern_deinit_keeps_the_acquired_strings)
+    {
+        ///arrange
+        (void)string_intern_init();
+        const char* interned = string_intern_acquire("TrustedCerts");
+        const char* again = string_intern_acquire("TrustedCerts");
+
+        ///act
+        string_intern_deinit();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, "TrustedCerts", interned);
+        umock_c_reset_all_calls();
+        string_intern_release(again);
+        ASSERT_ARE_EQUAL(char_ptr, "TrustedCerts", interned);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        string_intern_release(interned);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_005: [If the module is not initialized, string_intern_deinit shall do nothing.]*/
+    TEST_FUNCTION(string_intern_deinit_without_init_does_nothing)
+    {
+        ///arrange
+
+        ///act
+        string_intern_deinit();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_006: [If source is NULL, string_intern_acquire shall fail and return NULL.]*/
+    TEST_FUNCTION(string_intern_acquire_with_NULL_source_fails)
+    {
+        ///arrange
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        ///act
+        const char* result = string_intern_acquire(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_007: [If the module is not initialized, string_intern_acquire shall initialize it first.]*/
+    TEST_FUNCTION(string_intern_acquire_without_init_initializes_the_table)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(Lock_Init());
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        const char* result1 = string_intern_acquire("Content-Length");
+        const char* result2 = string_intern_acquire("Content-Length");
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(char_ptr, "Content-Length", result1);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)result1, (void*)result2);
+        ASSERT_ARE_EQUAL(size_t, 1, string_intern_get_count());
+
+        ///cleanup
+        string_intern_release(result1);
+        string_intern_release(result2);
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_011: [If the lock or any allocation fails, string_intern_acquire shall fail and return NULL.]*/
+    TEST_FUNCTION(string_intern_acquire_without_init_fails_when_Lock_Init_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(Lock_Init())
+            .SetReturn(NULL);
+
+        ///act
+        const char* result = string_intern_acquire("Content-Length");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_008: [string_intern_acquire shall look for and add to the table under the lock.]*/
+    /*Tests_SRS_STRING_INTERN_07_010: [Otherwise string_intern_acquire shall add a copy of source to the table with a reference count of 1 and return it.]*/
+    TEST_FUNCTION(string_intern_acquire_adds_to_the_table)
+    {
+        ///arrange
+        char source[] = "Authorization";
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        const char* result = string_intern_acquire(source);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(char_ptr, "Authorization", result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, (void*)source, (void*)result);
+        ASSERT_ARE_EQUAL(size_t, 1, string_intern_get_count());
+
+        ///cleanup
+        string_intern_release(result);
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_009: [If the table already has the same characters, string_intern_acquire shall increment their reference count and return the same pointer as before.]*/
+    TEST_FUNCTION(string_intern_acquire_same_characters_returns_the_same_pointer)
+    {
+        ///arrange
+        char source[] = "Authorization";
+        (void)string_intern_init();
+        const char* first = string_intern_acquire("Authorization");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        const char* result = string_intern_acquire(source);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(void_ptr, (void*)first, (void*)result);
+        ASSERT_ARE_EQUAL(size_t, 1, string_intern_get_count());
+
+        ///cleanup
+        string_intern_release(result);
+        string_intern_release(first);
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_009: [If the table already has the same characters, string_intern_acquire shall increment their reference count and return the same pointer as before.]*/
+    TEST_FUNCTION(string_intern_acquire_many_strings_finds_all_of_them)
+    {
+        ///arrange
+        const char* interned[200];
+        char name[32];
+        size_t i;
+        (void)string_intern_init();
+
+        for (i = 0; i < sizeof(interned) / sizeof(interned[0]); i++)
+        {
+            (void)sprintf(name, "option%u", (unsigned int)i);
+            interned[i] = string_intern_acquire(name);
+            ASSERT_IS_NOT_NULL(interned[i]);
+        }
+
+        ///act
+        for (i = 0; i < sizeof(interned) / sizeof(interned[0]); i++)
+        {
+            const char* again;
+            (void)sprintf(name, "option%u", (unsigned int)i);
+            again = string_intern_acquire(name);
+
+            ///assert
+            ASSERT_ARE_EQUAL(void_ptr, (void*)interned[i], (void*)again);
+            string_intern_release(again);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, sizeof(interned) / sizeof(interned[0]), string_intern_get_count());
+
+        ///cleanup
+        for (i = 0; i < sizeof(interned) / sizeof(interned[0]); i++)
+        {
+            string_intern_release(interned[i]);
+        }
+        ASSERT_ARE_EQUAL(size_t, 0, string_intern_get_count());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_011: [If the lock or any allocation fails, string_intern_acquire shall fail and return NULL.]*/
+    TEST_FUNCTION(string_intern_acquire_fails_when_Lock_fails)
+    {
+        ///arrange
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE))
+            .SetReturn(LOCK_ERROR);
+
+        ///act
+        const char* result = string_intern_acquire("TrustedCerts");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_011: [If the lock or any allocation fails, string_intern_acquire shall fail and return NULL.]*/
+    TEST_FUNCTION(string_intern_acquire_fails_when_malloc_fails)
+    {
+        ///arrange
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        const char* result = string_intern_acquire("TrustedCerts");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(size_t, 0, string_intern_get_count());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_012: [If interned is NULL, string_intern_release shall do nothing.]*/
+    TEST_FUNCTION(string_intern_release_with_NULL_does_nothing)
+    {
+        ///arrange
+        (void)string_intern_init();
+        umock_c_reset_all_calls();
+
+        ///act
+        string_intern_release(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_013: [string_intern_release shall decrement the reference count of interned, when it reaches 0 the string shall be removed from the table and freed.]*/
+    /*Tests_SRS_STRING_INTERN_07_014: [string_intern_release shall update the table under the lock. If the lock fails the string is not released.]*/
+    TEST_FUNCTION(string_intern_release_frees_the_string_after_the_last_release)
+    {
+        ///arrange
+        (void)string_intern_init();
+        const char* first = string_intern_acquire("x509certificate");
+        const char* second = string_intern_acquire("x509certificate");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        string_intern_release(first);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(size_t, 1, string_intern_get_count());
+        ASSERT_ARE_EQUAL(char_ptr, "x509certificate", second);
+
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        string_intern_release(second);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(size_t, 0, string_intern_get_count());
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_014: [string_intern_release shall update the table under the lock. If the lock fails the string is not released.]*/
+    TEST_FUNCTION(string_intern_release_when_Lock_fails_keeps_the_string)
+    {
+        ///arrange
+        (void)string_intern_init();
+        const char* interned = string_intern_acquire("x509privatekey");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE))
+            .SetReturn(LOCK_ERROR);
+
+        ///act
+        string_intern_release(interned);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(size_t, 1, string_intern_get_count());
+
+        ///cleanup
+        string_intern_release(interned);
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_015: [string_intern_get_count shall return how many different strings are in the table.]*/
+    TEST_FUNCTION(string_intern_get_count_counts_different_strings)
+    {
+        ///arrange
+        (void)string_intern_init();
+        const char* a1 = string_intern_acquire("a");
+        const char* a2 = string_intern_acquire("a");
+        const char* b = string_intern_acquire("b");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        size_t result = string_intern_get_count();
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 2, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        string_intern_release(a1);
+        string_intern_release(a2);
+        string_intern_release(b);
+    }
+
+    /*Tests_SRS_STRING_INTERN_07_016: [If the module is not initialized, string_intern_get_count shall return 0.]*/
+    TEST_FUNCTION(string_intern_get_count_without_init_returns_0)
+    {
+        ///arrange
+
+        ///act
+        size_t result = string_intern_get_count();
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+END_TEST_SUITE(string_intern_unittests)
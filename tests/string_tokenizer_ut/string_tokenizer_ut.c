@@ -332,10 +332,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "m");
 
@@ -362,10 +358,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
 
@@ -393,10 +385,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
 
@@ -448,10 +436,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act1
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
 
@@ -485,10 +469,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act1
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "?");
 
@@ -516,16 +496,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result1. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result2. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result3. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act1
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
         
@@ -593,9 +563,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "?");
@@ -605,9 +572,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act2
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, ",");
@@ -617,9 +581,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act3
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "#,");
 
@@ -654,9 +615,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "?");
@@ -692,9 +650,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "1");
@@ -725,9 +680,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "\r\n");
@@ -737,9 +689,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act2
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "\r\n");
@@ -749,9 +698,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act3
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
 
 
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "\r\n\t");
@@ -806,4 +752,151 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     }
 
+    /* Tests_SRS_STRING_04_008: [STRING_TOKENIZER_get_next_token than searches from the start of a token for a character that is contained in the delimiters string.] */
+    TEST_FUNCTION(STRING_TOKENIZER_get_next_token_stops_at_the_first_of_several_delimiters)
+    {
+        ///arrange
+        STRING_HANDLE output_string_handle = STRING_new();
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_char("a;b,c");
+
+        ///act
+        int r1 = STRING_TOKENIZER_get_next_token(t, output_string_handle, ",;");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r1);
+        ASSERT_ARE_EQUAL(char_ptr, "a", STRING_c_str(output_string_handle));
+
+        ///act
+        int r2 = STRING_TOKENIZER_get_next_token(t, output_string_handle, ",;");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r2);
+        ASSERT_ARE_EQUAL(char_ptr, "b", STRING_c_str(output_string_handle));
+
+        ///cleanup
+        STRING_TOKENIZER_destroy(t);
+        STRING_delete(output_string_handle);
+    }
+
+    /* STRING_TOKENIZER_create_from_view */
+
+    /* Tests_SRS_STRING_TOKENIZER_07_004: [STRING_TOKENIZER_create_from_view shall return NULL if the data of input is NULL.] */
+    TEST_FUNCTION(STRING_TOKENIZER_create_from_view_with_NULL_data_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_view(STRING_VIEW_from_chars(NULL));
+
+        ///assert
+        ASSERT_IS_NULL(t);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_07_005: [STRING_TOKENIZER_create_from_view shall allocate a new STRING_TOKENIZER_HANDLE that refers to the characters of input without copying them, with the current position pointing at the beginning of input.] */
+    TEST_FUNCTION(STRING_TOKENIZER_create_from_view_does_not_copy_the_input)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))  //Token Allocation only.
+            .IgnoreArgument(1);
+
+        ///act
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_view(STRING_VIEW_from_chars("Pirlimpimpim"));
+
+        ///assert
+        ASSERT_IS_NOT_NULL(t);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_TOKENIZER_destroy(t);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_07_006: [STRING_TOKENIZER_create_from_view shall return NULL on any error that is encountered.] */
+    TEST_FUNCTION(STRING_TOKENIZER_create_from_view_when_malloc_fails_fails)
+    {
+        ///arrange
+        whenShallmalloc_fail = currentmalloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_view(STRING_VIEW_from_chars("Pirlimpimpim"));
+
+        ///assert
+        ASSERT_IS_NULL(t);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* STRING_TOKENIZER_get_next_token_view */
+
+    /* Tests_SRS_STRING_TOKENIZER_07_007: [STRING_TOKENIZER_get_next_token_view shall return a nonzero value if any of the 3 parameters is NULL.] */
+    TEST_FUNCTION(STRING_TOKENIZER_get_next_token_view_with_NULL_arguments_fails)
+    {
+        ///arrange
+        STRING_VIEW token;
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_view(STRING_VIEW_from_chars("a;b"));
+        umock_c_reset_all_calls();
+
+        ///act + assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_TOKENIZER_get_next_token_view(NULL, &token, ";"));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_TOKENIZER_get_next_token_view(t, NULL, ";"));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_TOKENIZER_get_next_token_view(t, &token, NULL));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_TOKENIZER_destroy(t);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_07_008: [STRING_TOKENIZER_get_next_token_view shall find the next token exactly like STRING_TOKENIZER_get_next_token and return a nonzero value when there is none.] */
+    /* Tests_SRS_STRING_TOKENIZER_07_009: [On success STRING_TOKENIZER_get_next_token_view shall set output to a view over the token inside the tokenized characters, without allocating memory, and return 0.] */
+    TEST_FUNCTION(STRING_TOKENIZER_get_next_token_view_over_part_of_a_buffer_succeeds)
+    {
+        ///arrange
+        const char input[] = "??a,b?c?DO_NOT_READ";
+        STRING_VIEW token;
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_view(STRING_VIEW_from_n(input, 8));
+        umock_c_reset_all_calls();
+
+        ///act
+        int r1 = STRING_TOKENIZER_get_next_token_view(t, &token, "?");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r1);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(input + 2), (void*)token.data);
+        ASSERT_IS_TRUE(STRING_VIEW_equals(token, "a,b"));
+
+        ///act
+        int r2 = STRING_TOKENIZER_get_next_token_view(t, &token, "?");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r2);
+        ASSERT_IS_TRUE(STRING_VIEW_equals(token, "c"));
+
+        ///act
+        int r3 = STRING_TOKENIZER_get_next_token_view(t, &token, "?");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r3);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_TOKENIZER_destroy(t);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_07_010: [STRING_TOKENIZER_destroy shall not free the characters of a tokenizer created by STRING_TOKENIZER_create_from_view.] */
+    TEST_FUNCTION(STRING_TOKENIZER_destroy_for_view_tokenizer_frees_only_the_tokenizer)
+    {
+        ///arrange
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_view(STRING_VIEW_from_chars("Pirlimpimpim"));
+        umock_c_reset_all_calls();
+
+        EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        STRING_TOKENIZER_destroy(t);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
 END_TEST_SUITE(string_tokenizer_unittests)
\ No newline at end of file
@@ -0,0 +1,590 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+//
+// PUT NO INCLUDES BEFORE HERE !!!!
+//
+#include <stdlib.h>
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include <stddef.h>
+#include <limits.h>
+
+//
+// PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE !!!!
+//
+#include "testrunnerswitcher.h"
+
+void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void my_gballoc_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c.h"
+#include "umocktypes_charptr.h"
+#include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/gballoc.h"
+
+#undef ENABLE_MOCKS
+#include "azure_c_shared_utility/string_view.h"
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+#define TEST_STRING_HANDLE ((STRING_HANDLE)0x4242)
+static const char TEST_STRING_CONTENT[] = "HostName=some.host;SharedAccessKey=abc";
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(string_view_unittests)
+
+    TEST_SUITE_INITIALIZE(setsBufferTempSize)
+    {
+        int result;
+
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+        g_testByTest = TEST_MUTEX_CREATE();
+        ASSERT_IS_NOT_NULL(g_testByTest);
+
+        umock_c_init(on_umock_c_error);
+
+        result = umocktypes_charptr_register_types();
+        ASSERT_ARE_EQUAL(int, 0, result);
+
+        REGISTER_UMOCK_ALIAS_TYPE(STRING_HANDLE, void*);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+        REGISTER_GLOBAL_MOCK_RETURN(STRING_c_str, TEST_STRING_CONTENT);
+        REGISTER_GLOBAL_MOCK_RETURN(STRING_length, sizeof(TEST_STRING_CONTENT) - 1);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+
+        TEST_MUTEX_DESTROY(g_testByTest);
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(f)
+    {
+        if (TEST_MUTEX_ACQUIRE(g_testByTest))
+        {
+            ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+        }
+
+        umock_c_reset_all_calls();
+    }
+
+    TEST_FUNCTION_CLEANUP(cleans)
+    {
+        TEST_MUTEX_RELEASE(g_testByTest);
+    }
+
+    /* STRING_VIEW_from_chars */
+
+    /* Tests_SRS_STRING_VIEW_07_001: [If source is NULL, STRING_VIEW_from_chars shall return an empty view (data NULL and length 0).] */
+    TEST_FUNCTION(STRING_VIEW_from_chars_with_NULL_returns_empty_view)
+    {
+        ///arrange
+
+        ///act
+        STRING_VIEW view = STRING_VIEW_from_chars(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(view.data);
+        ASSERT_ARE_EQUAL(size_t, 0, view.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_002: [Otherwise STRING_VIEW_from_chars shall return a view over source having the length strlen(source).] */
+    TEST_FUNCTION(STRING_VIEW_from_chars_succeeds)
+    {
+        ///arrange
+        const char* source = "abc";
+
+        ///act
+        STRING_VIEW view = STRING_VIEW_from_chars(source);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, (void*)source, (void*)view.data);
+        ASSERT_ARE_EQUAL(size_t, 3, view.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* STRING_VIEW_from_n */
+
+    /* Tests_SRS_STRING_VIEW_07_003: [If source is NULL, STRING_VIEW_from_n shall return an empty view.] */
+    TEST_FUNCTION(STRING_VIEW_from_n_with_NULL_returns_empty_view)
+    {
+        ///arrange
+
+        ///act
+        STRING_VIEW view = STRING_VIEW_from_n(NULL, 3);
+
+        ///assert
+        ASSERT_IS_NULL(view.data);
+        ASSERT_ARE_EQUAL(size_t, 0, view.length);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_004: [Otherwise STRING_VIEW_from_n shall return a view over the first length characters of source, without looking at them.] */
+    TEST_FUNCTION(STRING_VIEW_from_n_succeeds)
+    {
+        ///arrange
+        const char source[] = { 'a', 'b', 'c' };
+
+        ///act
+        STRING_VIEW view = STRING_VIEW_from_n(source, 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, (void*)source, (void*)view.data);
+        ASSERT_ARE_EQUAL(size_t, 2, view.length);
+    }
+
+    /* STRING_VIEW_from_STRING */
+
+    /* Tests_SRS_STRING_VIEW_07_005: [If handle is NULL, STRING_VIEW_from_STRING shall return an empty view.] */
+    TEST_FUNCTION(STRING_VIEW_from_STRING_with_NULL_returns_empty_view)
+    {
+        ///arrange
+
+        ///act
+        STRING_VIEW view = STRING_VIEW_from_STRING(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(view.data);
+        ASSERT_ARE_EQUAL(size_t, 0, view.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_006: [Otherwise STRING_VIEW_from_STRING shall return a view over the content of handle, as given by STRING_c_str and STRING_length.] */
+    TEST_FUNCTION(STRING_VIEW_from_STRING_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE));
+        STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE));
+
+        ///act
+        STRING_VIEW view = STRING_VIEW_from_STRING(TEST_STRING_HANDLE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, (void*)TEST_STRING_CONTENT, (void*)view.data);
+        ASSERT_ARE_EQUAL(size_t, sizeof(TEST_STRING_CONTENT) - 1, view.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* STRING_VIEW_compare */
+
+    /* Tests_SRS_STRING_VIEW_07_007: [STRING_VIEW_compare shall compare the characters that left and right have in common as unsigned char and return the result if they differ.] */
+    TEST_FUNCTION(STRING_VIEW_compare_different_characters)
+    {
+        ///arrange
+
+        ///act
+        int less = STRING_VIEW_compare(STRING_VIEW_from_chars("abc"), STRING_VIEW_from_chars("abd"));
+        int greater = STRING_VIEW_compare(STRING_VIEW_from_chars("b"), STRING_VIEW_from_chars("abc"));
+
+        ///assert
+        ASSERT_IS_TRUE(less < 0);
+        ASSERT_IS_TRUE(greater > 0);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_008: [If the common characters are the same, STRING_VIEW_compare shall return a negative value if left is shorter, a positive value if right is shorter and 0 if they have the same length.] */
+    TEST_FUNCTION(STRING_VIEW_compare_same_prefix)
+    {
+        ///arrange
+
+        ///act
+        int shorter = STRING_VIEW_compare(STRING_VIEW_from_chars("ab"), STRING_VIEW_from_chars("abc"));
+        int longer = STRING_VIEW_compare(STRING_VIEW_from_chars("abc"), STRING_VIEW_from_chars("ab"));
+        int same = STRING_VIEW_compare(STRING_VIEW_from_n("abcdef", 3), STRING_VIEW_from_chars("abc"));
+        int empty = STRING_VIEW_compare(STRING_VIEW_from_chars(NULL), STRING_VIEW_from_chars(""));
+
+        ///assert
+        ASSERT_IS_TRUE(shorter < 0);
+        ASSERT_IS_TRUE(longer > 0);
+        ASSERT_ARE_EQUAL(int, 0, same);
+        ASSERT_ARE_EQUAL(int, 0, empty);
+    }
+
+    /* STRING_VIEW_equals */
+
+    /* Tests_SRS_STRING_VIEW_07_009: [If s is NULL, STRING_VIEW_equals shall return false.] */
+    TEST_FUNCTION(STRING_VIEW_equals_with_NULL_s_returns_false)
+    {
+        ///arrange
+
+        ///act
+        bool result = STRING_VIEW_equals(STRING_VIEW_from_chars("abc"), NULL);
+
+        ///assert
+        ASSERT_IS_FALSE(result);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_010: [STRING_VIEW_equals shall return true if s has exactly the characters of view, false otherwise.] */
+    TEST_FUNCTION(STRING_VIEW_equals_succeeds)
+    {
+        ///arrange
+        const char withZero[] = { 'a', '\0', 'b' };
+        STRING_VIEW view = STRING_VIEW_from_n("abcdef", 3);
+
+        ///act + assert
+        ASSERT_IS_TRUE(STRING_VIEW_equals(view, "abc"));
+        ASSERT_IS_FALSE(STRING_VIEW_equals(view, "ab"));
+        ASSERT_IS_FALSE(STRING_VIEW_equals(view, "abcd"));
+        ASSERT_IS_FALSE(STRING_VIEW_equals(view, "abd"));
+        ASSERT_IS_FALSE(STRING_VIEW_equals(STRING_VIEW_from_n(withZero, sizeof(withZero)), "a"));
+        ASSERT_IS_TRUE(STRING_VIEW_equals(STRING_VIEW_from_chars(NULL), ""));
+    }
+
+    /* STRING_VIEW_find_char */
+
+    /* Tests_SRS_STRING_VIEW_07_011: [If c is not in view, STRING_VIEW_find_char shall return STRING_VIEW_NOT_FOUND.] */
+    TEST_FUNCTION(STRING_VIEW_find_char_not_found)
+    {
+        ///arrange
+
+        ///act
+        size_t inText = STRING_VIEW_find_char(STRING_VIEW_from_n("abc", 2), 'c');
+        size_t inEmpty = STRING_VIEW_find_char(STRING_VIEW_from_chars(NULL), 'c');
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, STRING_VIEW_NOT_FOUND, inText);
+        ASSERT_ARE_EQUAL(size_t, STRING_VIEW_NOT_FOUND, inEmpty);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_012: [Otherwise STRING_VIEW_find_char shall return the index of the first c in view.] */
+    TEST_FUNCTION(STRING_VIEW_find_char_succeeds)
+    {
+        ///arrange
+
+        ///act
+        size_t result = STRING_VIEW_find_char(STRING_VIEW_from_chars("a=b=c"), '=');
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, result);
+    }
+
+    /* STRING_VIEW_find */
+
+    /* Tests_SRS_STRING_VIEW_07_013: [If needle is empty, STRING_VIEW_find shall return 0.] */
+    TEST_FUNCTION(STRING_VIEW_find_empty_needle_returns_0)
+    {
+        ///arrange
+
+        ///act
+        size_t result = STRING_VIEW_find(STRING_VIEW_from_chars("abc"), STRING_VIEW_from_chars(""));
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_014: [STRING_VIEW_find shall return the index of the first occurrence of needle in view or STRING_VIEW_NOT_FOUND if there is none.] */
+    TEST_FUNCTION(STRING_VIEW_find_succeeds)
+    {
+        ///arrange
+        STRING_VIEW view = STRING_VIEW_from_chars("aaab;SharedAccessKey=x");
+
+        ///act + assert
+        ASSERT_ARE_EQUAL(size_t, 2, STRING_VIEW_find(view, STRING_VIEW_from_chars("ab")));
+        ASSERT_ARE_EQUAL(size_t, 5, STRING_VIEW_find(view, STRING_VIEW_from_chars("SharedAccessKey")));
+        ASSERT_ARE_EQUAL(size_t, 21, STRING_VIEW_find(view, STRING_VIEW_from_chars("x")));
+        ASSERT_ARE_EQUAL(size_t, STRING_VIEW_NOT_FOUND, STRING_VIEW_find(view, STRING_VIEW_from_chars("xy")));
+        ASSERT_ARE_EQUAL(size_t, STRING_VIEW_NOT_FOUND, STRING_VIEW_find(STRING_VIEW_from_chars("ab"), STRING_VIEW_from_chars("abc")));
+    }
+
+    /* STRING_VIEW_substring */
+
+    /* Tests_SRS_STRING_VIEW_07_015: [If start is not less than the length of view, STRING_VIEW_substring shall return an empty view positioned at the end of view.] */
+    TEST_FUNCTION(STRING_VIEW_substring_start_past_the_end_returns_empty_view)
+    {
+        ///arrange
+        const char* source = "abc";
+
+        ///act
+        STRING_VIEW result = STRING_VIEW_substring(STRING_VIEW_from_chars(source), 5, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(source + 3), (void*)result.data);
+        ASSERT_ARE_EQUAL(size_t, 0, result.length);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_016: [Otherwise STRING_VIEW_substring shall return the view of at most length characters that starts at start.] */
+    TEST_FUNCTION(STRING_VIEW_substring_succeeds)
+    {
+        ///arrange
+        STRING_VIEW view = STRING_VIEW_from_chars("abcdef");
+
+        ///act
+        STRING_VIEW middle = STRING_VIEW_substring(view, 1, 2);
+        STRING_VIEW tail = STRING_VIEW_substring(view, 4, 100);
+
+        ///assert
+        ASSERT_IS_TRUE(STRING_VIEW_equals(middle, "bc"));
+        ASSERT_IS_TRUE(STRING_VIEW_equals(tail, "ef"));
+    }
+
+    /* STRING_VIEW_trim */
+
+    /* Tests_SRS_STRING_VIEW_07_017: [STRING_VIEW_trim shall return view without its leading and trailing spaces, tabs, carriage returns and line feeds.] */
+    TEST_FUNCTION(STRING_VIEW_trim_succeeds)
+    {
+        ///arrange
+
+        ///act
+        STRING_VIEW trimmed = STRING_VIEW_trim(STRING_VIEW_from_chars(" \t application/json \r\n"));
+        STRING_VIEW blank = STRING_VIEW_trim(STRING_VIEW_from_chars("   "));
+
+        ///assert
+        ASSERT_IS_TRUE(STRING_VIEW_equals(trimmed, "application/json"));
+        ASSERT_ARE_EQUAL(size_t, 0, blank.length);
+    }
+
+    /* STRING_VIEW_split_at */
+
+    /* Tests_SRS_STRING_VIEW_07_018: [If left or right is NULL, STRING_VIEW_split_at shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_split_at_with_NULL_left_fails)
+    {
+        ///arrange
+        STRING_VIEW right;
+
+        ///act
+        int result = STRING_VIEW_split_at(STRING_VIEW_from_chars("a=b"), '=', NULL, &right);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_018: [If left or right is NULL, STRING_VIEW_split_at shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_split_at_with_NULL_right_fails)
+    {
+        ///arrange
+        STRING_VIEW left;
+
+        ///act
+        int result = STRING_VIEW_split_at(STRING_VIEW_from_chars("a=b"), '=', &left, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_019: [If separator is not in view, STRING_VIEW_split_at shall return a nonzero value and leave left and right unchanged.] */
+    TEST_FUNCTION(STRING_VIEW_split_at_without_separator_fails)
+    {
+        ///arrange
+        STRING_VIEW left = STRING_VIEW_from_chars("L");
+        STRING_VIEW right = STRING_VIEW_from_chars("R");
+
+        ///act
+        int result = STRING_VIEW_split_at(STRING_VIEW_from_chars("ab"), '=', &left, &right);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_IS_TRUE(STRING_VIEW_equals(left, "L"));
+        ASSERT_IS_TRUE(STRING_VIEW_equals(right, "R"));
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_020: [Otherwise STRING_VIEW_split_at shall set left to the characters before the first separator, right to the characters after it and return 0.] */
+    TEST_FUNCTION(STRING_VIEW_split_at_succeeds)
+    {
+        ///arrange
+        STRING_VIEW left;
+        STRING_VIEW right;
+
+        ///act
+        int result = STRING_VIEW_split_at(STRING_VIEW_from_chars("SharedAccessKey=a2V5=="), '=', &left, &right);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_IS_TRUE(STRING_VIEW_equals(left, "SharedAccessKey"));
+        ASSERT_IS_TRUE(STRING_VIEW_equals(right, "a2V5=="));
+    }
+
+    /* STRING_VIEW_next_token */
+
+    /* Tests_SRS_STRING_VIEW_07_021: [If remaining, delimiters or token is NULL, STRING_VIEW_next_token shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_next_token_with_NULL_arguments_fails)
+    {
+        ///arrange
+        STRING_VIEW remaining = STRING_VIEW_from_chars("a;b");
+        STRING_VIEW token;
+
+        ///act + assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_next_token(NULL, ";", &token));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_next_token(&remaining, NULL, &token));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_next_token(&remaining, ";", NULL));
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_022: [STRING_VIEW_next_token shall skip the characters of remaining that are in delimiters.] */
+    /* Tests_SRS_STRING_VIEW_07_024: [Otherwise STRING_VIEW_next_token shall set token to the characters up to the next delimiter (or the end of remaining), set remaining to what follows that delimiter and return 0.] */
+    TEST_FUNCTION(STRING_VIEW_next_token_succeeds)
+    {
+        ///arrange
+        STRING_VIEW remaining = STRING_VIEW_from_chars(";;HostName=h;,DeviceId=d,");
+        STRING_VIEW token;
+
+        ///act
+        int result1 = STRING_VIEW_next_token(&remaining, ";,", &token);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_IS_TRUE(STRING_VIEW_equals(token, "HostName=h"));
+        ASSERT_IS_TRUE(STRING_VIEW_equals(remaining, ",DeviceId=d,"));
+
+        ///act
+        int result2 = STRING_VIEW_next_token(&remaining, ";,", &token);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_IS_TRUE(STRING_VIEW_equals(token, "DeviceId=d"));
+        ASSERT_ARE_EQUAL(size_t, 0, remaining.length);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_023: [If only delimiters are left, STRING_VIEW_next_token shall make remaining empty and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_next_token_only_delimiters_fails)
+    {
+        ///arrange
+        STRING_VIEW remaining = STRING_VIEW_from_chars(";;;");
+        STRING_VIEW token;
+
+        ///act
+        int result = STRING_VIEW_next_token(&remaining, ";", &token);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, remaining.length);
+    }
+
+    /* STRING_VIEW_to_size_t */
+
+    /* Tests_SRS_STRING_VIEW_07_025: [If value is NULL or view is empty, STRING_VIEW_to_size_t shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_to_size_t_with_invalid_arguments_fails)
+    {
+        ///arrange
+        size_t value;
+
+        ///act + assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_size_t(STRING_VIEW_from_chars("1"), NULL));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_size_t(STRING_VIEW_from_chars(""), &value));
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_026: [If view has a character that is not a decimal digit, STRING_VIEW_to_size_t shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_to_size_t_with_non_digit_fails)
+    {
+        ///arrange
+        size_t value;
+
+        ///act + assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_size_t(STRING_VIEW_from_chars("12a"), &value));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_size_t(STRING_VIEW_from_chars("-1"), &value));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_size_t(STRING_VIEW_from_chars(" 1"), &value));
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_027: [If the number does not fit in a size_t, STRING_VIEW_to_size_t shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_to_size_t_overflow_fails)
+    {
+        ///arrange
+        char text[64];
+        size_t value;
+        (void)sprintf(text, "%zu0", (size_t)~(size_t)0);
+
+        ///act
+        int result = STRING_VIEW_to_size_t(STRING_VIEW_from_chars(text), &value);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_028: [Otherwise STRING_VIEW_to_size_t shall write the number in value and return 0.] */
+    TEST_FUNCTION(STRING_VIEW_to_size_t_succeeds)
+    {
+        ///arrange
+        char text[64];
+        size_t value;
+        size_t maxValue;
+        (void)sprintf(text, "%zu", (size_t)~(size_t)0);
+
+        ///act
+        int result1 = STRING_VIEW_to_size_t(STRING_VIEW_from_n("1483228800;", 10), &value);
+        int result2 = STRING_VIEW_to_size_t(STRING_VIEW_from_chars(text), &maxValue);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(size_t, 1483228800, value);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(size_t, (size_t)~(size_t)0, maxValue);
+    }
+
+    /* STRING_VIEW_to_int */
+
+    /* Tests_SRS_STRING_VIEW_07_029: [If value is NULL or view is empty, STRING_VIEW_to_int shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_to_int_with_invalid_arguments_fails)
+    {
+        ///arrange
+        int value;
+
+        ///act + assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars("1"), NULL));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars(""), &value));
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_031: [If view is not such a number or it does not fit in an int, STRING_VIEW_to_int shall fail and return a nonzero value.] */
+    TEST_FUNCTION(STRING_VIEW_to_int_with_bad_number_fails)
+    {
+        ///arrange
+        char tooBig[32];
+        char tooSmall[32];
+        int value;
+        (void)sprintf(tooBig, "%lld", (long long)INT_MAX + 1);
+        (void)sprintf(tooSmall, "%lld", (long long)INT_MIN - 1);
+
+        ///act + assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars("-"), &value));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars("--1"), &value));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars("1.5"), &value));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars(tooBig), &value));
+        ASSERT_ARE_NOT_EQUAL(int, 0, STRING_VIEW_to_int(STRING_VIEW_from_chars(tooSmall), &value));
+    }
+
+    /* Tests_SRS_STRING_VIEW_07_030: [STRING_VIEW_to_int shall accept one leading '-' or '+' followed by decimal digits.] */
+    /* Tests_SRS_STRING_VIEW_07_032: [Otherwise STRING_VIEW_to_int shall write the number in value and return 0.] */
+    TEST_FUNCTION(STRING_VIEW_to_int_succeeds)
+    {
+        ///arrange
+        char minText[32];
+        int negative;
+        int positive;
+        int minimum;
+        (void)sprintf(minText, "%d", INT_MIN);
+
+        ///act
+        int result1 = STRING_VIEW_to_int(STRING_VIEW_from_chars("-404"), &negative);
+        int result2 = STRING_VIEW_to_int(STRING_VIEW_from_chars("+200"), &positive);
+        int result3 = STRING_VIEW_to_int(STRING_VIEW_from_chars(minText), &minimum);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, -404, negative);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(int, 200, positive);
+        ASSERT_ARE_EQUAL(int, 0, result3);
+        ASSERT_ARE_EQUAL(int, INT_MIN, minimum);
+    }
+
+END_TEST_SUITE(string_view_unittests)
@@ -37,6 +37,7 @@ void my_gballoc_free(void* ptr)
 #define ENABLE_MOCKS
 
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/buffer_.h"
 
 #undef ENABLE_MOCKS
 
@@ -54,8 +55,11 @@ static const char* FORMAT_INTEGER_RESULT = "test_format_1234";
 static const char* INIT_FORMAT_STRING_RESULT = "Initial_test_format_DataValueTest";
 static const char* INIT_FORMAT_INTEGER_RESULT = "Initial_test_format_1234";
 static const char* EMPTY_STRING = "";
+/*too long to be kept in the handle allocation, needs a second malloc*/
+static const char LONG_STRING_VALUE[] = "DataValueTest_that_does_not_fit_in_the_handle";
 
 #define NUMBER_OF_CHAR_TOCOPY           8
+#define TEST_BUFFER_HANDLE              ((BUFFER_HANDLE)0x4242)
 #define TEST_INTEGER_VALUE              1234
 
 static TEST_MUTEX_HANDLE g_dllByDll;
@@ -76,6 +80,14 @@ static const struct JSONEncoding {
         { "\\", "\"\\\\\"" },
         { "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F some text\"\\a/a", 
           "\"\\u0001\\u0002\\u0003\\u0004\\u0005\\u0006\\u0007\\u0008\\u0009\\u000A\\u000B\\u000C\\u000D\\u000E\\u000F\\u0010\\u0011\\u0012\\u0013\\u0014\\u0015\\u0016\\u0017\\u0018\\u0019\\u001A\\u001B\\u001C\\u001D\\u001E\\u001F some text\\\"\\\\a\\/a\"" },
+        /*long enough to be looked at 16/32 characters at a time*/
+        { "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ", "\"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ\"" },
+        /*characters to escape on the last and first position of the 16/32 characters chunks*/
+        { "aaaaaaaaaaaaaaa\"aaaaaaaaaaaaaaa/\\aaaaaaaaaaaaaaaaaaaaaaaaaaaaa\x1F\tb",
+          "\"aaaaaaaaaaaaaaa\\\"aaaaaaaaaaaaaaa\\/\\\\aaaaaaaaaaaaaaaaaaaaaaaaaaaaa\\u001F\\u0009b\"" },
+        /*nothing but characters to escape*/
+        { "\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"",
+          "\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\\\"\"" },
 
     };
 
@@ -99,6 +111,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         umock_c_init(on_umock_c_error);
 
         REGISTER_UMOCK_ALIAS_TYPE(STRING_HANDLE, void*);
+        REGISTER_UMOCK_ALIAS_TYPE(BUFFER_HANDLE, void*);
         ASSERT_ARE_EQUAL(int, 0, umocktypes_charptr_register_types() );
 
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
@@ -142,7 +155,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(1));
 
         ///act
         g_hString = STRING_new();
@@ -165,7 +177,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(1));
 
         umock_c_negative_tests_snapshot();
 
@@ -228,14 +239,15 @@ BEGIN_TEST_SUITE(strings_unittests)
     }
 
     /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
+    /* Tests_SRS_STRING_07_056: [The constructors shall keep a string of fewer than 24 characters in the allocation of the STRING object, without allocating separate memory for the characters.] */
     TEST_FUNCTION(STRING_construct_Succeed)
     {
         ///arrange
         STRING_HANDLE g_hString;
 
+        /*a short string is kept in the handle, one allocation only*/
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_construct(TEST_STRING_VALUE);
@@ -248,6 +260,27 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
+    TEST_FUNCTION(STRING_construct_long_string_Succeed)
+    {
+        ///arrange
+        STRING_HANDLE g_hString;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_STRING_VALUE) + 1));
+
+        ///act
+        g_hString = STRING_construct(LONG_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, LONG_STRING_VALUE, STRING_c_str(g_hString) );
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
     TEST_FUNCTION(STRING_construct_Fail)
     {
@@ -259,7 +292,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(LONG_STRING_VALUE) + 1));
 
         umock_c_negative_tests_snapshot();
 
@@ -270,7 +303,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            str_handle = STRING_construct(TEST_STRING_VALUE);
+            str_handle = STRING_construct(LONG_STRING_VALUE);
 
             char tmp_msg[64];
             sprintf(tmp_msg, "STRING_construct failure in test %zu/%zu", index+1, count);
@@ -297,6 +330,90 @@ BEGIN_TEST_SUITE(strings_unittests)
         ASSERT_IS_NULL(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_046: [If buffer is NULL, STRING_from_BUFFER_move shall return NULL.] */
+    TEST_FUNCTION(STRING_from_BUFFER_move_with_NULL_buffer_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_HANDLE result = STRING_from_BUFFER_move(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_07_047: [STRING_from_BUFFER_move shall return a STRING that takes the memory of buffer with BUFFER_detach, without copying it, and leave buffer empty.] */
+    /* Tests_SRS_STRING_07_048: [STRING_from_BUFFER_move shall make room for the '\0' terminator with BUFFER_reserve, which does not copy the content when the buffer already has spare capacity.] */
+    TEST_FUNCTION(STRING_from_BUFFER_move_succeeds)
+    {
+        ///arrange
+        size_t length = strlen(TEST_STRING_VALUE);
+        unsigned char* memory = (unsigned char*)malloc(length + 1);
+        (void)memcpy(memory, TEST_STRING_VALUE, length);
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(BUFFER_length(TEST_BUFFER_HANDLE))
+            .SetReturn(length);
+        STRICT_EXPECTED_CALL(BUFFER_reserve(TEST_BUFFER_HANDLE, length + 1))
+            .SetReturn(0);
+        STRICT_EXPECTED_CALL(BUFFER_detach(TEST_BUFFER_HANDLE, IGNORED_PTR_ARG))
+            .CopyOutArgumentBuffer(2, &length, sizeof(length))
+            .SetReturn(memory);
+
+        ///act
+        STRING_HANDLE result = STRING_from_BUFFER_move(TEST_BUFFER_HANDLE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(void_ptr, memory, STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_VALUE, STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(result);
+    }
+
+    /* Tests_SRS_STRING_07_049: [If any error occurs, STRING_from_BUFFER_move shall return NULL and leave buffer unchanged.] */
+    TEST_FUNCTION(STRING_from_BUFFER_move_fails_when_BUFFER_reserve_fails)
+    {
+        ///arrange
+        size_t length = strlen(TEST_STRING_VALUE);
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(BUFFER_length(TEST_BUFFER_HANDLE))
+            .SetReturn(length);
+        STRICT_EXPECTED_CALL(BUFFER_reserve(TEST_BUFFER_HANDLE, length + 1))
+            .SetReturn(1);
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        STRING_HANDLE result = STRING_from_BUFFER_move(TEST_BUFFER_HANDLE);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_07_049: [If any error occurs, STRING_from_BUFFER_move shall return NULL and leave buffer unchanged.] */
+    TEST_FUNCTION(STRING_from_BUFFER_move_fails_when_malloc_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1)
+            .SetReturn(NULL);
+
+        ///act
+        STRING_HANDLE result = STRING_from_BUFFER_move(TEST_BUFFER_HANDLE);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
     /* Tests_SRS_STRING_07_008: [STRING_new_quoted shall return a valid STRING_HANDLE Copying the supplied const char* value surrounded by quotes.] */
     TEST_FUNCTION(STRING_new_quoted_Succeed)
     {
@@ -305,7 +422,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 + strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_new_quoted(TEST_STRING_VALUE);
@@ -376,7 +492,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRING_HANDLE str_handle;
 
-        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
         EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
@@ -433,8 +548,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(INITIAL_STRING_VALUE) + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
+        /*the result still fits in the handle, nothing is allocated*/
 
         ///act
         int nResult = STRING_concat(g_hString, TEST_STRING_VALUE);
@@ -510,9 +624,9 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_copy(g_hString, TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(TEST_STRING_VALUE) + strlen(TEST_STRING_VALUE)+1))
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
+        /*the result does not fit in the handle anymore, it moves to the heap*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
 
         ///act
         STRING_concat(g_hString, TEST_STRING_VALUE);
@@ -534,9 +648,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_HANDLE hAppend = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(INITIAL_STRING_VALUE) + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_concat_with_STRING(g_hString, hAppend);
 
@@ -608,8 +719,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
+        /*the copy still fits in the handle, nothing is allocated*/
 
         ///act
         int nResult = STRING_copy(g_hString, TEST_STRING_VALUE);
@@ -650,8 +760,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
         
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, NUMBER_OF_CHAR_TOCOPY + 1))
-            .IgnoreArgument(1);
+        /*the string already has room for NUMBER_OF_CHAR_TOCOPY characters, no reallocation*/
 
         ///act
         int nResult = STRING_copy_n(g_hString, COMBINED_STRING_VALUE, NUMBER_OF_CHAR_TOCOPY);
@@ -705,9 +814,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_copy_n(g_hString, COMBINED_STRING_VALUE, 0);
 
@@ -728,9 +834,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_quote(g_hString);
 
@@ -749,10 +852,11 @@ BEGIN_TEST_SUITE(strings_unittests)
         int negativeTestsInitResult = umock_c_negative_tests_init();
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-        STRING_HANDLE str_handle = STRING_construct(TEST_STRING_VALUE);
+        STRING_HANDLE str_handle = STRING_construct(LONG_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(TEST_STRING_VALUE) + 1))
+        /*the memory grows geometrically: twice the current size, since that is enough*/
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * (strlen(LONG_STRING_VALUE) + 1)))
             .IgnoreArgument(1);
 
         umock_c_negative_tests_snapshot();
@@ -812,7 +916,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_construct(TEST_STRING_VALUE);
@@ -827,6 +930,7 @@ BEGIN_TEST_SUITE(strings_unittests)
     }
 
     /* Tests_SRS_STRING_07_022: [STRING_empty shall revert the STRING_HANDLE to an empty state.] */
+    /* Tests_SRS_STRING_07_050: [STRING_empty shall keep the memory of the string, so that refilling it does not reallocate.] */
     TEST_FUNCTION(STRING_empty_Succeed)
     {
         ///arrange
@@ -834,9 +938,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_empty(g_hString);
 
@@ -882,6 +983,23 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_new();
         umock_c_reset_all_calls();
 
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        STRING_delete(g_hString);
+        
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    TEST_FUNCTION(STRING_delete_long_string_frees_the_characters_and_the_handle)
+    {
+        ///arrange
+        STRING_HANDLE g_hString;
+        g_hString = STRING_construct(LONG_STRING_VALUE);
+        umock_c_reset_all_calls();
+
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
             .IgnoreArgument(1);
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
@@ -889,7 +1007,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         ///act
         STRING_delete(g_hString);
-        
+
         ///assert
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     }
@@ -924,6 +1042,136 @@ BEGIN_TEST_SUITE(strings_unittests)
         ASSERT_ARE_EQUAL(size_t, nResult, 0);
     }
 
+    /* Tests_SRS_STRING_07_051: [STRING_length shall return the length kept by the STRING, without walking the characters.] */
+    TEST_FUNCTION(STRING_length_follows_the_modifications)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        (void)STRING_concat(g_hString, TEST_STRING_VALUE);
+        (void)STRING_quote(g_hString);
+        umock_c_reset_all_calls();
+
+        ///act
+        size_t nResult = STRING_length(g_hString);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, strlen(COMBINED_STRING_VALUE) + 2, nResult);
+        ASSERT_ARE_EQUAL(size_t, strlen(STRING_c_str(g_hString)), nResult);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_07_057: [When a string kept in the STRING object grows past that size, its characters shall be moved to memory allocated with malloc.] */
+    TEST_FUNCTION(STRING_concat_grows_geometrically)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_new();
+        size_t i;
+        umock_c_reset_all_calls();
+
+        /*24 bytes in the handle => 48 bytes on the heap => 96 => 192 bytes*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(48));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 96))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 192))
+            .IgnoreArgument(1);
+
+        ///act
+        for (i = 0; i < 150; i++)
+        {
+            ASSERT_ARE_EQUAL(int, 0, STRING_concat(g_hString, "a"));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 150, STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(size_t, 150, strlen(STRING_c_str(g_hString)));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_07_052: [If handle is NULL, STRING_reserve shall return a nonzero value.] */
+    TEST_FUNCTION(STRING_reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = STRING_reserve(NULL, 10);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_07_053: [If the string can already hold length characters, STRING_reserve shall do nothing and return zero.] */
+    TEST_FUNCTION(STRING_reserve_smaller_than_the_string_does_nothing)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_reserve(g_hString, 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_07_054: [Otherwise STRING_reserve shall reallocate the memory of the string to hold exactly length characters and the '\0' terminator, keeping the content, and return zero.] */
+    TEST_FUNCTION(STRING_reserve_succeeds)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(LONG_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * strlen(LONG_STRING_VALUE) + 1))
+            .IgnoreArgument(1);
+
+        ///act
+        int result = STRING_reserve(g_hString, 2 * strlen(LONG_STRING_VALUE));
+        (void)STRING_concat(g_hString, LONG_STRING_VALUE); /*does not reallocate*/
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 2 * strlen(LONG_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_07_055: [If reallocating fails, STRING_reserve shall return a nonzero value and the string shall be unchanged.] */
+    TEST_FUNCTION(STRING_reserve_fails_when_realloc_fails)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        /*the string moves from the handle to the heap*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(100 + 1))
+            .SetReturn(NULL);
+
+        ///act
+        int result = STRING_reserve(g_hString, 100);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen(INITIAL_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /*Tests_SRS_STRING_02_002: [If parameter handle is NULL then STRING_clone shall return NULL.]*/
     TEST_FUNCTION(STRING_clone_NULL_HANDLE_return_NULL)
     {
@@ -946,7 +1194,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof("aa")));
 
         ///act
         STRING_HANDLE result = STRING_clone(hSource);
@@ -974,7 +1221,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof("aa")));
 
         umock_c_negative_tests_snapshot();
 
@@ -1031,8 +1277,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(3))
-            .IgnoreArgument(1);
 
         ///act
         STRING_HANDLE result = STRING_construct_n("qq", 2);
@@ -1052,8 +1296,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(4))
-            .IgnoreArgument(1);
 
         ///act
         STRING_HANDLE result = STRING_construct_n("12345", 3);
@@ -1075,8 +1317,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(3))
-            .IgnoreArgument(1);
 
         umock_c_negative_tests_snapshot();
 
@@ -1244,7 +1484,10 @@ BEGIN_TEST_SUITE(strings_unittests)
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSONtests[i].expectedJSON) + 1));
+            if (strlen(JSONtests[i].expectedJSON) >= 24) /*does not fit in the handle*/
+            {
+                STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSONtests[i].expectedJSON) + 1));
+            }
 
             ///act
             STRING_HANDLE result = STRING_new_JSON(JSONtests[i].source);
@@ -1266,7 +1509,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("ab") + 2+1));
 
         umock_c_negative_tests_snapshot();
 
@@ -1305,6 +1547,21 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///cleanup
     }
 
+    /*Tests_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
+    TEST_FUNCTION(STRING_new_JSON_when_character_not_ASCII_after_long_text_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_HANDLE result = STRING_new_JSON("0123456789abcdefghijklmnopqrstuvwxyz\"/\xC3\xA9" "abc");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
     /*Tests_SRS_STRING_02_022: [ If source is NULL and size > 0 then STRING_from_BUFFER shall fail and return NULL. ]*/
     TEST_FUNCTION(STRING_from_byte_array_with_NULL_array_and_size_not_zero_fails)
     {
@@ -1328,8 +1585,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 1));
-
         ///act
         STRING_HANDLE result = STRING_from_byte_array((const unsigned char*)"a", 1);
 
@@ -1350,8 +1605,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 0));
-
         ///act
         STRING_HANDLE result = STRING_from_byte_array(NULL, 0);
 
@@ -1372,14 +1625,14 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
         
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 1))
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(LONG_STRING_VALUE)))
             .SetReturn(NULL);
 
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
             .IgnoreArgument_ptr();
 
         ///act
-        STRING_HANDLE result = STRING_from_byte_array((const unsigned char*)"a", 1);
+        STRING_HANDLE result = STRING_from_byte_array((const unsigned char*)LONG_STRING_VALUE, sizeof(LONG_STRING_VALUE) - 1);
 
         ///assert
         ASSERT_IS_NULL(result);
@@ -1449,7 +1702,8 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        /*the result does not fit in the handle anymore, it moves to the heap*/
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
         int str_result = STRING_sprintf(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
@@ -1496,7 +1750,8 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        /*the result does not fit in the handle anymore, it moves to the heap*/
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         umock_c_negative_tests_snapshot();
 
@@ -1521,4 +1776,144 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(str_handle);
     }
 
+    /* Tests_SRS_STRING_07_044: [On success STRING_sprintf shall return 0.] */
+    TEST_FUNCTION(STRING_sprintf_text_that_fits_does_not_allocate)
+    {
+        ///arrange
+        STRING_HANDLE str_handle = STRING_new();
+        ASSERT_IS_NOT_NULL(str_handle);
+
+        umock_c_reset_all_calls();
+
+        ///act
+        int str_result = STRING_sprintf(str_handle, "%d-%s", 42, "abc");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, str_result, 0);
+        ASSERT_ARE_EQUAL(char_ptr, "42-abc", STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(size_t, 6, STRING_length(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_07_058: [If handle or format is NULL then STRING_append_format shall return a nonzero value.] */
+    TEST_FUNCTION(STRING_append_format_handle_NULL_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = STRING_append_format(NULL, FORMAT_STRING, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_07_058: [If handle or format is NULL then STRING_append_format shall return a nonzero value.] */
+    TEST_FUNCTION(STRING_append_format_format_NULL_fails)
+    {
+        ///arrange
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        ASSERT_IS_NOT_NULL(str_handle);
+
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_append_format(str_handle, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_07_059: [STRING_append_format shall append the printf style formatted text at the end of the string, formatting it directly in the memory of the string, and return 0.] */
+    TEST_FUNCTION(STRING_append_format_short_text_succeeds_without_allocating)
+    {
+        ///arrange
+        STRING_HANDLE str_handle = STRING_construct("a");
+        ASSERT_IS_NOT_NULL(str_handle);
+
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_append_format(str_handle, "%s%d", "b", 7);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, "ab7", STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(size_t, 3, STRING_length(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_07_059: [STRING_append_format shall append the printf style formatted text at the end of the string, formatting it directly in the memory of the string, and return 0.] */
+    TEST_FUNCTION(STRING_append_format_long_text_allocates_once)
+    {
+        ///arrange
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        ASSERT_IS_NOT_NULL(str_handle);
+
+        umock_c_reset_all_calls();
+
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        int result = STRING_append_format(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INIT_FORMAT_STRING_RESULT, STRING_c_str(str_handle));
+        ASSERT_ARE_EQUAL(size_t, strlen(INIT_FORMAT_STRING_RESULT), STRING_length(str_handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(str_handle);
+    }
+
+    /* Tests_SRS_STRING_07_060: [If any error is encountered STRING_append_format shall return a nonzero value and leave the string unchanged.] */
+    TEST_FUNCTION(STRING_append_format_fails_leaves_string_unchanged)
+    {
+        ///arrange
+        int negativeTestsInitResult = umock_c_negative_tests_init();
+        ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+        STRING_HANDLE str_handle = STRING_construct(INITIAL_STRING_VALUE);
+        ASSERT_IS_NOT_NULL(str_handle);
+
+        umock_c_reset_all_calls();
+
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        umock_c_negative_tests_snapshot();
+
+        //act
+        size_t count = umock_c_negative_tests_call_count();
+        for (size_t index = 0; index < count; index++)
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            int result = STRING_append_format(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
+
+            char tmp_msg[64];
+            sprintf(tmp_msg, "STRING_append_format failure in test %zu/%zu", index + 1, count);
+
+            ///assert
+            ASSERT_ARE_NOT_EQUAL_WITH_MSG(int, 0, result, tmp_msg);
+            ASSERT_ARE_EQUAL_WITH_MSG(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(str_handle), tmp_msg);
+        }
+
+        ///cleanup
+        umock_c_negative_tests_deinit();
+        STRING_delete(str_handle);
+    }
+
 END_TEST_SUITE(strings_unittests)
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "testrunnerswitcher.h"
 
 #include "azure_c_shared_utility/vector.h"
+#include "azure_c_shared_utility/typed_vector.h"
 
 typedef struct VECTOR_UNITTEST_TAG
 {
@@ -17,11 +18,18 @@ typedef struct VECTOR_UNITTEST_TAG
     long lValue2;
 } VECTOR_UNITTEST;
 
+DECLARE_TYPED_VECTOR(VECTOR_UNITTEST);
+
 static bool PredicateFunction(const VECTOR_UNITTEST* handle, const VECTOR_UNITTEST* otherHandle)
 {
     return (handle->nValue1 == otherHandle->nValue1 && handle->lValue2 == otherHandle->lValue2);
 }
 
+static int CompareFunction(const VECTOR_UNITTEST* left, const VECTOR_UNITTEST* right)
+{
+    return (left->nValue1 < right->nValue1) ? -1 : ((left->nValue1 > right->nValue1) ? 1 : 0);
+}
+
 VECTOR_HANDLE g_handle;
 
 #define NUM_ITEM_PUSH_BACK      128
@@ -409,6 +417,424 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         ASSERT_ARE_EQUAL(long, sItem1.lValue2, pResult->lValue2);
     }
 
+    TEST_FUNCTION(Vector_push_back_grows_capacity_geometrically)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        size_t growths = 0;
+        size_t previousCapacity = VECTOR_capacity(g_handle);
+
+        ///act
+        for (size_t nIndex = 0; nIndex < NUM_ITEM_PUSH_BACK; nIndex++)
+        {
+            int result = VECTOR_push_back(g_handle, &sItem1, 1);
+            ASSERT_ARE_EQUAL(int, 0, result);
+            if (VECTOR_capacity(g_handle) != previousCapacity)
+            {
+                previousCapacity = VECTOR_capacity(g_handle);
+                growths++;
+            }
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, NUM_ITEM_PUSH_BACK, VECTOR_size(g_handle));
+        ASSERT_IS_TRUE(VECTOR_capacity(g_handle) >= NUM_ITEM_PUSH_BACK);
+        ASSERT_ARE_EQUAL(size_t, 8, growths); /*1, 2, 4 ... 128*/
+    }
+
+    TEST_FUNCTION(Vector_capacity_with_NULL_Vector_fails)
+    {
+        ///arrange
+
+        ///act
+        size_t num = VECTOR_capacity(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, num);
+    }
+
+    TEST_FUNCTION(Vector_reserve_with_NULL_Vector_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = VECTOR_reserve(NULL, 10);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    TEST_FUNCTION(Vector_reserve_Success)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        void* storage;
+
+        ///act
+        int result = VECTOR_reserve(g_handle, NUM_ITEM_PUSH_BACK);
+        ASSERT_ARE_EQUAL(int, 0, result);
+        (void)VECTOR_push_back(g_handle, &sItem1, 1);
+        storage = VECTOR_front(g_handle);
+        for (size_t nIndex = 1; nIndex < NUM_ITEM_PUSH_BACK; nIndex++)
+        {
+            result = VECTOR_push_back(g_handle, &sItem1, 1);
+            ASSERT_ARE_EQUAL(int, 0, result);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, NUM_ITEM_PUSH_BACK, VECTOR_capacity(g_handle));
+        ASSERT_ARE_EQUAL(void_ptr, storage, VECTOR_front(g_handle));
+    }
+
+    TEST_FUNCTION(Vector_reserve_smaller_than_capacity_does_nothing)
+    {
+        ///arrange
+        int result = VECTOR_reserve(g_handle, 10);
+        ASSERT_ARE_EQUAL(int, 0, result);
+
+        ///act
+        result = VECTOR_reserve(g_handle, 5);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 10, VECTOR_capacity(g_handle));
+    }
+
+    TEST_FUNCTION(Vector_erase_keeps_capacity)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        VECTOR_UNITTEST sItem2 = {3, 4};
+        (void)VECTOR_push_back(g_handle, &sItem1, 1);
+        (void)VECTOR_push_back(g_handle, &sItem2, 1);
+        size_t capacity = VECTOR_capacity(g_handle);
+
+        ///act
+        VECTOR_erase(g_handle, VECTOR_front(g_handle), 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(g_handle));
+        ASSERT_ARE_EQUAL(size_t, capacity, VECTOR_capacity(g_handle));
+        ASSERT_IS_NULL(VECTOR_front(g_handle));
+        ASSERT_IS_NULL(VECTOR_back(g_handle));
+    }
+
+    TEST_FUNCTION(Vector_pop_back_with_NULL_Vector_Fail)
+    {
+        ///arrange
+
+        ///act
+        VECTOR_pop_back(NULL);
+
+        ///assert
+        // Make sure this pop_back doesn't crash
+    }
+
+    TEST_FUNCTION(Vector_pop_back_Empty_does_nothing)
+    {
+        ///arrange
+
+        ///act
+        VECTOR_pop_back(g_handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(g_handle));
+    }
+
+    TEST_FUNCTION(Vector_pop_back_Success)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        VECTOR_UNITTEST sItem2 = {3, 4};
+        (void)VECTOR_push_back(g_handle, &sItem1, 1);
+        (void)VECTOR_push_back(g_handle, &sItem2, 1);
+
+        ///act
+        VECTOR_pop_back(g_handle);
+
+        ///assert
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_back(g_handle);
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(g_handle));
+        ASSERT_IS_NOT_NULL(pResult);
+        ASSERT_ARE_EQUAL(size_t, sItem1.nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(long, sItem1.lValue2, pResult->lValue2);
+    }
+
+    TEST_FUNCTION(Vector_shrink_to_fit_Success)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        VECTOR_UNITTEST sItem2 = {3, 4};
+        VECTOR_UNITTEST sItem3 = {5, 6};
+        (void)VECTOR_push_back(g_handle, &sItem1, 1);
+        (void)VECTOR_push_back(g_handle, &sItem2, 1);
+        (void)VECTOR_push_back(g_handle, &sItem3, 1);
+
+        ///act
+        VECTOR_shrink_to_fit(g_handle);
+
+        ///assert
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_element(g_handle, 2);
+        ASSERT_ARE_EQUAL(size_t, 3, VECTOR_capacity(g_handle));
+        ASSERT_IS_NOT_NULL(pResult);
+        ASSERT_ARE_EQUAL(size_t, sItem3.nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(long, sItem3.lValue2, pResult->lValue2);
+    }
+
+    TEST_FUNCTION(Vector_shrink_to_fit_Empty_releases_storage)
+    {
+        ///arrange
+        int result = VECTOR_reserve(g_handle, 10);
+        ASSERT_ARE_EQUAL(int, 0, result);
+
+        ///act
+        VECTOR_shrink_to_fit(g_handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_capacity(g_handle));
+    }
+
+    TEST_FUNCTION(Vector_shrink_to_fit_with_NULL_Vector_Fail)
+    {
+        ///arrange
+
+        ///act
+        VECTOR_shrink_to_fit(NULL);
+
+        ///assert
+        // Make sure this shrink_to_fit doesn't crash
+    }
+
+    TEST_FUNCTION(Vector_sort_Success)
+    {
+        ///arrange
+        VECTOR_UNITTEST items[] = { {3, 0}, {1, 1}, {4, 2}, {1, 3}, {5, 4}, {9, 5}, {2, 6} };
+        (void)VECTOR_push_back(g_handle, items, sizeof(items) / sizeof(items[0]));
+
+        ///act
+        VECTOR_sort(g_handle, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, sizeof(items) / sizeof(items[0]), VECTOR_size(g_handle));
+        for (size_t nIndex = 1; nIndex < VECTOR_size(g_handle); nIndex++)
+        {
+            VECTOR_UNITTEST* previous = (VECTOR_UNITTEST*)VECTOR_element(g_handle, nIndex - 1);
+            VECTOR_UNITTEST* current = (VECTOR_UNITTEST*)VECTOR_element(g_handle, nIndex);
+            ASSERT_IS_TRUE(previous->nValue1 <= current->nValue1);
+        }
+    }
+
+    TEST_FUNCTION(Vector_sort_with_NULL_Vector_Fail)
+    {
+        ///arrange
+
+        ///act
+        VECTOR_sort(NULL, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        // Make sure this sort doesn't crash
+    }
+
+    TEST_FUNCTION(Vector_bsearch_with_NULL_Vector_fails)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem = {1, 2};
+
+        ///act
+        void* pResult = VECTOR_bsearch(NULL, &sItem, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_IS_NULL(pResult);
+    }
+
+    TEST_FUNCTION(Vector_bsearch_Success)
+    {
+        ///arrange
+        VECTOR_UNITTEST items[] = { {1, 10}, {3, 30}, {5, 50}, {7, 70} };
+        VECTOR_UNITTEST key = {5, 0};
+        (void)VECTOR_push_back(g_handle, items, sizeof(items) / sizeof(items[0]));
+
+        ///act
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_bsearch(g_handle, &key, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(pResult);
+        ASSERT_ARE_EQUAL(long, 50, pResult->lValue2);
+    }
+
+    TEST_FUNCTION(Vector_bsearch_not_found)
+    {
+        ///arrange
+        VECTOR_UNITTEST items[] = { {1, 10}, {3, 30}, {5, 50}, {7, 70} };
+        VECTOR_UNITTEST key = {4, 0};
+        (void)VECTOR_push_back(g_handle, items, sizeof(items) / sizeof(items[0]));
+
+        ///act
+        void* pResult = VECTOR_bsearch(g_handle, &key, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_IS_NULL(pResult);
+    }
+
+    TEST_FUNCTION(Vector_lower_bound_Success)
+    {
+        ///arrange
+        VECTOR_UNITTEST items[] = { {1, 10}, {3, 30}, {3, 31}, {7, 70} };
+        VECTOR_UNITTEST key1 = {0, 0};
+        VECTOR_UNITTEST key2 = {3, 0};
+        VECTOR_UNITTEST key3 = {4, 0};
+        VECTOR_UNITTEST key4 = {8, 0};
+        (void)VECTOR_push_back(g_handle, items, sizeof(items) / sizeof(items[0]));
+
+        ///act
+        size_t index1 = VECTOR_lower_bound(g_handle, &key1, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+        size_t index2 = VECTOR_lower_bound(g_handle, &key2, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+        size_t index3 = VECTOR_lower_bound(g_handle, &key3, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+        size_t index4 = VECTOR_lower_bound(g_handle, &key4, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, index1);
+        ASSERT_ARE_EQUAL(size_t, 1, index2);
+        ASSERT_ARE_EQUAL(size_t, 3, index3);
+        ASSERT_ARE_EQUAL(size_t, 4, index4);
+    }
+
+    TEST_FUNCTION(Vector_insert_sorted_with_NULL_Vector_fails)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem = {1, 2};
+
+        ///act
+        int result = VECTOR_insert_sorted(NULL, &sItem, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    TEST_FUNCTION(Vector_insert_sorted_with_NULL_Element_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = VECTOR_insert_sorted(g_handle, NULL, (VECTOR_COMPARE_FUNCTION)CompareFunction);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+
+    TEST_FUNCTION(Vector_insert_sorted_keeps_the_vector_sorted)
+    {
+        ///arrange
+        VECTOR_UNITTEST items[] = { {5, 0}, {1, 1}, {3, 2}, {3, 3}, {9, 4}, {0, 5} };
+        const long expected[] = { 5, 1, 2, 3, 0, 4 };
+
+        ///act
+        for (size_t nIndex = 0; nIndex < sizeof(items) / sizeof(items[0]); nIndex++)
+        {
+            int result = VECTOR_insert_sorted(g_handle, &items[nIndex], (VECTOR_COMPARE_FUNCTION)CompareFunction);
+            ASSERT_ARE_EQUAL(int, 0, result);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, sizeof(items) / sizeof(items[0]), VECTOR_size(g_handle));
+        for (size_t nIndex = 0; nIndex < VECTOR_size(g_handle); nIndex++)
+        {
+            VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_element(g_handle, nIndex);
+            ASSERT_ARE_EQUAL(long, expected[nIndex], pResult->lValue2);
+        }
+    }
+
+    /* Typed vector */
+    TEST_FUNCTION(Typed_Vector_init_is_empty)
+    {
+        ///arrange
+        TYPED_VECTOR(VECTOR_UNITTEST) vector;
+
+        ///act
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, init)(&vector);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, size)(&vector));
+        ASSERT_IS_NULL(TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, element)(&vector, 0));
+
+        ///cleanup
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, clear)(&vector);
+    }
+
+    TEST_FUNCTION(Typed_Vector_push_back_Success)
+    {
+        ///arrange
+        TYPED_VECTOR(VECTOR_UNITTEST) vector;
+        VECTOR_UNITTEST sItem1 = {1, 2};
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, init)(&vector);
+
+        ///act
+        for (size_t nIndex = 0; nIndex < NUM_ITEM_PUSH_BACK; nIndex++)
+        {
+            sItem1.nValue1 = nIndex;
+            int result = TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, push_back)(&vector, sItem1);
+            ASSERT_ARE_EQUAL(int, 0, result);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, NUM_ITEM_PUSH_BACK, TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, size)(&vector));
+        ASSERT_IS_TRUE(vector.capacity >= NUM_ITEM_PUSH_BACK);
+        for (size_t nIndex = 0; nIndex < NUM_ITEM_PUSH_BACK; nIndex++)
+        {
+            VECTOR_UNITTEST* pResult = TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, element)(&vector, nIndex);
+            ASSERT_IS_NOT_NULL(pResult);
+            ASSERT_ARE_EQUAL(size_t, nIndex, pResult->nValue1);
+            ASSERT_ARE_EQUAL(long, 2, pResult->lValue2);
+        }
+        ASSERT_IS_NULL(TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, element)(&vector, NUM_ITEM_PUSH_BACK));
+
+        ///cleanup
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, clear)(&vector);
+    }
+
+    TEST_FUNCTION(Typed_Vector_reserve_Success)
+    {
+        ///arrange
+        TYPED_VECTOR(VECTOR_UNITTEST) vector;
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, init)(&vector);
+
+        ///act
+        int result = TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, reserve)(&vector, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 10, vector.capacity);
+        ASSERT_ARE_EQUAL(size_t, 0, TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, size)(&vector));
+
+        ///cleanup
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, clear)(&vector);
+    }
+
+    TEST_FUNCTION(Typed_Vector_pop_back_and_erase_Success)
+    {
+        ///arrange
+        TYPED_VECTOR(VECTOR_UNITTEST) vector;
+        VECTOR_UNITTEST items[] = { {0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4} };
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, init)(&vector);
+        for (size_t nIndex = 0; nIndex < sizeof(items) / sizeof(items[0]); nIndex++)
+        {
+            (void)TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, push_back)(&vector, items[nIndex]);
+        }
+
+        ///act
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, pop_back)(&vector);
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, erase)(&vector, 1, 2);
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, erase)(&vector, 5, 1); /*out of range, nothing happens*/
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 2, TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, size)(&vector));
+        ASSERT_ARE_EQUAL(size_t, 0, vector.storage[0].nValue1);
+        ASSERT_ARE_EQUAL(size_t, 3, vector.storage[1].nValue1);
+
+        ///cleanup
+        TYPED_VECTOR_FUNCTION(VECTOR_UNITTEST, clear)(&vector);
+    }
+
     /* Vector_Tests END */
 
 END_TEST_SUITE(Vector_UnitTests)